@@ -0,0 +1,202 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "AllocationBenchmark.h"
+#include "Benchmark.h"
+#include "Core/PoolAllocator.h"
+#include "Core/Handle.h"
+#include "Core/Stopwatch.h"
+#include "Rendering/Renderer.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/ComponentStore.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+//==========================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+    const uint32_t k_entity_count    = 10000;   // Alive at once
+    const uint32_t k_churn_per_frame = 1000;    // Despawned and spawned again every frame
+    const uint32_t k_frame_count     = 120;     // Per phase which is measured through frames
+    const uint32_t k_handle_cycles   = 8000000; // More releases than a slot has generations
+
+    const char* const k_allocation = PoolAllocator<Entity>::pooled ? "Pooled" : "make_shared";
+
+    volatile float sink = 0.0f; // Keeps the results alive
+
+    shared_ptr<Entity> spawn()
+    {
+        shared_ptr<Entity> entity = World::CreateEntity(); // Adds the transform
+        entity->AddComponent<Renderable>();
+        return entity;
+    }
+
+    double seconds_since(const chrono::steady_clock::time_point start)
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    void print(const char* name, const char* allocation, const double count, const double seconds)
+    {
+        char label[64];
+        snprintf(label, sizeof(label), "%s/%s", name, allocation);
+        printf("%-24s %10.2f ns %14.0f/s\n", label, seconds * 1e9 / count, count / seconds);
+    }
+
+    // Average frame time in ms, work runs before every frame
+    double frames_ms(const uint32_t frame_count, const function<void()>& work)
+    {
+        Stopwatch stopwatch;
+        for (uint32_t frame = 0; frame < frame_count; frame++)
+        {
+            work();
+            Benchmark::Tick();
+        }
+
+        return stopwatch.GetElapsedTimeMs() / frame_count;
+    }
+
+    // Spawns and despawns one object through a handle pool, the worst case for slot reuse, for more releases than
+    // a slot has generations, and checks that the handles which were released never resolve again
+    bool verify_handles()
+    {
+        const uint32_t cycle_count = k_handle_cycles;
+
+        Spartan::HandlePool<uint32_t> pool;
+        uint32_t object = 0;
+
+        vector<Spartan::Handle<uint32_t>> released;
+        released.reserve(4096);
+
+        uint32_t resolved = 0;
+        const auto start  = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < cycle_count; i++)
+        {
+            const Spartan::Handle<uint32_t> handle = pool.Add(&object);
+
+            // While the object is alive, check the first released handle and one of the others, all of them get checked over and over
+            if (!released.empty())
+            {
+                resolved += pool.Get(released.front()) != nullptr ? 1 : 0;
+                resolved += pool.Get(released[i % released.size()]) != nullptr ? 1 : 0;
+            }
+
+            pool.Remove(handle);
+            if (released.size() < released.capacity())
+            {
+                released.emplace_back(handle);
+            }
+        }
+        print("Handle", "Add+Remove", cycle_count, seconds_since(start));
+
+        if (resolved != 0)
+        {
+            printf("FAILED: released handles resolved %u times\n", resolved);
+            return false;
+        }
+
+        return true;
+    }
+}
+
+bool AllocationBenchmark::Run()
+{
+    World::Clear();
+    Benchmark::Tick();
+
+    printf("Entity %zu bytes, Transform %zu bytes, Renderable %zu bytes, %u entities alive, %s\n",
+        sizeof(Entity), sizeof(Transform), sizeof(Renderable), k_entity_count, k_allocation);
+    printf("%-24s %13s %16s\n", "Benchmark", "Time", "Throughput");
+    printf("-------------------------------------------------------------\n");
+
+    // Spawn, through World::CreateEntity() and Entity::AddComponent()
+    vector<shared_ptr<Entity>> entities;
+    entities.reserve(k_entity_count);
+    auto start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < k_entity_count; i++)
+    {
+        entities.emplace_back(spawn());
+    }
+    print("Spawn", k_allocation, k_entity_count, seconds_since(start));
+
+    // The frames without any spawning, what the churn below is compared against
+    frames_ms(k_frame_count / 4, []() {}); // Let the renderer pick the entities up
+    const double idle_ms = frames_ms(k_frame_count, []() {});
+
+    // Churn, what a world which streams or spawns projectiles goes through. The world removes entities when it ticks and the
+    // renderer lets go of them once their frames are through, so spawning and destroying them is measured through the frames.
+    mt19937 generator(12345);
+    uniform_int_distribution<uint32_t> distribution(0, k_entity_count - 1);
+    const double churn_ms = frames_ms(k_frame_count, [&]()
+    {
+        for (uint32_t i = 0; i < k_churn_per_frame; i++)
+        {
+            shared_ptr<Entity>& entity = entities[distribution(generator)];
+            World::RemoveEntity(entity.get());
+            entity = spawn();
+        }
+    });
+    print("Churn", k_allocation, k_churn_per_frame, max(churn_ms - idle_ms, 0.0) / 1000.0);
+
+    // Touch every renderable, like a system which ticks a component type, this shows how scattered they ended up
+    start = chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < 10; pass++)
+    {
+        World::Each<Renderable>([](Renderable* renderable) { sink = sink + static_cast<float>(renderable->GetIndexCount()); });
+    }
+    print("Tick", k_allocation, k_entity_count * 10.0, seconds_since(start));
+
+    // Despawn, the world removes them on the next frame
+    for (const shared_ptr<Entity>& entity : entities)
+    {
+        World::RemoveEntity(entity.get());
+    }
+    entities.clear();
+    const double despawn_ms = frames_ms(1, []() {});
+    print("Despawn", k_allocation, k_entity_count, max(despawn_ms - idle_ms, 0.0) / 1000.0);
+
+    // Once the frames in flight are through, nothing should be left
+    frames_ms(Renderer::GetFramesInFlight() + 2, []() {});
+    bool success = true;
+    if (!World::GetAllEntities().empty() || !ComponentStore::Get<Renderable>().empty())
+    {
+        printf("FAILED: %zu entities and %zu renderables are left after despawning\n", World::GetAllEntities().size(), ComponentStore::Get<Renderable>().size());
+        success = false;
+    }
+
+    World::Clear();
+
+    return verify_handles() && success;
+}
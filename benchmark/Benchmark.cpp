@@ -0,0 +1,336 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =============================
+#include "Benchmark.h"
+#include "Core/Engine.h"
+#include "Core/ProgressTracker.h"
+#include "Core/Stopwatch.h"
+#include "Logging/Log.h"
+#include "Profiling/Profiler.h"
+#include "Profiling/MemoryTracker.h"
+#include "Rendering/Renderer.h"
+#include "Resource/ResourceCache.h"
+#include "World/World.h"
+#include "World/Components/Camera.h"
+#include "World/Components/Transform.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#ifdef _MSC_VER
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+//========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const float k_camera_path_radius    = 2.0f;   // How far the camera moves away from where the world placed it
+    const float k_load_timeout_sec      = 300.0f; // Give up on worlds which are still loading after this long
+    const double k_bytes_to_mb          = 1.0 / (1024.0 * 1024.0);
+
+    struct PassTiming
+    {
+        double cpu_ms = 0.0;
+        double gpu_ms = 0.0;
+    };
+
+    struct WorldResult
+    {
+        string name;
+        float load_time_ms               = 0.0f;
+        vector<float> frame_times_ms;
+        double cpu_time_ms               = 0.0;
+        double gpu_time_ms               = 0.0;
+        uint64_t draw_calls              = 0;
+        uint64_t dispatches              = 0;
+        uint64_t meshes_rendered         = 0;
+        uint64_t heap_allocations        = 0;
+        uint64_t resources_cpu_peak      = 0;
+        uint64_t resources_gpu_peak      = 0;
+        uint32_t gpu_memory_used_peak_mb = 0;
+        map<string, PassTiming> passes; // Summed over all measured frames, ordered so that the output is stable
+    };
+
+    bool create_world(const string& name)
+    {
+        if      (name == "cube")    Spartan::World::CreateDefaultWorldCube();
+        else if (name == "car")     Spartan::World::CreateDefaultWorldCar();
+        else if (name == "terrain") Spartan::World::CreateDefaultWorldTerrain();
+        else if (name == "sponza")  Spartan::World::CreateDefaultWorldSponza();
+        else return false;
+
+        return true;
+    }
+
+    bool is_loading()
+    {
+        for (Spartan::ProgressType type : { Spartan::ProgressType::ModelImporter, Spartan::ProgressType::World, Spartan::ProgressType::Resource, Spartan::ProgressType::Terrain })
+        {
+            if (Spartan::ProgressTracker::GetProgress(type).IsProgressing())
+                return true;
+        }
+
+        return false;
+    }
+
+    uint64_t get_memory_peak_process()
+    {
+        #ifdef _MSC_VER
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+        return 0;
+        #else
+        rusage usage = {};
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes on linux
+        return 0;
+        #endif
+    }
+
+    const char* get_api_name()
+    {
+        #if defined(API_GRAPHICS_D3D11)
+        return "D3D11";
+        #elif defined(API_GRAPHICS_D3D12)
+        return "D3D12";
+        #elif defined(API_GRAPHICS_VULKAN)
+        return "Vulkan";
+        #else
+        return "Null";
+        #endif
+    }
+
+    // Circles around where the world placed the camera while turning around once, so that every world gets looked at from all sides
+    void fly_camera(Spartan::Transform* transform, const Vector3& origin, const Quaternion& rotation, const float t)
+    {
+        const float angle = t * Helper::PI_2;
+        transform->SetPosition(origin + Vector3(sin(angle), 0.25f * sin(angle * 2.0f), 1.0f - cos(angle)) * k_camera_path_radius);
+        transform->SetRotation(Quaternion::FromEulerAngles(0.0f, t * 360.0f, 0.0f) * rotation);
+    }
+
+    // Nearest rank
+    float percentile(const vector<float>& sorted, const float p)
+    {
+        if (sorted.empty())
+            return 0.0f;
+
+        const size_t index = static_cast<size_t>(ceil(p * static_cast<float>(sorted.size()))) - 1;
+        return sorted[min(index, sorted.size() - 1)];
+    }
+
+    // Accumulates the CPU scopes and GPU time blocks of the last frame the profiler published
+    void accumulate_passes(WorldResult& result)
+    {
+        for (const Spartan::CpuTimeline& timeline : Spartan::Profiler::GetCpuTimelines())
+        {
+            for (const Spartan::CpuScope& scope : timeline.scopes)
+            {
+                result.passes[scope.name].cpu_ms += scope.duration;
+            }
+        }
+
+        for (const Spartan::TimeBlock& time_block : Spartan::Profiler::GetTimeBlocks())
+        {
+            if (time_block.GetType() == Spartan::TimeBlockType::Gpu && time_block.IsComplete())
+            {
+                result.passes[time_block.GetName()].gpu_ms += time_block.GetDuration();
+            }
+        }
+    }
+
+    bool run_world(const string& name, const BenchmarkSettings& settings, WorldResult& result)
+    {
+        result.name = name;
+
+        // Load
+        Spartan::World::Clear();
+        Spartan::Stopwatch stopwatch;
+        if (!create_world(name))
+        {
+            SP_LOG_ERROR("Unknown world \"%s\", expected cube, car, terrain or sponza", name.c_str());
+            return false;
+        }
+
+        // Some worlds keep loading in the background (e.g. the terrain)
+        while (is_loading())
+        {
+            if (stopwatch.GetElapsedTimeSec() > k_load_timeout_sec)
+            {
+                SP_LOG_ERROR("\"%s\" didn't finish loading within %.0f seconds", name.c_str(), k_load_timeout_sec);
+                return false;
+            }
+
+            Benchmark::Tick();
+        }
+        result.load_time_ms = stopwatch.GetElapsedTimeMs();
+
+        // Warm up, this also lets the renderer pick up the camera
+        for (uint32_t i = 0; i < settings.warmup_frame_count; i++)
+        {
+            Benchmark::Tick();
+        }
+
+        shared_ptr<Spartan::Camera> camera = Spartan::Renderer::GetCamera();
+        if (!camera)
+        {
+            SP_LOG_ERROR("\"%s\" has no camera", name.c_str());
+            return false;
+        }
+        Spartan::Transform* transform = camera->GetTransform();
+        const Vector3 origin          = transform->GetPosition();
+        const Quaternion rotation     = transform->GetRotation();
+
+        // Measure
+        result.frame_times_ms.reserve(settings.frame_count);
+        for (uint32_t i = 0; i < settings.frame_count; i++)
+        {
+            fly_camera(transform, origin, rotation, static_cast<float>(i) / static_cast<float>(settings.frame_count));
+
+            stopwatch.Start();
+            Benchmark::Tick();
+            result.frame_times_ms.emplace_back(stopwatch.GetElapsedTimeMs());
+
+            result.cpu_time_ms             += Spartan::Profiler::GetTimeCpuLast();
+            result.gpu_time_ms             += Spartan::Profiler::GetTimeGpuLast();
+            result.draw_calls              += Spartan::Profiler::m_rhi_draw;
+            result.dispatches              += Spartan::Profiler::m_rhi_dispatch;
+            result.meshes_rendered         += Spartan::Profiler::m_renderer_meshes_rendered;
+            result.heap_allocations        += Spartan::MemoryTracker::GetAllocationsFrame();
+            result.resources_cpu_peak      = max(result.resources_cpu_peak, Spartan::ResourceCache::GetMemoryUsageCpu());
+            result.resources_gpu_peak      = max(result.resources_gpu_peak, Spartan::ResourceCache::GetMemoryUsageGpu());
+            result.gpu_memory_used_peak_mb = max(result.gpu_memory_used_peak_mb, Spartan::Profiler::GpuGetMemoryUsed());
+            accumulate_passes(result);
+        }
+
+        transform->SetPosition(origin);
+        transform->SetRotation(rotation);
+
+        return true;
+    }
+
+    void write_json(ofstream& file, const BenchmarkSettings& settings, const vector<WorldResult>& results)
+    {
+        char buffer[512];
+
+        snprintf(buffer, sizeof(buffer),
+            "{\n  \"api\": \"%s\",\n  \"gpu\": \"%s\",\n  \"frame_count\": %u,\n  \"memory_peak_process_mb\": %.2f,\n  \"worlds\":\n  [\n",
+            get_api_name(), Spartan::Profiler::GpuGetName().c_str(), settings.frame_count, static_cast<double>(get_memory_peak_process()) * k_bytes_to_mb
+        );
+        file << buffer;
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const WorldResult& result = results[i];
+            const double frames       = static_cast<double>(max<size_t>(result.frame_times_ms.size(), 1));
+
+            vector<float> sorted = result.frame_times_ms;
+            sort(sorted.begin(), sorted.end());
+
+            double sum = 0.0;
+            for (const float frame_time : sorted)
+            {
+                sum += frame_time;
+            }
+
+            snprintf(buffer, sizeof(buffer),
+                "    {\n      \"name\": \"%s\",\n      \"load_time_ms\": %.3f,\n"
+                "      \"frame_time_ms\": { \"avg\": %.3f, \"min\": %.3f, \"max\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p95\": %.3f, \"p99\": %.3f },\n",
+                result.name.c_str(), result.load_time_ms,
+                sum / frames, sorted.empty() ? 0.0f : sorted.front(), sorted.empty() ? 0.0f : sorted.back(),
+                percentile(sorted, 0.5f), percentile(sorted, 0.9f), percentile(sorted, 0.95f), percentile(sorted, 0.99f)
+            );
+            file << buffer;
+
+            snprintf(buffer, sizeof(buffer),
+                "      \"cpu_time_ms\": %.3f,\n      \"gpu_time_ms\": %.3f,\n"
+                "      \"draw_calls\": %.1f,\n      \"dispatches\": %.1f,\n      \"meshes_rendered\": %.1f,\n      \"heap_allocations\": %.1f,\n"
+                "      \"memory_peak_mb\": { \"resources_cpu\": %.2f, \"resources_gpu\": %.2f, \"gpu_used\": %u },\n",
+                result.cpu_time_ms / frames, result.gpu_time_ms / frames,
+                static_cast<double>(result.draw_calls) / frames, static_cast<double>(result.dispatches) / frames, static_cast<double>(result.meshes_rendered) / frames, static_cast<double>(result.heap_allocations) / frames,
+                static_cast<double>(result.resources_cpu_peak) * k_bytes_to_mb, static_cast<double>(result.resources_gpu_peak) * k_bytes_to_mb, result.gpu_memory_used_peak_mb
+            );
+            file << buffer;
+
+            // Averages per frame
+            file << "      \"passes\":\n      {\n";
+            size_t pass_index = 0;
+            for (const auto& [pass_name, timing] : result.passes)
+            {
+                snprintf(buffer, sizeof(buffer), "        \"%s\": { \"cpu_ms\": %.4f, \"gpu_ms\": %.4f }%s\n",
+                    pass_name.c_str(), timing.cpu_ms / frames, timing.gpu_ms / frames, ++pass_index < result.passes.size() ? "," : ""
+                );
+                file << buffer;
+            }
+            file << "      }\n";
+
+            file << (i + 1 < results.size() ? "    },\n" : "    }\n");
+        }
+
+        file << "  ]\n}\n";
+    }
+}
+
+bool Benchmark::Run(const BenchmarkSettings& settings)
+{
+    vector<WorldResult> results;
+    bool success = true;
+    for (const string& name : settings.worlds)
+    {
+        SP_LOG_INFO("Benchmarking \"%s\"...", name.c_str());
+
+        WorldResult result;
+        if (!run_world(name, settings, result))
+        {
+            success = false;
+            continue;
+        }
+
+        results.emplace_back(move(result));
+    }
+    Spartan::World::Clear();
+
+    ofstream file(settings.output_path, ios::out | ios::trunc);
+    if (!file.is_open())
+    {
+        SP_LOG_ERROR("Failed to open \"%s\"", settings.output_path.c_str());
+        return false;
+    }
+    write_json(file, settings, results);
+    SP_LOG_INFO("Results written to \"%s\"", settings.output_path.c_str());
+
+    return success;
+}
+
+void Benchmark::Tick()
+{
+    Spartan::Engine::Tick();
+    Spartan::Renderer::Present();
+}
@@ -0,0 +1,46 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====
+#include <string>
+#include <vector>
+//================
+
+struct BenchmarkSettings
+{
+    std::vector<std::string> worlds    = { "cube", "car", "terrain", "sponza" };
+    uint32_t frame_count               = 600; // Frames measured per world, during which the camera flies along its path
+    uint32_t warmup_frame_count        = 60;  // Frames rendered before measuring, so that the world has settled
+    std::string output_path            = "benchmark.json";
+};
+
+// Loads the default worlds one after the other, flies the camera along a scripted path
+// and writes frame time percentiles, per pass timings, RHI counts, load times and memory as JSON.
+class Benchmark
+{
+public:
+    static bool Run(const BenchmarkSettings& settings);
+
+    // Ticks the engine and presents, the other benchmarks which need the engine use this too
+    static void Tick();
+};
@@ -0,0 +1,187 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "ComponentBenchmark.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/ComponentStore.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+//=================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+namespace
+{
+    const uint32_t k_entity_count      = 200000;
+    const uint32_t k_renderable_stride = 4;  // Every 4th entity has a renderable
+    const uint32_t k_iteration_count   = 20;
+
+    volatile float sink = 0.0f; // Keeps the results alive
+
+    double time_ms(const function<void()>& function)
+    {
+        function(); // warm up
+
+        const auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < k_iteration_count; i++)
+        {
+            function();
+        }
+
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / k_iteration_count;
+    }
+
+    void print(const char* name, const double store_ms, const double entities_ms)
+    {
+        printf("%-28s %9.3f ms %9.3f ms\n", name, store_ms, entities_ms);
+    }
+}
+
+bool ComponentBenchmark::Run()
+{
+    World::Clear();
+
+    vector<shared_ptr<Entity>> entities;
+    entities.reserve(k_entity_count);
+    for (uint32_t i = 0; i < k_entity_count; i++)
+    {
+        shared_ptr<Entity> entity = World::CreateEntity();
+        if (i % k_renderable_stride == 0)
+        {
+            entity->AddComponent<Renderable>();
+        }
+        entities.emplace_back(entity);
+    }
+
+    printf("%u entities, %zu renderables\n", k_entity_count, ComponentStore::Get<Renderable>().size());
+    printf("%-28s %12s %12s\n", "Benchmark", "Store", "Entities");
+    printf("-----------------------------------------------------\n");
+
+    // One type, every entity has a transform
+    print("Transform",
+        time_ms([]() { World::Each<Transform>([](Transform* transform) { sink = sink + transform->GetMatrix().m30; }); }),
+        time_ms([&entities]()
+        {
+            for (const shared_ptr<Entity>& entity : entities)
+            {
+                if (Transform* transform = entity->GetComponent<Transform>())
+                {
+                    sink = sink + transform->GetMatrix().m30;
+                }
+            }
+        })
+    );
+
+    // Two types, the rarest one is iterated and the other one is looked up
+    auto renderables_through_entities = []()
+    {
+        for (IComponent* component : ComponentStore::Get<Renderable>())
+        {
+            if (Transform* transform = component->GetEntity()->GetComponent<Transform>())
+            {
+                sink = sink + transform->GetMatrix().m30 + static_cast<float>(static_cast<Renderable*>(component)->GetIndexCount());
+            }
+        }
+    };
+    print("Transform + Renderable",
+        time_ms([]() { World::Each<Transform, Renderable>([](Transform* transform, Renderable* renderable) { sink = sink + transform->GetMatrix().m30 + static_cast<float>(renderable->GetIndexCount()); }); }),
+        time_ms(renderables_through_entities)
+    );
+
+    // Shuffle the renderables with removals and re-additions, then see what putting them back in address order buys
+    {
+        mt19937 generator(12345); // Fixed seed, so that runs are comparable
+        for (uint32_t i = 0; i < k_entity_count / k_renderable_stride; i++)
+        {
+            Entity* entity = entities[(generator() % (k_entity_count / k_renderable_stride)) * k_renderable_stride].get();
+            entity->RemoveComponent<Renderable>();
+            entity->AddComponent<Renderable>();
+        }
+
+        const double shuffled_ms = time_ms([]() { World::Each<Renderable>([](Renderable* renderable) { sink = sink + static_cast<float>(renderable->GetIndexCount()); }); });
+        ComponentStore::Sort();
+        const double sorted_ms   = time_ms([]() { World::Each<Renderable>([](Renderable* renderable) { sink = sink + static_cast<float>(renderable->GetIndexCount()); }); });
+        print("Renderable shuffled/sorted", shuffled_ms, sorted_ms);
+    }
+
+    // Remove components while iterating, the ones the function removes (its own and ones further ahead) must not throw the iteration off
+    bool success = true;
+    {
+        const uint32_t count = static_cast<uint32_t>(ComponentStore::Get<Renderable>().size());
+        unordered_set<Renderable*> visited;
+        uint32_t visited_twice = 0;
+        uint32_t removed       = 0;
+        uint32_t removed_ahead = 0;
+
+        World::Each<Renderable>([&](Renderable* renderable)
+        {
+            visited_twice += visited.insert(renderable).second ? 0 : 1;
+
+            // Remove every other one, and occasionally the last one too, which swap and pop would have moved into this slot
+            if (visited.size() % 2 == 0)
+            {
+                renderable->GetEntity()->RemoveComponent<Renderable>();
+                removed++;
+
+                const vector<IComponent*>& components = ComponentStore::Get<Renderable>();
+                IComponent* last                      = components.back();
+                if (visited.size() % 64 == 0 && last && !visited.count(static_cast<Renderable*>(last)))
+                {
+                    last->GetEntity()->RemoveComponent<Renderable>();
+                    removed++;
+                    removed_ahead++;
+                }
+            }
+        });
+
+        const uint32_t remaining = static_cast<uint32_t>(ComponentStore::Get<Renderable>().size());
+        if (visited_twice != 0 || visited.size() + removed_ahead != count || remaining != count - removed)
+        {
+            printf("FAILED: removing while iterating, %u components, %zu visited (%u twice), %u removed (%u ahead), %u remaining\n",
+                count, visited.size(), visited_twice, removed, removed_ahead, remaining);
+            success = false;
+        }
+
+        if (any_of(ComponentStore::Get<Renderable>().begin(), ComponentStore::Get<Renderable>().end(), [](IComponent* component) { return component == nullptr; }))
+        {
+            printf("FAILED: removed components are left in the store after the iteration\n");
+            success = false;
+        }
+    }
+
+    entities.clear();
+    World::Clear();
+
+    return success;
+}
@@ -0,0 +1,225 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "CullingBenchmark.h"
+#include "Rendering/Culling.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+//=================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const uint32_t k_object_count = 20000; // Per depth pyramid
+
+    // With an identity view projection, world space is clip space: x and y in [-1, 1] and z is the reverse-z depth
+    struct Scene
+    {
+        const char* name;
+        uint32_t width;
+        uint32_t height;
+        vector<float> depth;
+    };
+
+    // A wall at 0.5 with a far hole of a single pixel in the last row and column, which odd sizes drop from the mips below
+    Scene create_wall(const uint32_t width, const uint32_t height)
+    {
+        Scene scene = { "wall", width, height, vector<float>(width * height, 0.5f) };
+        scene.depth[(height - 1) * width + (width - 1)] = 0.0f;
+        return scene;
+    }
+
+    // Random depth, so that every texel selection mistake shows up
+    Scene create_noise(const uint32_t width, const uint32_t height, mt19937& generator)
+    {
+        uniform_real_distribution<float> distribution(0.3f, 0.9f);
+
+        Scene scene = { "noise", width, height, vector<float>(width * height) };
+        for (float& depth : scene.depth)
+        {
+            depth = distribution(generator);
+        }
+
+        return scene;
+    }
+
+    vector<CullingObject> create_objects(mt19937& generator)
+    {
+        uniform_real_distribution<float> position(-1.1f, 1.1f);
+        uniform_real_distribution<float> extent(0.0f, 0.3f);
+        uniform_real_distribution<float> depth(0.05f, 0.95f);
+
+        vector<CullingObject> objects(k_object_count);
+        for (CullingObject& object : objects)
+        {
+            const Vector3 center = Vector3(position(generator), position(generator), depth(generator));
+            const Vector3 size   = Vector3(extent(generator), extent(generator), 0.05f);
+            object.aabb_min      = center - size * 0.5f;
+            object.aabb_max      = center + size * 0.5f;
+            object.index_count   = 3;
+        }
+
+        // A quarter of them reach into the bottom right corner with all kinds of sizes, where odd sized mips lose pixels
+        uniform_real_distribution<float> corner_extent(0.01f, 2.0f);
+        for (uint32_t i = 0; i < k_object_count / 4; i++)
+        {
+            CullingObject& object = objects[i];
+            object.aabb_min       = Vector3(1.0f - corner_extent(generator), -1.0f - 0.01f, object.aabb_min.z);
+            object.aabb_max       = Vector3(1.0f + 0.01f, -1.0f + corner_extent(generator), object.aabb_max.z);
+        }
+
+        return objects;
+    }
+
+    // Brute force over every pixel which the object's rectangle overlaps, the nearest depth is the max z (reverse-z)
+    bool is_occluded_reference(const CullingObject& object, const Scene& scene)
+    {
+        const float u_min = clamp(object.aabb_min.x * 0.5f + 0.5f, 0.0f, 1.0f);
+        const float u_max = clamp(object.aabb_max.x * 0.5f + 0.5f, 0.0f, 1.0f);
+        const float v_min = clamp(object.aabb_max.y * -0.5f + 0.5f, 0.0f, 1.0f);
+        const float v_max = clamp(object.aabb_min.y * -0.5f + 0.5f, 0.0f, 1.0f);
+
+        const uint32_t x_min = min(static_cast<uint32_t>(floor(u_min * scene.width)),  scene.width  - 1);
+        const uint32_t y_min = min(static_cast<uint32_t>(floor(v_min * scene.height)), scene.height - 1);
+        const uint32_t x_max = min(static_cast<uint32_t>(floor(u_max * scene.width)),  scene.width  - 1);
+        const uint32_t y_max = min(static_cast<uint32_t>(floor(v_max * scene.height)), scene.height - 1);
+
+        for (uint32_t y = y_min; y <= y_max; y++)
+        {
+            for (uint32_t x = x_min; x <= x_max; x++)
+            {
+                if (scene.depth[y * scene.width + x] <= object.aabb_max.z)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool check_pyramid(const Scene& scene, const DepthPyramid& pyramid)
+    {
+        // Every texel must hold the min of the pixels it covers. Pixels of an odd last row or column are covered by no texel
+        // below, and a side which is down to one texel stops halving, so it keeps covering what it did at that mip.
+        for (uint32_t mip = 1; mip < static_cast<uint32_t>(pyramid.mips.size()); mip++)
+        {
+            const uint32_t mip_width      = max(scene.width  >> mip, 1u);
+            const uint32_t mip_height     = max(scene.height >> mip, 1u);
+            const uint32_t covered_width  = mip_width  == 1 ? bit_floor(scene.width)  : mip_width  << mip;
+            const uint32_t covered_height = mip_height == 1 ? bit_floor(scene.height) : mip_height << mip;
+            for (uint32_t y = 0; y < mip_height; y++)
+            {
+                for (uint32_t x = 0; x < mip_width; x++)
+                {
+                    float expected = 1.0f;
+                    for (uint32_t py = y << mip; py < min((y + 1) << mip, covered_height); py++)
+                    {
+                        for (uint32_t px = x << mip; px < min((x + 1) << mip, covered_width); px++)
+                        {
+                            expected = min(expected, scene.depth[py * scene.width + px]);
+                        }
+                    }
+
+                    if (pyramid.Load(mip, x, y) != expected)
+                    {
+                        printf("FAILED: %s %ux%u, mip %u texel (%u, %u) is %f, expected %f\n", scene.name, scene.width, scene.height, mip, x, y, pyramid.Load(mip, x, y), expected);
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool run_scene(const Scene& scene, const vector<CullingObject>& objects)
+    {
+        DepthPyramid pyramid;
+        Culling::BuildDepthPyramid(scene.depth.data(), scene.width, scene.height, &pyramid);
+        if (!check_pyramid(scene, pyramid))
+            return false;
+
+        // Correctness, occluded objects must really be hidden
+        uint32_t occluded           = 0;
+        uint32_t occluded_reference = 0;
+        for (const CullingObject& object : objects)
+        {
+            if (!Culling::IsInFrustum(object, Matrix::Identity))
+                continue;
+
+            const bool occluded_kernel      = Culling::IsOccluded(object, Matrix::Identity, pyramid);
+            const bool occluded_brute_force = is_occluded_reference(object, scene);
+            occluded                       += occluded_kernel ? 1 : 0;
+            occluded_reference             += occluded_brute_force ? 1 : 0;
+
+            if (occluded_kernel && !occluded_brute_force)
+            {
+                printf("FAILED: %s %ux%u, an object at (%f, %f) - (%f, %f) with depth %f is reported as occluded but is visible\n",
+                    scene.name, scene.width, scene.height, object.aabb_min.x, object.aabb_min.y, object.aabb_max.x, object.aabb_max.y, object.aabb_max.z);
+                return false;
+            }
+        }
+
+        // Speed
+        vector<RHI_Indirect_DrawIndexed> draws(objects.size());
+        const auto start    = chrono::steady_clock::now();
+        const uint32_t kept = Culling::Cull(objects.data(), static_cast<uint32_t>(objects.size()), Matrix::Identity, Matrix::Identity, &pyramid, draws.data());
+        const double ns     = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / static_cast<double>(objects.size());
+
+        char label[64];
+        snprintf(label, sizeof(label), "%s %ux%u", scene.name, scene.width, scene.height);
+        printf("%-20s %10.2f ns %10u %10u %10u\n", label, ns, kept, occluded, occluded_reference);
+
+        return true;
+    }
+}
+
+bool CullingBenchmark::Run()
+{
+    printf("%u objects per depth pyramid, occluded counts are the kernel's and the brute force ones\n", k_object_count);
+    printf("%-20s %13s %10s %10s %10s\n", "Pyramid", "Time/object", "Kept", "Occluded", "Reference");
+    printf("----------------------------------------------------------------------\n");
+
+    mt19937 generator(12345);
+    const vector<CullingObject> objects = create_objects(generator);
+
+    // Powers of two, odd sizes at several mips and the aspect ratios of render resolutions
+    const uint32_t sizes[][2] = { { 64, 64 }, { 7, 5 }, { 13, 9 }, { 100, 37 }, { 255, 129 }, { 1, 33 }, { 1280, 720 }, { 1366, 768 } };
+
+    bool success = true;
+    for (const auto& size : sizes)
+    {
+        success &= run_scene(create_wall(size[0], size[1]), objects);
+        success &= run_scene(create_noise(size[0], size[1], generator), objects);
+    }
+
+    return success;
+}
@@ -0,0 +1,141 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =============================
+#include "DeletionBenchmark.h"
+#include "Benchmark.h"
+#include "Core/Stopwatch.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/Renderer.h"
+#include "RHI/RHI_Vertex.h"
+#include "RHI/RHI_VertexBuffer.h"
+#include "RHI/RHI_IndexBuffer.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+//========================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace
+{
+    const uint32_t k_frame_count       = 600; // Frames with churn
+    const uint32_t k_buffers_per_frame = 256; // Created and released every frame, half static and half mappable
+    const uint32_t k_vertex_count      = 256; // Per buffer
+
+    struct FrameStats
+    {
+        vector<float> frame_times_ms;
+        uint32_t pending_max = 0;
+    };
+
+    void churn(const vector<Spartan::RHI_Vertex_PosCol>& vertices, const vector<uint32_t>& indices)
+    {
+        for (uint32_t i = 0; i < k_buffers_per_frame / 2; i++)
+        {
+            // Released as soon as they go out of scope, while the frame is still being recorded
+            auto vertex_buffer = make_shared<Spartan::RHI_VertexBuffer>(false, "deletion_benchmark");
+            vertex_buffer->Create(vertices);
+
+            auto index_buffer = make_shared<Spartan::RHI_IndexBuffer>(true, "deletion_benchmark");
+            index_buffer->CreateDynamic<uint32_t>(static_cast<uint32_t>(indices.size()));
+        }
+    }
+
+    FrameStats run_frames(const uint32_t frame_count, const bool with_churn)
+    {
+        vector<Spartan::RHI_Vertex_PosCol> vertices(k_vertex_count);
+        vector<uint32_t> indices(k_vertex_count);
+
+        FrameStats stats;
+        stats.frame_times_ms.reserve(frame_count);
+
+        Spartan::Stopwatch stopwatch;
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            stopwatch.Start();
+            if (with_churn)
+            {
+                churn(vertices, indices);
+            }
+            Benchmark::Tick();
+            stats.frame_times_ms.emplace_back(stopwatch.GetElapsedTimeMs());
+
+            stats.pending_max = max(stats.pending_max, Spartan::Profiler::m_rhi_resources_pending);
+        }
+
+        return stats;
+    }
+
+    void print(const char* name, FrameStats stats)
+    {
+        sort(stats.frame_times_ms.begin(), stats.frame_times_ms.end());
+
+        double sum = 0.0;
+        for (const float frame_time : stats.frame_times_ms)
+        {
+            sum += frame_time;
+        }
+
+        const size_t p99 = min(stats.frame_times_ms.size() - 1, stats.frame_times_ms.size() * 99 / 100);
+        printf("%-12s %10.3f ms %10.3f ms %10.3f ms %10u\n", name,
+            sum / static_cast<double>(stats.frame_times_ms.size()), stats.frame_times_ms[p99], stats.frame_times_ms.back(), stats.pending_max);
+    }
+}
+
+bool DeletionBenchmark::Run()
+{
+    // One frame is released per frame, and it can only go once every frame in flight (plus one for other pools) has completed
+    const uint32_t frames_queued   = Spartan::Renderer::GetFramesInFlight() + 2;
+    const uint32_t pending_allowed = frames_queued * k_buffers_per_frame;
+
+    printf("%u buffers created and released per frame, %u frames in flight\n", k_buffers_per_frame, Spartan::Renderer::GetFramesInFlight());
+    printf("%-12s %13s %13s %13s %10s\n", "Benchmark", "Avg", "P99", "Max", "Pending");
+    printf("-------------------------------------------------------------------\n");
+
+    // Without churn first, to see what the deletions cost on top of a frame
+    run_frames(60, false);
+    print("Idle", run_frames(k_frame_count, false));
+
+    const FrameStats churned = run_frames(k_frame_count, true);
+    print("Churn", churned);
+
+    // Once the frames that used them have completed, nothing should be left
+    run_frames(frames_queued, false);
+    const uint32_t pending_after = Spartan::Profiler::m_rhi_resources_pending;
+
+    bool success = true;
+    if (churned.pending_max > pending_allowed)
+    {
+        printf("FAILED: %u resources were pending at once, expected at most %u\n", churned.pending_max, pending_allowed);
+        success = false;
+    }
+    if (pending_after != 0)
+    {
+        printf("FAILED: %u resources are still pending after %u idle frames\n", pending_after, frames_queued);
+        success = false;
+    }
+
+    return success;
+}
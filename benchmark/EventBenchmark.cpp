@@ -0,0 +1,149 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========
+#include "EventBenchmark.h"
+#include "Core/EventBus.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+//======================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace Spartan;
+//==================
+
+namespace
+{
+    const uint32_t k_fire_count     = 10000000;
+    const uint32_t k_batch_size     = 1000;  // Events queued per dispatch
+    const uint32_t k_batch_count    = 1000;
+    const uint32_t k_thread_count   = 4;     // Queuing at the same time
+    const uint32_t k_dispatch_count = 1000000;
+
+    struct BenchmarkEvent
+    {
+        uint32_t index  = 0;
+        uint32_t thread = 0;
+    };
+
+    double seconds_since(const chrono::steady_clock::time_point start)
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    void print(const char* name, const double count, const double seconds)
+    {
+        printf("%-24s %10.2f ns %14.0f/s\n", name, seconds * 1e9 / count, count / seconds);
+    }
+}
+
+bool EventBenchmark::Run()
+{
+    printf("%-24s %13s %16s\n", "Benchmark", "Time", "Throughput");
+    printf("-------------------------------------------------------------\n");
+
+    // Every event that arrives, per thread, so the order can be checked
+    vector<uint32_t> received_next(k_thread_count, 0);
+    uint32_t received       = 0;
+    uint32_t received_wrong = 0;
+    const EventToken token = EventChannel<BenchmarkEvent>::Subscribe([&](const BenchmarkEvent& event)
+    {
+        received_wrong += event.index != received_next[event.thread] ? 1 : 0;
+        received_next[event.thread] = event.index + 1;
+        received++;
+    });
+
+    bool success = true;
+    auto check = [&](const char* name, const uint32_t expected)
+    {
+        if (received != expected || received_wrong != 0)
+        {
+            printf("FAILED: %s, %u events expected, %u received, %u out of order\n", name, expected, received, received_wrong);
+            success = false;
+        }
+
+        received       = 0;
+        received_wrong = 0;
+        fill(received_next.begin(), received_next.end(), 0);
+    };
+
+    // Fire, the handler runs right away
+    auto start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < k_fire_count; i++)
+    {
+        EventChannel<BenchmarkEvent>::Fire(BenchmarkEvent{ i, 0 });
+    }
+    print("Fire", k_fire_count, seconds_since(start));
+    check("Fire", k_fire_count);
+
+    // Queue and dispatch, one thread, the first batch grows the queue and the rest reuse it
+    start = chrono::steady_clock::now();
+    for (uint32_t batch = 0; batch < k_batch_count; batch++)
+    {
+        for (uint32_t i = 0; i < k_batch_size; i++)
+        {
+            EventChannel<BenchmarkEvent>::Queue(BenchmarkEvent{ batch * k_batch_size + i, 0 });
+        }
+        EventBus::Dispatch();
+    }
+    print("Queue+Dispatch", k_batch_count * k_batch_size, seconds_since(start));
+    check("Queue+Dispatch", k_batch_count * k_batch_size);
+
+    // Queue from several threads at once, then dispatch
+    start = chrono::steady_clock::now();
+    {
+        vector<thread> threads;
+        for (uint32_t t = 0; t < k_thread_count; t++)
+        {
+            threads.emplace_back([t]()
+            {
+                for (uint32_t i = 0; i < k_batch_count * k_batch_size / k_thread_count; i++)
+                {
+                    EventChannel<BenchmarkEvent>::Queue(BenchmarkEvent{ i, t });
+                }
+            });
+        }
+
+        for (thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    EventBus::Dispatch();
+    print("Queue (4 threads)", k_batch_count * k_batch_size, seconds_since(start));
+    check("Queue (4 threads)", k_batch_count * k_batch_size);
+
+    // Dispatch with nothing queued, which is what most frames do
+    start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < k_dispatch_count; i++)
+    {
+        EventBus::Dispatch();
+    }
+    print("Dispatch (empty)", k_dispatch_count, seconds_since(start));
+    check("Dispatch (empty)", 0);
+
+    EventChannel<BenchmarkEvent>::Unsubscribe(token);
+
+    return success;
+}
@@ -0,0 +1,127 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "LoadingBenchmark.h"
+#include "Core/FileSystem.h"
+#include "Core/Stopwatch.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+//=================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+namespace
+{
+    const uint32_t k_root_count     = 1000; // Each with 99 children, 100k entities
+    const uint32_t k_children_count = 99;
+    const char* k_file_path         = "benchmark_loading.world";
+
+    // Every entity has to be found by its id and (unique) name, returns how many weren't
+    uint32_t verify_lookups()
+    {
+        uint32_t missing = 0;
+        for (const shared_ptr<Entity>& entity : World::GetAllEntities())
+        {
+            missing += World::GetEntityById(entity->GetObjectId()) != entity ? 1 : 0;
+            missing += World::GetEntityByName(entity->GetName()) != entity ? 1 : 0;
+        }
+
+        return missing;
+    }
+}
+
+bool LoadingBenchmark::Run()
+{
+    World::Clear();
+
+    const Stopwatch stopwatch_create;
+    for (uint32_t root_index = 0; root_index < k_root_count; root_index++)
+    {
+        shared_ptr<Entity> root = World::CreateEntity();
+        root->SetName("root_" + to_string(root_index));
+
+        for (uint32_t child_index = 0; child_index < k_children_count; child_index++)
+        {
+            shared_ptr<Entity> child = World::CreateEntity();
+            child->SetName("child_" + to_string(root_index) + "_" + to_string(child_index));
+            child->GetTransform()->SetParent(root->GetTransform());
+        }
+    }
+    const float create_ms = stopwatch_create.GetElapsedTimeMs();
+
+    const uint32_t entity_count = static_cast<uint32_t>(World::GetAllEntities().size());
+
+    const Stopwatch stopwatch_save;
+    const bool saved    = World::SaveToFile(k_file_path);
+    const float save_ms = stopwatch_save.GetElapsedTimeMs();
+
+    const Stopwatch stopwatch_load;
+    const bool loaded   = saved && World::LoadFromFile(k_file_path);
+    const float load_ms = stopwatch_load.GetElapsedTimeMs();
+
+    printf("%u entities\n", entity_count);
+    printf("%-12s %12s\n", "Benchmark", "Duration");
+    printf("-------------------------\n");
+    printf("%-12s %9.3f ms\n", "Create", create_ms);
+    printf("%-12s %9.3f ms\n", "Save",   save_ms);
+    printf("%-12s %9.3f ms\n", "Load",   load_ms);
+
+    bool success = true;
+    if (!loaded || World::GetAllEntities().size() != entity_count)
+    {
+        printf("FAILED: %zu entities were loaded, expected %u\n", World::GetAllEntities().size(), entity_count);
+        success = false;
+    }
+
+    if (const uint32_t missing = verify_lookups())
+    {
+        printf("FAILED: %u lookups by id or name failed after loading\n", missing);
+        success = false;
+    }
+
+    // Through the base class, which used to bypass the world's lookup tables
+    for (uint32_t i = 0; i < static_cast<uint32_t>(World::GetAllEntities().size()); i += 100)
+    {
+        Object* object = World::GetAllEntities()[i].get();
+        object->SetName("renamed_" + to_string(i));
+        object->SetObjectId(Object::GenerateObjectId());
+    }
+
+    if (const uint32_t missing = verify_lookups())
+    {
+        printf("FAILED: %u lookups by id or name failed after renaming through Object\n", missing);
+        success = false;
+    }
+
+    World::Clear();
+    FileSystem::Delete(k_file_path);
+
+    return success;
+}
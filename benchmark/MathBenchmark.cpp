@@ -0,0 +1,188 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================
+#include "MathBenchmark.h"
+#include "Math/Matrix.h"
+#include "Math/Quaternion.h"
+#include "Math/BoundingBox.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+//===========================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const uint32_t k_input_count     = 1024;    // Enough to leave the cache warm but not let the compiler see through the inputs
+    const uint32_t k_iteration_count = 2000000; // Calls per function and version
+    const float k_tolerance          = 1e-3f;   // Relative, for the versions which don't do the same operations as the scalar ones (inverting a projection loses a few digits either way)
+
+    struct Inputs
+    {
+        vector<Matrix> matrices;
+        vector<Matrix> transforms;
+        vector<BoundingBox> boxes;
+        vector<Quaternion> rotations;
+        vector<float> factors;
+    };
+
+    volatile float sink = 0.0f; // Keeps the results alive
+
+    Inputs create_inputs()
+    {
+        Inputs inputs;
+        mt19937 generator(12345); // Fixed seed, so that runs are comparable
+        uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        auto random = [&]() { return distribution(generator); };
+
+        for (uint32_t i = 0; i < k_input_count; i++)
+        {
+            const Quaternion rotation = Quaternion(random(), random(), random(), random()).Normalized();
+            const Vector3 position    = Vector3(random(), random(), random()) * 100.0f;
+            const Vector3 scale       = Vector3(1.5f + random(), 1.5f + random(), 1.5f + random());
+            const Vector3 extents     = Vector3(1.5f + random(), 1.5f + random(), 1.5f + random());
+
+            inputs.rotations.emplace_back(rotation);
+            inputs.transforms.emplace_back(position, rotation, scale);
+            inputs.matrices.emplace_back(inputs.transforms.back() * Matrix::CreatePerspectiveFieldOfViewLH(1.0f, 1.7f, 0.1f, 1000.0f));
+            inputs.boxes.emplace_back(position - extents, position + extents);
+            inputs.factors.emplace_back(random() * 0.5f + 0.5f);
+        }
+
+        return inputs;
+    }
+
+    bool equals(const float a, const float b, const bool exact)
+    {
+        if (isnan(a) && isnan(b))
+            return true;
+
+        if (exact)
+            return a == b;
+
+        return fabs(a - b) <= k_tolerance * max(1.0f, fabs(b));
+    }
+
+    bool equals(const Matrix& a, const Matrix& b, const bool exact)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            if (!equals(a.Data()[i], b.Data()[i], exact))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool equals(const BoundingBox& a, const BoundingBox& b, const bool exact)
+    {
+        return equals(a.GetMin().x, b.GetMin().x, exact) && equals(a.GetMin().y, b.GetMin().y, exact) && equals(a.GetMin().z, b.GetMin().z, exact) &&
+               equals(a.GetMax().x, b.GetMax().x, exact) && equals(a.GetMax().y, b.GetMax().y, exact) && equals(a.GetMax().z, b.GetMax().z, exact);
+    }
+
+    // Same layout as Google Benchmark, so the numbers can be read the same way
+    template<typename Function>
+    void measure(const char* name, const char* version, const Function& call)
+    {
+        const auto start = chrono::steady_clock::now();
+        float sum        = 0.0f;
+        for (uint32_t i = 0; i < k_iteration_count; i++)
+        {
+            sum += call(i % k_input_count);
+        }
+        const auto end = chrono::steady_clock::now();
+        sink           = sink + sum;
+
+        const double ns = chrono::duration<double, nano>(end - start).count() / k_iteration_count;
+        char label[64];
+        snprintf(label, sizeof(label), "%s/%s", name, version);
+        printf("%-32s %10.2f ns %12u\n", label, ns, k_iteration_count);
+    }
+
+    bool verify(const char* name, const bool passed)
+    {
+        if (!passed)
+        {
+            printf("%s/%s doesn't match the scalar version\n", name, Simd::GetName());
+        }
+
+        return passed;
+    }
+}
+
+bool MathBenchmark::Run()
+{
+    const Inputs inputs = create_inputs();
+    bool success        = true;
+
+    // Where the build falls back to the scalar versions, the results have to match exactly
+#if defined(SP_SIMD_AVX2)
+    const bool exact_multiply = false; // Fused multiply-adds round differently
+#else
+    const bool exact_multiply = true;
+#endif
+#if defined(SP_SIMD_SSE)
+    const bool exact_sse = false;
+#else
+    const bool exact_sse = true;
+#endif
+
+    for (uint32_t i = 0; i < k_input_count; i++)
+    {
+        const Matrix& a = inputs.matrices[i];
+        const Matrix& b = inputs.matrices[(i + 1) % k_input_count];
+
+        bool passed = true;
+        passed = passed && verify("MatrixMultiply", equals(a * b, Matrix::MultiplyScalar(a, b), exact_multiply));
+        passed = passed && verify("MatrixInvert", equals(a.Inverted(), Matrix::InvertScalar(a), exact_sse));
+        passed = passed && verify("BoundingBoxTransform", equals(inputs.boxes[i].Transform(inputs.transforms[i]), inputs.boxes[i].TransformScalar(inputs.transforms[i]), exact_sse));
+
+        if (!passed)
+        {
+            success = false;
+            break;
+        }
+    }
+
+    printf("Built with: %s\n", Simd::GetName());
+    printf("%-32s %13s %12s\n", "Benchmark", "Time", "Iterations");
+    printf("----------------------------------------------------------\n");
+
+    measure("MatrixMultiply", "Scalar", [&](uint32_t i) { return Matrix::MultiplyScalar(inputs.matrices[i], inputs.matrices[(i + 1) % k_input_count]).m00; });
+    measure("MatrixMultiply", Simd::GetName(), [&](uint32_t i) { return (inputs.matrices[i] * inputs.matrices[(i + 1) % k_input_count]).m00; });
+    measure("MatrixInvert", "Scalar", [&](uint32_t i) { return Matrix::InvertScalar(inputs.matrices[i]).m00; });
+    measure("MatrixInvert", Simd::GetName(), [&](uint32_t i) { return inputs.matrices[i].Inverted().m00; });
+    measure("BoundingBoxTransform", "Scalar", [&](uint32_t i) { return inputs.boxes[i].TransformScalar(inputs.transforms[i]).GetMin().x; });
+    measure("BoundingBoxTransform", Simd::GetName(), [&](uint32_t i) { return inputs.boxes[i].Transform(inputs.transforms[i]).GetMin().x; });
+
+    // Scalar only, SIMD measured slower for both
+    measure("QuaternionMultiply", "Scalar", [&](uint32_t i) { return (inputs.rotations[i] * inputs.rotations[(i + 1) % k_input_count]).w; });
+    measure("QuaternionSlerp", "Scalar", [&](uint32_t i) { return Quaternion::Slerp(inputs.rotations[i], inputs.rotations[(i + 1) % k_input_count], inputs.factors[i]).w; });
+
+    return success;
+}
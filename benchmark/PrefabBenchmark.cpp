@@ -0,0 +1,142 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "PrefabBenchmark.h"
+#include "Core/Stopwatch.h"
+#include "Physics/Physics.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Prefab.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+//==========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const uint32_t k_child_count   = 3;
+    const uint32_t k_entity_count  = k_child_count + 1;
+    const uint32_t k_instance_counts[] = { 100, 1000, 10000 };
+
+    shared_ptr<Entity> build(const Vector3& position)
+    {
+        shared_ptr<Entity> root = World::CreateEntity();
+        root->SetName("prefab_benchmark");
+        root->GetTransform()->SetPosition(position);
+        root->AddComponent<Collider>();
+        root->AddComponent<RigidBody>()->SetMass(1.0f);
+
+        for (uint32_t i = 0; i < k_child_count; i++)
+        {
+            shared_ptr<Entity> child = World::CreateEntity();
+            child->GetTransform()->SetParent(root->GetTransform());
+            child->GetTransform()->SetPositionLocal(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+            child->AddComponent<Renderable>();
+        }
+
+        return root;
+    }
+
+    vector<Matrix> transforms(const uint32_t count)
+    {
+        vector<Matrix> transforms;
+        transforms.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            transforms.emplace_back(Matrix::CreateTranslation(Vector3(static_cast<float>(i % 100) * 4.0f, 0.0f, static_cast<float>(i / 100) * 4.0f)));
+        }
+
+        return transforms;
+    }
+}
+
+bool PrefabBenchmark::Run()
+{
+    World::Clear();
+
+    bool success = true;
+    auto check = [&success](const char* name, const uint32_t value, const uint32_t expected)
+    {
+        if (value != expected)
+        {
+            printf("FAILED: %s, %u expected, %u found\n", name, expected, value);
+            success = false;
+        }
+    };
+
+    // The source stays in the world, capturing it must not add anything to the physics world
+    shared_ptr<Entity> source    = build(Vector3::Zero);
+    const uint32_t bodies_source = Physics::GetBodyCount();
+
+    shared_ptr<Prefab> prefab = make_shared<Prefab>();
+    prefab->Capture(source.get());
+    check("Physics bodies after capturing", Physics::GetBodyCount(), bodies_source);
+    check("Prefab entities", prefab->GetEntityCount(), k_entity_count);
+
+    printf("%u entities per instance\n", k_entity_count);
+    printf("%-12s %14s %14s %14s\n", "Instances", "Prefab", "By hand", "Per instance");
+    printf("--------------------------------------------------------------\n");
+
+    for (const uint32_t count : k_instance_counts)
+    {
+        const vector<Matrix> instance_transforms = transforms(count);
+
+        const uint32_t entities_before = static_cast<uint32_t>(World::GetAllEntities().size());
+        const uint32_t bodies_before   = Physics::GetBodyCount();
+
+        Stopwatch stopwatch;
+        vector<shared_ptr<Entity>> instances;
+        prefab->Instantiate(instance_transforms, &instances);
+        const float prefab_ms = stopwatch.GetElapsedTimeMs();
+
+        check("Instances", static_cast<uint32_t>(instances.size()), count);
+        check("Entities added by instantiating", static_cast<uint32_t>(World::GetAllEntities().size()) - entities_before, count * k_entity_count);
+        check("Physics bodies added by instantiating", Physics::GetBodyCount() - bodies_before, count);
+
+        stopwatch.Start();
+        for (const Matrix& transform : instance_transforms)
+        {
+            build(transform.GetTranslation());
+        }
+        const float by_hand_ms = stopwatch.GetElapsedTimeMs();
+
+        printf("%-12u %11.2f ms %11.2f ms %11.2f us\n", count, prefab_ms, by_hand_ms, prefab_ms * 1000.0f / static_cast<float>(count));
+    }
+
+    // Destroying the prefab and the world must leave the physics world empty
+    prefab = nullptr;
+    source = nullptr;
+    World::Clear();
+    check("Physics bodies after clearing the world", Physics::GetBodyCount(), 0);
+
+    return success;
+}
@@ -0,0 +1,158 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =============================
+#include "SpawnBenchmark.h"
+#include "Benchmark.h"
+#include "Core/Stopwatch.h"
+#include "Rendering/Renderer.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+//========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const uint32_t k_frame_count      = 600;
+    const uint32_t k_spawns_per_frame = 1000;
+
+    // Tracks the entities the renderer holds on to which are no longer in the world, returns the most frames any of them has been held for
+    uint32_t track_stale(unordered_map<Entity*, uint32_t>& stale)
+    {
+        unordered_map<Entity*, uint32_t> stale_now;
+        uint32_t frames_max = 0;
+
+        for (const auto& [type, entities] : Renderer::GetEntities())
+        {
+            for (const shared_ptr<Entity>& entity : entities)
+            {
+                if (World::EntityExists(entity.get()) || stale_now.count(entity.get()))
+                    continue;
+
+                auto it             = stale.find(entity.get());
+                const uint32_t held = (it != stale.end() ? it->second : 0) + 1;
+                stale_now[entity.get()] = held;
+                frames_max              = max(frames_max, held);
+            }
+        }
+
+        stale = move(stale_now);
+        return frames_max;
+    }
+}
+
+bool SpawnBenchmark::Run()
+{
+    World::Clear();
+
+    // The renderer only patches its entities when resources are safe, so it can take all the frames in flight
+    const uint32_t frames_queued = Renderer::GetFramesInFlight() + 2;
+
+    printf("%u entities spawned and despawned per frame, %u frames\n", k_spawns_per_frame, k_frame_count);
+
+    vector<shared_ptr<Entity>> spawned_previous;
+    vector<shared_ptr<Entity>> spawned;
+    spawned_previous.reserve(k_spawns_per_frame);
+    spawned.reserve(k_spawns_per_frame);
+
+    unordered_map<Entity*, uint32_t> stale;
+    uint32_t stale_frames_max = 0;
+    vector<float> frame_times_ms;
+    frame_times_ms.reserve(k_frame_count);
+
+    Stopwatch stopwatch;
+    for (uint32_t frame = 0; frame < k_frame_count; frame++)
+    {
+        stopwatch.Start();
+
+        // Last frame's entities changed (their components were added) and go before the renderer has necessarily seen them
+        for (const shared_ptr<Entity>& entity : spawned_previous)
+        {
+            World::RemoveEntity(entity.get());
+        }
+        spawned_previous.clear();
+
+        for (uint32_t i = 0; i < k_spawns_per_frame; i++)
+        {
+            shared_ptr<Entity> entity = World::CreateEntity();
+            entity->GetTransform()->SetPosition(Vector3(static_cast<float>(i), 0.0f, static_cast<float>(frame)));
+            entity->AddComponent<Renderable>();
+            spawned.emplace_back(entity);
+        }
+
+        Benchmark::Tick();
+        frame_times_ms.emplace_back(stopwatch.GetElapsedTimeMs());
+
+        stale_frames_max = max(stale_frames_max, track_stale(stale));
+        swap(spawned_previous, spawned);
+    }
+
+    // Despawn the rest, once the frames in flight are through nothing which was despawned should be left
+    for (const shared_ptr<Entity>& entity : spawned_previous)
+    {
+        World::RemoveEntity(entity.get());
+    }
+    spawned_previous.clear();
+
+    for (uint32_t frame = 0; frame < frames_queued; frame++)
+    {
+        Benchmark::Tick();
+        stale_frames_max = max(stale_frames_max, track_stale(stale));
+    }
+
+    sort(frame_times_ms.begin(), frame_times_ms.end());
+    double sum = 0.0;
+    for (const float frame_time : frame_times_ms)
+    {
+        sum += frame_time;
+    }
+    const size_t p99 = min(frame_times_ms.size() - 1, frame_times_ms.size() * 99 / 100);
+    printf("Frame: avg %.3f ms, p99 %.3f ms, max %.3f ms\n", sum / static_cast<double>(frame_times_ms.size()), frame_times_ms[p99], frame_times_ms.back());
+    printf("Despawned entities were held by the renderer for at most %u frames\n", stale_frames_max);
+
+    bool success = true;
+    if (stale_frames_max > frames_queued)
+    {
+        printf("FAILED: the renderer held on to a despawned entity for %u frames, expected at most %u\n", stale_frames_max, frames_queued);
+        success = false;
+    }
+    if (!stale.empty())
+    {
+        printf("FAILED: the renderer still holds %zu despawned entities\n", stale.size());
+        success = false;
+    }
+
+    World::Clear();
+
+    return success;
+}
@@ -0,0 +1,198 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "TransformBenchmark.h"
+#include "Benchmark.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/TransformHierarchy.h"
+#include "World/Components/Transform.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const uint32_t k_root_count      = 1000; // Each with 9 children, each with 10 children, 100k transforms in 3 levels
+    const uint32_t k_children_mid    = 9;
+    const uint32_t k_children_leaf   = 10;
+    const uint32_t k_iteration_count = 100;
+    const float k_tolerance          = 1e-4f;
+
+    struct Hierarchy
+    {
+        vector<Transform*> transforms; // parents precede their children
+        vector<int32_t> parents;
+        vector<uint32_t> roots;
+        vector<uint32_t> leaves;
+    };
+
+    void add(Hierarchy& hierarchy, const int32_t parent, const Vector3& position)
+    {
+        shared_ptr<Entity> entity = World::CreateEntity();
+        Transform* transform      = entity->GetTransform();
+        transform->SetPositionLocal(position);
+        transform->SetRotationLocal(Quaternion::FromEulerAngles(position.x * 10.0f, position.y * 10.0f, 0.0f));
+        if (parent != -1)
+        {
+            transform->SetParent(hierarchy.transforms[parent]);
+        }
+
+        hierarchy.transforms.emplace_back(transform);
+        hierarchy.parents.emplace_back(parent);
+    }
+
+    Hierarchy create_hierarchy()
+    {
+        Hierarchy hierarchy;
+        for (uint32_t root = 0; root < k_root_count; root++)
+        {
+            const int32_t root_index = static_cast<int32_t>(hierarchy.transforms.size());
+            hierarchy.roots.emplace_back(root_index);
+            add(hierarchy, -1, Vector3(static_cast<float>(root), 0.0f, 0.0f));
+
+            for (uint32_t mid = 0; mid < k_children_mid; mid++)
+            {
+                const int32_t mid_index = static_cast<int32_t>(hierarchy.transforms.size());
+                add(hierarchy, root_index, Vector3(0.0f, 1.0f + mid, 0.0f));
+
+                for (uint32_t leaf = 0; leaf < k_children_leaf; leaf++)
+                {
+                    hierarchy.leaves.emplace_back(static_cast<uint32_t>(hierarchy.transforms.size()));
+                    add(hierarchy, mid_index, Vector3(0.0f, 0.0f, 1.0f + leaf));
+                }
+            }
+        }
+
+        return hierarchy;
+    }
+
+    // Recomputes every world matrix from the local properties, returns how many transforms disagree
+    uint32_t verify(const Hierarchy& hierarchy)
+    {
+        vector<Matrix> reference(hierarchy.transforms.size());
+        uint32_t mismatches = 0;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(hierarchy.transforms.size()); i++)
+        {
+            const Transform* transform = hierarchy.transforms[i];
+            const Matrix local         = Matrix(transform->GetPositionLocal(), transform->GetRotationLocal(), transform->GetScaleLocal());
+            reference[i]               = hierarchy.parents[i] == -1 ? local : local * reference[hierarchy.parents[i]];
+
+            const float* expected = reference[i].Data();
+            const float* actual   = transform->GetMatrix().Data();
+            for (uint32_t element = 0; element < 16; element++)
+            {
+                if (fabs(expected[element] - actual[element]) > k_tolerance * max(1.0f, fabs(expected[element])))
+                {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+
+        return mismatches;
+    }
+
+    void move(const Hierarchy& hierarchy, const vector<uint32_t>& indices, const uint32_t step, const uint32_t stride)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(indices.size()); i += stride)
+        {
+            Transform* transform = hierarchy.transforms[indices[i]];
+            transform->SetPositionLocal(transform->GetPositionLocal() + Vector3(0.0f, 0.01f * (step % 2 ? 1.0f : -1.0f), 0.0f));
+        }
+    }
+
+    // Times the end of frame resolve, the setters are done before the clock starts
+    double time_ms(const function<void(uint32_t)>& prepare)
+    {
+        const vector<shared_ptr<Entity>>& entities = World::GetAllEntities();
+
+        double total = 0.0;
+        for (uint32_t i = 0; i < k_iteration_count; i++)
+        {
+            prepare(i);
+
+            const auto start = chrono::steady_clock::now();
+            TransformHierarchy::Tick(entities);
+            total += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+
+        return total / k_iteration_count;
+    }
+}
+
+bool TransformBenchmark::Run()
+{
+    World::Clear();
+    const Hierarchy hierarchy = create_hierarchy();
+    Benchmark::Tick();
+
+    printf("%u transforms, %u levels\n", TransformHierarchy::GetTransformCount(), TransformHierarchy::GetLevelCount());
+    printf("%-16s %12s\n", "Benchmark", "Resolve");
+    printf("-----------------------------\n");
+    printf("%-16s %9.3f ms\n", "Unchanged",    time_ms([](uint32_t) {}));
+    printf("%-16s %9.3f ms\n", "Roots moved",  time_ms([&hierarchy](uint32_t i) { move(hierarchy, hierarchy.roots, i, 1); }));
+    printf("%-16s %9.3f ms\n", "10% of leaves", time_ms([&hierarchy](uint32_t i) { move(hierarchy, hierarchy.leaves, i, 10); }));
+
+    bool success = true;
+    auto check = [&success, &hierarchy](const char* name)
+    {
+        const uint32_t mismatches = verify(hierarchy);
+        if (mismatches != 0)
+        {
+            printf("FAILED: %s, %u world matrices don't match their parents\n", name, mismatches);
+            success = false;
+        }
+    };
+
+    // Once the world has ticked
+    move(hierarchy, hierarchy.roots, 0, 1);
+    Benchmark::Tick();
+    check("after a frame");
+
+    // Mid-frame, e.g. physics moved the roots and a system reads a descendant, it must not see last frame's matrix
+    move(hierarchy, hierarchy.roots, 1, 1);
+    TransformHierarchy::Resolve(World::GetAllEntities());
+    check("mid-frame");
+    if (!hierarchy.transforms[hierarchy.leaves[0]]->IsDirty())
+    {
+        printf("FAILED: a mid-frame resolve ended the frame of the moved transforms\n");
+        success = false;
+    }
+    Benchmark::Tick();
+    check("after a mid-frame resolve");
+
+    World::Clear();
+
+    return success;
+}
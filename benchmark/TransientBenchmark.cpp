@@ -0,0 +1,103 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "TransientBenchmark.h"
+#include "Benchmark.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/RenderGraph.h"
+#include <cstdio>
+#include <initializer_list>
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace
+{
+    // The render graph evicts pooled textures after 60 frames without use, a few more cover the frames in flight
+    const uint32_t k_frames_evict = 64;
+
+    void run_frames(const uint32_t frame_count)
+    {
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            Benchmark::Tick();
+        }
+    }
+
+    void print(const char* name)
+    {
+        const Spartan::RenderGraph& render_graph = Spartan::Renderer::GetRenderGraph();
+        printf("%-28s %10u %10.2f MB\n", name, render_graph.GetTransientCount(), static_cast<double>(render_graph.GetTransientMemory()) / (1024.0 * 1024.0));
+    }
+}
+
+bool TransientBenchmark::Run()
+{
+    const float bloom          = Spartan::Renderer::GetOption<float>(Spartan::RendererOption::Bloom);
+    const float depth_of_field = Spartan::Renderer::GetOption<float>(Spartan::RendererOption::DepthOfField);
+
+    printf("%-28s %10s %13s\n", "Benchmark", "Textures", "Memory");
+    printf("-----------------------------------------------------\n");
+
+    Spartan::Renderer::SetOption(Spartan::RendererOption::Bloom, 1.0f);
+    Spartan::Renderer::SetOption(Spartan::RendererOption::DepthOfField, 1.0f);
+    run_frames(k_frames_evict);
+    print("Bloom and depth of field");
+    const uint64_t memory_enabled = Spartan::Renderer::GetRenderGraph().GetTransientMemory();
+
+    // The renderer should let go of the textures as soon as no pass uses them, leaving the pool as their only owner
+    Spartan::Renderer::SetOption(Spartan::RendererOption::Bloom, 0.0f);
+    Spartan::Renderer::SetOption(Spartan::RendererOption::DepthOfField, 0.0f);
+    run_frames(1);
+    print("Disabled");
+
+    bool success = true;
+    for (const Spartan::RendererTexture texture : { Spartan::RendererTexture::bloom, Spartan::RendererTexture::dof_half, Spartan::RendererTexture::dof_half_2 })
+    {
+        if (Spartan::Renderer::GetRenderTargets()[static_cast<uint32_t>(texture)])
+        {
+            printf("FAILED: render target %u is still bound while no pass uses it\n", static_cast<uint32_t>(texture));
+            success = false;
+        }
+    }
+
+    // Once the pool evicts them, nothing should be holding on to them
+    run_frames(k_frames_evict);
+    print("Disabled, after eviction");
+    const uint64_t memory_disabled = Spartan::Renderer::GetRenderGraph().GetTransientMemory();
+
+    if (memory_disabled >= memory_enabled)
+    {
+        printf("FAILED: the transients use %llu bytes after eviction, %llu with the effects enabled\n",
+            static_cast<unsigned long long>(memory_disabled), static_cast<unsigned long long>(memory_enabled));
+        success = false;
+    }
+
+    printf("\n%s", Spartan::Renderer::GetRenderGraph().GetSchedule().c_str());
+
+    Spartan::Renderer::SetOption(Spartan::RendererOption::Bloom, bloom);
+    Spartan::Renderer::SetOption(Spartan::RendererOption::DepthOfField, depth_of_field);
+
+    return success;
+}
@@ -0,0 +1,159 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================
+#include "Benchmark.h"
+#include "MathBenchmark.h"
+#include "AllocationBenchmark.h"
+#include "CullingBenchmark.h"
+#include "EventBenchmark.h"
+#include "ComponentBenchmark.h"
+#include "LoadingBenchmark.h"
+#include "DeletionBenchmark.h"
+#include "TransformBenchmark.h"
+#include "SpawnBenchmark.h"
+#include "PrefabBenchmark.h"
+#include "TransientBenchmark.h"
+#include "Core/Engine.h"
+#include "Core/Timer.h"
+#include "Profiling/Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+//============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+// Usage: benchmark --math, to verify and time the SIMD math without initializing the engine
+//        benchmark --culling, to verify the CPU culling kernel against depth pyramids with known contents, without initializing the engine
+//        benchmark --events, to time firing, queuing and dispatching events and verify queued events arrive once and in order, without initializing the engine
+//        benchmark --allocation, to time spawning and despawning entities through the world and verify released handles never resolve
+//        benchmark --deletion, to check that GPU resources released every frame are destroyed once their frames complete
+//        benchmark --transforms, to verify and time resolving the world matrices of a large transform hierarchy
+//        benchmark --components, to time iterating the components of 200k entities and verify removing them while iterating
+//        benchmark --loading, to time saving and loading 100k entities and verify they can be looked up by id and name
+//        benchmark --spawn, to spawn and despawn 1k entities per frame and verify the renderer lets go of the despawned ones
+//        benchmark --prefabs, to time instantiating prefabs and verify that only the instances add physics bodies
+//        benchmark --transients, to turn bloom and depth of field off and verify their render targets are released once the render graph evicts them
+//        benchmark [--worlds cube,car,terrain,sponza] [--frames 600] [--warmup 60] [--output benchmark.json]
+static BenchmarkSettings parse_arguments(int argc, char** argv)
+{
+    BenchmarkSettings settings;
+
+    for (int i = 1; i < argc - 1; i++)
+    {
+        const char* value = argv[i + 1];
+
+        if (strcmp(argv[i], "--worlds") == 0)
+        {
+            settings.worlds.clear();
+            for (const char* start = value; *start;)
+            {
+                const char* end = strchr(start, ',');
+                settings.worlds.emplace_back(start, end ? end - start : strlen(start));
+                start = end ? end + 1 : start + strlen(start);
+            }
+        }
+        else if (strcmp(argv[i], "--frames") == 0)
+        {
+            settings.frame_count = static_cast<uint32_t>(atoi(value));
+        }
+        else if (strcmp(argv[i], "--warmup") == 0)
+        {
+            settings.warmup_frame_count = static_cast<uint32_t>(atoi(value));
+        }
+        else if (strcmp(argv[i], "--output") == 0)
+        {
+            settings.output_path = value;
+        }
+    }
+
+    return settings;
+}
+
+// Initializes the engine, runs the benchmark and shuts the engine down
+static bool run_engine(const function<bool()>& benchmark)
+{
+    // Without a display (e.g. a CI machine), let SDL create its window with the dummy video driver
+    #ifndef _MSC_VER
+    if (!getenv("DISPLAY") && !getenv("WAYLAND_DISPLAY"))
+    {
+        setenv("SDL_VIDEODRIVER", "dummy", 0);
+    }
+    #endif
+
+    Spartan::Engine::Initialize();
+
+    // Measure as fast as the engine can go, with every frame profiled
+    Spartan::Timer::SetFpsLimit(numeric_limits<float>::max());
+    Spartan::Profiler::SetEnabled(true);
+    Spartan::Profiler::SetUpdateInterval(0.0f);
+
+    const bool success = benchmark();
+    Spartan::Engine::Shutdown();
+
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--math") == 0)
+            return MathBenchmark::Run() ? 0 : 1;
+
+        if (strcmp(argv[i], "--culling") == 0)
+            return CullingBenchmark::Run() ? 0 : 1;
+
+        if (strcmp(argv[i], "--events") == 0)
+            return EventBenchmark::Run() ? 0 : 1;
+
+        if (strcmp(argv[i], "--allocation") == 0)
+            return run_engine(AllocationBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--deletion") == 0)
+            return run_engine(DeletionBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--transforms") == 0)
+            return run_engine(TransformBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--components") == 0)
+            return run_engine(ComponentBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--loading") == 0)
+            return run_engine(LoadingBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--spawn") == 0)
+            return run_engine(SpawnBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--prefabs") == 0)
+            return run_engine(PrefabBenchmark::Run) ? 0 : 1;
+
+        if (strcmp(argv[i], "--transients") == 0)
+            return run_engine(TransientBenchmark::Run) ? 0 : 1;
+    }
+
+    const BenchmarkSettings settings = parse_arguments(argc, argv);
+    return run_engine([&settings]() { return Benchmark::Run(settings); }) ? 0 : 1;
+}
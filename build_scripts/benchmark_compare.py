@@ -0,0 +1,64 @@
+# Compares the output of the benchmark against a stored baseline and fails when something got slower.
+# usage: python3 build_scripts/benchmark_compare.py <baseline.json> <current.json> [threshold, default 0.1 (10%)]
+
+import json
+import sys
+
+# Timings which are smaller than this (in ms) are too noisy to compare
+min_time_ms = 0.05
+
+def load(path):
+    with open(path) as file:
+        return {world["name"]: world for world in json.load(file)["worlds"]}
+
+def compare(label, baseline, current, threshold, regressions):
+    if baseline < min_time_ms:
+        return
+
+    change = (current - baseline) / baseline
+    flag   = ""
+    if change > threshold:
+        flag = "  <-- regression"
+        regressions.append(label)
+
+    print(f"{label:<60} {baseline:>10.3f} {current:>10.3f} {change * 100.0:>+8.1f}%{flag}")
+
+def main():
+    if len(sys.argv) < 3:
+        print("usage: benchmark_compare.py <baseline.json> <current.json> [threshold]")
+        sys.exit(2)
+
+    baseline_worlds = load(sys.argv[1])
+    current_worlds  = load(sys.argv[2])
+    threshold       = float(sys.argv[3]) if len(sys.argv) > 3 else 0.1
+    regressions     = []
+
+    print(f"{'':<60} {'baseline':>10} {'current':>10} {'change':>9}")
+    for name, baseline in baseline_worlds.items():
+        current = current_worlds.get(name)
+        if current is None:
+            print(f"{name}: missing from the current results")
+            regressions.append(name)
+            continue
+
+        for percentile in ["p50", "p95", "p99"]:
+            compare(f"{name} frame_time_ms {percentile}", baseline["frame_time_ms"][percentile], current["frame_time_ms"][percentile], threshold, regressions)
+        compare(f"{name} cpu_time_ms", baseline["cpu_time_ms"], current["cpu_time_ms"], threshold, regressions)
+        compare(f"{name} gpu_time_ms", baseline["gpu_time_ms"], current["gpu_time_ms"], threshold, regressions)
+        compare(f"{name} load_time_ms", baseline["load_time_ms"], current["load_time_ms"], threshold, regressions)
+
+        for pass_name, timing in baseline["passes"].items():
+            timing_current = current["passes"].get(pass_name)
+            if timing_current is not None:
+                compare(f"{name} {pass_name} cpu_ms", timing["cpu_ms"], timing_current["cpu_ms"], threshold, regressions)
+                compare(f"{name} {pass_name} gpu_ms", timing["gpu_ms"], timing_current["gpu_ms"], threshold, regressions)
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {threshold * 100.0:.0f}%")
+        sys.exit(1)
+
+    print("\nNo regressions")
+    sys.exit(0)
+
+if __name__ == "__main__":
+    main()
@@ -20,9 +20,11 @@
 CPP_VERSION			     = "C++20"
 SOLUTION_NAME            = "spartan"
 EDITOR_PROJECT_NAME      = "editor"
+BENCHMARK_PROJECT_NAME   = "benchmark"
 RUNTIME_PROJECT_NAME     = "runtime"
 EXECUTABLE_NAME          = "spartan"
 EDITOR_DIR               = "../" .. EDITOR_PROJECT_NAME
+BENCHMARK_DIR            = "../" .. BENCHMARK_PROJECT_NAME
 RUNTIME_DIR              = "../" .. RUNTIME_PROJECT_NAME
 LIBRARY_DIR              = "../third_party/libraries"
 OBJ_DIR                  = "../binaries/obj"
@@ -39,16 +41,19 @@ if API_GRAPHICS == "d3d11" then
 	EXECUTABLE_NAME = EXECUTABLE_NAME .. "_d3d11"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D12/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "d3d12" then
 	API_GRAPHICS    = "API_GRAPHICS_D3D12"
 	EXECUTABLE_NAME = EXECUTABLE_NAME .. "_d3d12"
 	IGNORE_FILES[0] = RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1] = RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2] = RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "vulkan" then
 	API_GRAPHICS    = "API_GRAPHICS_VULKAN"
 	EXECUTABLE_NAME = EXECUTABLE_NAME .. "_vulkan"
 	IGNORE_FILES[0] = RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1] = RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2] = RUNTIME_DIR .. "/RHI/Null/**"
 
 	ADDITIONAL_INCLUDES[0] = "../third_party/spirv_cross";
 	ADDITIONAL_INCLUDES[1] = "../third_party/vulkan";
@@ -71,7 +76,14 @@ elseif API_GRAPHICS == "vulkan" then
 	ADDITIONAL_LIBRARIES_DBG[5] = "spirv-cross-reflect_debug";
 	ADDITIONAL_LIBRARIES_DBG[6] = "ffx_fsr2_api_x64_debug";
 	ADDITIONAL_LIBRARIES_DBG[7] = "ffx_fsr2_api_vk_x64_debug";
+elseif API_GRAPHICS == "null" then
+	API_GRAPHICS    = "API_GRAPHICS_NULL"
+	EXECUTABLE_NAME = EXECUTABLE_NAME .. "_null"
+	IGNORE_FILES[0] = RUNTIME_DIR .. "/RHI/D3D11/**"
+	IGNORE_FILES[1] = RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2] = RUNTIME_DIR .. "/RHI/Vulkan/**"
 end
+BENCHMARK_EXECUTABLE = EXECUTABLE_NAME .. "_benchmark"
 
 -- Solution -------------------------------------------------------------------------------------------------------
 solution (SOLUTION_NAME)
@@ -135,7 +147,7 @@ project (RUNTIME_PROJECT_NAME)
 	}
 
 	-- Source to ignore
-	removefiles { IGNORE_FILES[0], IGNORE_FILES[1] }
+	removefiles { IGNORE_FILES[0], IGNORE_FILES[1], IGNORE_FILES[2] }
 
 	-- Procompiled header
 	pchheader "pch.h" 		 			-- Specifies the #include form of the precompiled header file name, not the actual file path (https://premake.github.io/docs/pchheader/)
@@ -233,3 +245,46 @@ project (EDITOR_PROJECT_NAME)
 		debugdir (TARGET_DIR)
 		links { "freetype_debug" }
 		links { "SDL2_debug" }
+
+-- Benchmark ----------------------------------------------------------------------------------------------
+project (BENCHMARK_PROJECT_NAME)
+	location (BENCHMARK_DIR)
+	links (RUNTIME_PROJECT_NAME)
+	dependson (RUNTIME_PROJECT_NAME)
+	objdir (OBJ_DIR)
+    cppdialect (CPP_VERSION)
+	kind "ConsoleApp"
+	staticruntime "On"
+	defines{ "SPARTAN_BENCHMARK", API_GRAPHICS }
+    if os.target() == "windows" then
+	    conformancemode "On"
+    end
+
+	-- Files
+	files
+	{
+		BENCHMARK_DIR .. "/**.h",
+		BENCHMARK_DIR .. "/**.cpp"
+	}
+
+	-- Includes
+	includedirs { RUNTIME_DIR }
+	includedirs { RUNTIME_DIR .. "/Core" } -- This is here because the runtime uses it
+	includedirs { "../third_party" }
+
+	-- Libraries
+	libdirs (LIBRARY_DIR)
+
+	-- "Release"
+	filter "configurations:release"
+		targetname ( BENCHMARK_EXECUTABLE )
+		targetdir (TARGET_DIR)
+		debugdir (TARGET_DIR)
+		links { "SDL2" }
+
+	-- "Debug"
+	filter "configurations:debug"
+		targetname ( BENCHMARK_EXECUTABLE .. "_debug" )
+		targetdir (TARGET_DIR)
+		debugdir (TARGET_DIR)
+		links { "SDL2_debug" }
@@ -26,7 +26,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define A_GPU
 #define A_HLSL
 #define SPD_NO_WAVE_OPERATIONS
+#if !DEPTH_MIN
 #define SPD_LINEAR_SAMPLER
+#endif
 
 #include "ffx_a.h"
 
@@ -36,7 +38,11 @@ groupshared AU1 spd_counter;
 AF4 SpdLoadSourceImage(ASU2 p, AU1 slice)
 {
     float2 uv = (p + 0.5f) / g_resolution_rt;
+#if DEPTH_MIN
+    return tex.SampleLevel(sampler_point_clamp, uv, 0);
+#else
     return tex.SampleLevel(sampler_bilinear_clamp, uv, 0);
+#endif
 }
 
 // Load from mip 5
@@ -62,6 +68,11 @@ void SpdStoreIntermediate(AU1 x, AU1 y, AF4 value)
 
 AF4 SpdReduce4(AF4 s1, AF4 s2, AF4 s3, AF4 s4)
 {
+#if DEPTH_MIN
+    // farthest depth (reverse-z), used to build a conservative depth pyramid for occlusion culling
+    return min(min(s1, s2), min(s3, s4));
+#endif
+
     // luminance weighted average
     float s1w = 1 / (luminance(s1) + 1);
     float s2w = 1 / (luminance(s2) + 1);
@@ -83,7 +83,8 @@ cbuffer BufferUber : register(b1)
 
     bool single_texture_roughness_metalness;
     float g_radius;
-    float2 g_padding2;
+    uint g_object_count;
+    float g_padding2;
 
     float4 g_mat_color;
 
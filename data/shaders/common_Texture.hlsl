@@ -73,3 +73,28 @@ RWTexture2D<float4> tex_uav2                               : register(u1);
 RWTexture2D<float4> tex_uav3                               : register(u2);
 globallycoherent RWStructuredBuffer<uint> g_atomic_counter : register(u3);
 globallycoherent RWTexture2D<float4> tex_uav_mips[12]      : register(u4);
+
+// GPU driven rendering - layouts match CullingObject (Culling.h) and RHI_Indirect_DrawIndexed (RHI_Definition.h)
+struct CullingObject
+{
+    matrix transform;
+    float3 aabb_min;
+    uint index_count;
+    float3 aabb_max;
+    uint index_offset;
+    int vertex_offset;
+    uint3 padding;
+};
+
+struct DrawIndexedIndirect
+{
+    uint index_count;
+    uint instance_count;
+    uint first_index;
+    int vertex_offset;
+    uint first_instance;
+};
+
+RWStructuredBuffer<CullingObject> g_culling_objects    : register(u16);
+RWStructuredBuffer<DrawIndexedIndirect> g_draws        : register(u17);
+RWStructuredBuffer<uint> g_draw_count                  : register(u18);
@@ -0,0 +1,153 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========
+#include "common.hlsl"
+//====================
+
+// GPU version of Culling::Cull() (Culling.cpp), both must be kept in sync.
+// Inputs:  g_culling_objects, g_object_count, tex (depth pyramid, reverse-z, min reduced), g_resolution_in (pyramid size), g_mip_count (0 disables occlusion culling)
+// Outputs: g_draws (compacted), g_draw_count
+
+void get_corners(CullingObject object, out float4 corners[8])
+{
+    float3 a = object.aabb_min;
+    float3 b = object.aabb_max;
+
+    corners[0] = float4(a.x, a.y, a.z, 1.0f);
+    corners[1] = float4(b.x, a.y, a.z, 1.0f);
+    corners[2] = float4(a.x, b.y, a.z, 1.0f);
+    corners[3] = float4(b.x, b.y, a.z, 1.0f);
+    corners[4] = float4(a.x, a.y, b.z, 1.0f);
+    corners[5] = float4(b.x, a.y, b.z, 1.0f);
+    corners[6] = float4(a.x, b.y, b.z, 1.0f);
+    corners[7] = float4(b.x, b.y, b.z, 1.0f);
+}
+
+bool is_in_frustum(float4 corners[8])
+{
+    // An object is outside if all of its corners are outside of the same clip plane (reverse-z: near is z = w, far is z = 0)
+    uint outside_left = 0, outside_right = 0, outside_bottom = 0, outside_top = 0, outside_near = 0, outside_far = 0;
+
+    [unroll]
+    for (uint i = 0; i < 8; i++)
+    {
+        float4 clip = mul(corners[i], g_view_projection);
+
+        outside_left   += clip.x < -clip.w ? 1 : 0;
+        outside_right  += clip.x >  clip.w ? 1 : 0;
+        outside_bottom += clip.y < -clip.w ? 1 : 0;
+        outside_top    += clip.y >  clip.w ? 1 : 0;
+        outside_near   += clip.z >  clip.w ? 1 : 0;
+        outside_far    += clip.z <  0.0f   ? 1 : 0;
+    }
+
+    return outside_left != 8 && outside_right != 8 && outside_bottom != 8 && outside_top != 8 && outside_near != 8 && outside_far != 8;
+}
+
+bool is_occluded(float4 corners[8])
+{
+    // Screen space rectangle and nearest depth of the object, as seen by the previous frame
+    float2 uv_min        = 1.0f;
+    float2 uv_max        = 0.0f;
+    float depth_nearest  = 0.0f;
+
+    [unroll]
+    for (uint i = 0; i < 8; i++)
+    {
+        float4 clip = mul(corners[i], g_view_projection_previous);
+
+        // Crossing the near plane, the projection is not reliable, so consider it visible
+        if (clip.w <= 0.0f)
+            return false;
+
+        float3 ndc = clip.xyz / clip.w;
+        float2 uv  = ndc.xy * float2(0.5f, -0.5f) + 0.5f;
+
+        uv_min        = min(uv_min, uv);
+        uv_max        = max(uv_max, uv);
+        depth_nearest = max(depth_nearest, ndc.z); // reverse-z
+    }
+
+    uv_min = saturate(uv_min);
+    uv_max = saturate(uv_max);
+
+    // Pick the mip where the rectangle covers at most 2x2 texels
+    float2 size_pixels = (uv_max - uv_min) * g_resolution_in;
+    float size         = max(max(size_pixels.x, size_pixels.y), 1.0f);
+    uint mip           = min((uint)ceil(log2(size)), g_mip_count - 1);
+
+    // Texels which cover the rectangle, picked from the pixels of the top mip, as texel x of mip n covers pixels [x << n, (x + 1) << n)
+    uint2 size     = uint2(g_resolution_in);
+    uint2 mip_size = max(size >> mip, 1);
+    uint2 xy_min   = min(uint2(floor(uv_min * size)), size - 1);
+    uint2 xy_max   = min(uint2(floor(uv_max * size)), size - 1);
+
+    // A mip is half the size of the one above it, rounded down, so the last row or column of an odd sized mip is not part of
+    // any texel below it, and a side which is down to one texel stops halving. There is no depth to compare against past the
+    // pixels that the mip covers, so consider the object visible.
+    uint2 covered = mip_size << min(mip, firstbithigh(size));
+    if (any(xy_max >= covered))
+        return false;
+
+    xy_min >>= mip;
+    xy_max >>= mip;
+    float depth_farthest = min(
+        min(tex.Load(int3(xy_min.x, xy_min.y, mip)).r, tex.Load(int3(xy_max.x, xy_min.y, mip)).r),
+        min(tex.Load(int3(xy_min.x, xy_max.y, mip)).r, tex.Load(int3(xy_max.x, xy_max.y, mip)).r)
+    );
+
+    // Occluded if even the nearest point of the object is behind everything that was rendered there
+    return depth_nearest < depth_farthest;
+}
+
+[numthreads(64, 1, 1)]
+void mainCS(uint3 thread_id : SV_DispatchThreadID)
+{
+    uint index = thread_id.x;
+    if (index >= g_object_count)
+        return;
+
+    CullingObject object = g_culling_objects[index];
+    if (object.index_count == 0)
+        return;
+
+    float4 corners[8];
+    get_corners(object, corners);
+
+    if (!is_in_frustum(corners))
+        return;
+
+    if (g_mip_count != 0 && is_occluded(corners))
+        return;
+
+    // Append, the instance index is how the vertex shader finds the object's transform
+    uint draw_index;
+    InterlockedAdd(g_draw_count[0], 1, draw_index);
+
+    DrawIndexedIndirect draw;
+    draw.index_count    = object.index_count;
+    draw.instance_count = 1;
+    draw.first_index    = object.index_offset;
+    draw.vertex_offset  = object.vertex_offset;
+    draw.first_instance = index;
+    g_draws[draw_index] = draw;
+}
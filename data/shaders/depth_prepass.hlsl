@@ -23,13 +23,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "common.hlsl"
 //====================
 
+#if INDIRECT
+// Drawn with indirect arguments written by culling.hlsl, the instance index is the object index
+Pixel_PosUv mainVS(Vertex_PosUv input, uint instance_id : SV_InstanceID)
+{
+    matrix transform = g_culling_objects[instance_id].transform;
+#else
 Pixel_PosUv mainVS(Vertex_PosUv input)
 {
+    matrix transform = g_transform;
+#endif
     Pixel_PosUv output;
 
     // position computation has to be an exact match to gbuffer.hlsl
     input.position.w    = 1.0f; 
-    output.position     = mul(input.position, g_transform);
+    output.position     = mul(input.position, transform);
     output.position     = mul(output.position, g_view_projection);
 
     output.uv = input.uv;
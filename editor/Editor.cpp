@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Core/Engine.h"
 #include "Core/Settings.h"
 #include "Core/Window.h"
+#include "Profiling/MemoryTracker.h"
 #include "ImGui/ImGuiExtension.h"
 #include "ImGui/Implementation/ImGui_RHI.h"
 #include "ImGui/Implementation/imgui_impl_sdl.h"
@@ -239,6 +240,8 @@ void Editor::Tick()
 
         if (!Spartan::Window::IsFullScreen())
         {
+            SP_MEMORY_TAG(Editor);
+
             // ImGui - Begin
             ImGui_ImplSDL2_NewFrame();
             ImGui::NewFrame();
@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Core/ThreadPool.h"
 #include "Input/Input.h"
 #include "World/World.h"
+#include "World/WorldStreaming.h"
 #include "World/Components/Camera.h"
 #include "Display/Display.h"
 #include "../WidgetsDeferred/IconProvider.h"
@@ -78,6 +79,35 @@ public:
         });
     }
 
+    static void OpenWorldStreamed(const std::string& file_path)
+    {
+        // Opening a world resets everything so it's important to ensure that no tasks are running
+        Spartan::ThreadPool::Flush(true);
+
+        // The cells around the camera stream in as the world ticks
+        Spartan::ThreadPool::AddTask([file_path]()
+        {
+            Spartan::World::Clear();
+            Spartan::WorldStreaming::Open(file_path);
+        });
+    }
+
+    static void SaveWorldStreamed(const std::string& file_path_in)
+    {
+        // Add the world extension so that the load dialog accepts the file
+        std::string file_path = file_path_in;
+        if (Spartan::FileSystem::GetExtensionFromFilePath(file_path) != Spartan::EXTENSION_WORLD)
+        {
+            file_path += Spartan::EXTENSION_WORLD;
+        }
+
+        // Save the scene asynchronously
+        Spartan::ThreadPool::AddTask([file_path]()
+        {
+            Spartan::WorldStreaming::SaveToFile(file_path);
+        });
+    }
+
     static Editor* editor;
 };
 
@@ -42,6 +42,7 @@ namespace _Widget_MenuBar
     static bool g_showShortcutsWindow = false;
     static bool g_showAboutWindow     = false;
     static bool g_fileDialogVisible   = false;
+    static bool g_fileDialogStreamed  = false; // the world is saved or opened as a streamable world
     static bool imgui_metrics         = false;
     static bool imgui_style           = false;
     static bool imgui_demo            = false;
@@ -91,6 +92,11 @@ void MenuBar::TickAlways()
                 ShowWorldLoadDialog();
             }
 
+            if (ImGui::MenuItem("Load Streamed..."))
+            {
+                ShowWorldLoadDialog(true);
+            }
+
             ImGui::Separator();
 
             if (ImGui::MenuItem("Save", "Ctrl+S"))
@@ -103,6 +109,11 @@ void MenuBar::TickAlways()
                 ShowWorldSaveDialog();
             }
 
+            if (ImGui::MenuItem("Save Streamed..."))
+            {
+                ShowWorldSaveDialog(true);
+            }
+
             ImGui::EndMenu();
         }
 
@@ -172,16 +183,18 @@ void MenuBar::HandleKeyShortcuts() const
     }
 }
 
-void MenuBar::ShowWorldSaveDialog()
+void MenuBar::ShowWorldSaveDialog(const bool streamed /*= false*/)
 {
     m_file_dialog->SetOperation(FileDialog_Op_Save);
-    _Widget_MenuBar::g_fileDialogVisible = true;
+    _Widget_MenuBar::g_fileDialogVisible  = true;
+    _Widget_MenuBar::g_fileDialogStreamed = streamed;
 }
 
-void MenuBar::ShowWorldLoadDialog()
+void MenuBar::ShowWorldLoadDialog(const bool streamed /*= false*/)
 {
     m_file_dialog->SetOperation(FileDialog_Op_Load);
-    _Widget_MenuBar::g_fileDialogVisible = true;
+    _Widget_MenuBar::g_fileDialogVisible  = true;
+    _Widget_MenuBar::g_fileDialogStreamed = streamed;
 }
 
 void MenuBar::DrawFileDialog() const
@@ -199,7 +212,14 @@ void MenuBar::DrawFileDialog() const
             // Scene
             if (Spartan::FileSystem::IsEngineSceneFile(_Widget_MenuBar::g_fileDialogSelection))
             {
-                EditorHelper::LoadWorld(_Widget_MenuBar::g_fileDialogSelection);
+                if (_Widget_MenuBar::g_fileDialogStreamed)
+                {
+                    EditorHelper::OpenWorldStreamed(_Widget_MenuBar::g_fileDialogSelection);
+                }
+                else
+                {
+                    EditorHelper::LoadWorld(_Widget_MenuBar::g_fileDialogSelection);
+                }
                 _Widget_MenuBar::g_fileDialogVisible = false;
             }
         }
@@ -209,7 +229,14 @@ void MenuBar::DrawFileDialog() const
             // Scene
             if (m_file_dialog->GetFilter() == FileDialog_Filter_World)
             {
-                EditorHelper::SaveWorld(_Widget_MenuBar::g_fileDialogSelection);
+                if (_Widget_MenuBar::g_fileDialogStreamed)
+                {
+                    EditorHelper::SaveWorldStreamed(_Widget_MenuBar::g_fileDialogSelection);
+                }
+                else
+                {
+                    EditorHelper::SaveWorld(_Widget_MenuBar::g_fileDialogSelection);
+                }
                 _Widget_MenuBar::g_fileDialogVisible = false;
             }
         }
@@ -37,8 +37,8 @@ public:
     MenuBar(Editor* editor);
 
     void TickAlways() override;
-    void ShowWorldSaveDialog();
-    void ShowWorldLoadDialog();
+    void ShowWorldSaveDialog(bool streamed = false);
+    void ShowWorldLoadDialog(bool streamed = false);
 
     static float GetPadding() { return 8.0f; }
 private:
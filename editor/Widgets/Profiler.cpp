@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Math/Vector2.h"
 #include "../ImGui/ImGuiExtension.h"
 #include "Rendering/Mesh.h"
+#include "World/SystemScheduler.h"
 //==================================
 
 //= NAMESPACES ===============
@@ -68,7 +69,59 @@ static void ShowTimeBlock(const Spartan::TimeBlock& time_block, float total_time
     ImGui::GetWindowDrawList()->AddRectFilled(pos_screen, ImVec2(pos_screen.x + width, pos_screen.y + text_height), IM_COL32(color.x * 255, color.y * 255, color.z * 255, 255));
     // Text
     ImGui::SetCursorPos(ImVec2(pos.x + m_tree_depth_stride * time_block.GetTreeDepth(), pos.y));
-    ImGui::Text("%s - %.2f ms", name, duration);
+    if (const Spartan::TimeBlockHistory* history = Spartan::Profiler::GetTimeBlockHistory(name))
+    {
+        ImGui::Text("%s - %.2f ms (Min:%.2f, Avg:%.2f, Max:%.2f, P99:%.2f)", name, duration, history->min, history->avg, history->max, history->p99);
+    }
+    else
+    {
+        ImGui::Text("%s - %.2f ms", name, duration);
+    }
+}
+
+static void ShowCpuTimeline(const Spartan::CpuTimeline& timeline, const float frame_duration)
+{
+    if (timeline.scopes.empty() || frame_duration <= 0.0f)
+        return;
+
+    uint32_t depth_max = 0;
+    for (const Spartan::CpuScope& scope : timeline.scopes)
+    {
+        depth_max = Spartan::Math::Helper::Max(depth_max, scope.depth);
+    }
+
+    ImGui::Text("%s", timeline.thread_name.c_str());
+
+    const float row_height = ImGui::GetTextLineHeight() + 2.0f;
+    const float width      = ImGui_SP::GetWindowContentRegionWidth();
+    const ImVec2 origin    = ImGui::GetCursorScreenPos();
+    const auto& color      = ImGui::GetStyle().Colors[ImGuiCol_CheckMark];
+    const auto& color_text = ImGui::GetStyle().Colors[ImGuiCol_Text];
+    ImDrawList* draw_list  = ImGui::GetWindowDrawList();
+
+    // Scopes which began in an earlier frame are clamped to the start of this one
+    for (const Spartan::CpuScope& scope : timeline.scopes)
+    {
+        const float start     = Spartan::Math::Helper::Saturate(scope.start / frame_duration);
+        const float end       = Spartan::Math::Helper::Saturate((scope.start + scope.duration) / frame_duration);
+        const ImVec2 rect_min = ImVec2(origin.x + start * width, origin.y + scope.depth * row_height);
+        const ImVec2 rect_max = ImVec2(Spartan::Math::Helper::Max(origin.x + end * width, rect_min.x + 1.0f), rect_min.y + row_height - 1.0f);
+
+        draw_list->AddRectFilled(rect_min, rect_max, IM_COL32(color.x * 255, color.y * 255, color.z * 255, 255 - Spartan::Math::Helper::Min(scope.depth * 25u, 150u)));
+
+        // Name, if it fits
+        if (ImGui::CalcTextSize(scope.name).x < rect_max.x - rect_min.x)
+        {
+            draw_list->AddText(rect_min, IM_COL32(color_text.x * 255, color_text.y * 255, color_text.z * 255, 255), scope.name);
+        }
+
+        if (ImGui::IsMouseHoveringRect(rect_min, rect_max))
+        {
+            ImGui::SetTooltip("%s - %.3f ms", scope.name, scope.duration);
+        }
+    }
+
+    ImGui::Dummy(ImVec2(width, row_height * (depth_max + 1)));
 }
 
 void Profiler::TickVisible()
@@ -82,6 +135,21 @@ void Profiler::TickVisible()
     float interval = Spartan::Profiler::GetUpdateInterval();
     ImGui::DragFloat("Update interval (The smaller the interval the higher the performance impact)", &interval, 0.001f, 0.0f, 0.5f);
     Spartan::Profiler::SetUpdateInterval(interval);
+    ImGui::SameLine();
+    if (Spartan::Profiler::IsCapturing())
+    {
+        ImGui::TextUnformatted("Capturing...");
+    }
+    else if (ImGui::Button("Capture 60 frames"))
+    {
+        Spartan::Profiler::StartCapture(60);
+    }
+    ImGui::SameLine();
+    bool hitch_detection = Spartan::Profiler::GetHitchDetection();
+    if (ImGui::Checkbox("Hitch detection", &hitch_detection))
+    {
+        Spartan::Profiler::SetHitchDetection(hitch_detection);
+    }
     ImGui::Separator();
 
     Spartan::TimeBlockType type                        = m_item_type == 0 ? Spartan::TimeBlockType::Cpu : Spartan::TimeBlockType::Gpu;
@@ -89,16 +157,34 @@ void Profiler::TickVisible()
     const uint32_t time_block_count                    = static_cast<uint32_t>(time_blocks.size());
     float time_last                                    = type == Spartan::TimeBlockType::Cpu ? Spartan::Profiler::GetTimeCpuLast() : Spartan::Profiler::GetTimeGpuLast();
 
-    // Time blocks
-    for (uint32_t i = 0; i < time_block_count; i++)
+    // CPU, a timeline per thread, so that it's visible how jobs overlap
+    if (type == Spartan::TimeBlockType::Cpu)
+    {
+        const float frame_duration = Spartan::Profiler::GetCpuTimelineDuration();
+        for (const Spartan::CpuTimeline& timeline : Spartan::Profiler::GetCpuTimelines())
+        {
+            ShowCpuTimeline(timeline, frame_duration);
+        }
+
+        // How the world's systems were grouped into waves, along with their timings
+        if (ImGui::CollapsingHeader("Systems"))
+        {
+            ImGui::TextUnformatted(Spartan::SystemScheduler::GetSchedule().c_str());
+        }
+    }
+    // GPU, time blocks
+    else
     {
-        if (time_blocks[i].GetType() != type)
-            continue;
+        for (uint32_t i = 0; i < time_block_count; i++)
+        {
+            if (time_blocks[i].GetType() != type)
+                continue;
 
-        if (!time_blocks[i].IsComplete())
-            return;
+            if (!time_blocks[i].IsComplete())
+                return;
 
-        ShowTimeBlock(time_blocks[i], time_last);
+            ShowTimeBlock(time_blocks[i], time_last);
+        }
     }
 
     // Plot
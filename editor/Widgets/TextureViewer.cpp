@@ -81,18 +81,14 @@ void TextureViewer::TickAlways()
 
 void TextureViewer::TickVisible()
 {
-    // Get render targets
+    // Get render targets, transient ones are allocated by the render graph on demand, so they can come and go
     static vector<string> render_target_options;
-    if (render_target_options.empty())
+    render_target_options.clear();
+    render_target_options.emplace_back("None");
+    for (uint32_t i = 1; i < static_cast<uint32_t>(Renderer::GetRenderTargets().size()); i++)
     {
-        render_target_options.emplace_back("None");
-        for (const shared_ptr<RHI_Texture>& render_target : Renderer::GetRenderTargets())
-        {
-            if (render_target)
-            {
-                render_target_options.emplace_back(render_target->GetName());
-            }
-        }
+        const shared_ptr<RHI_Texture>& render_target = Renderer::GetRenderTargets()[i];
+        render_target_options.emplace_back(render_target ? render_target->GetName() : "Unused");
     }
 
     // Display them in a combo box.
@@ -19,16 +19,57 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+//= INCLUDES =================
 #include "Editor.h"
+#include "Profiling/Profiler.h"
+#include <cstdlib>
+#include <cstring>
+//============================
+
+// --profiler-capture <frame count> [file path]
+// --hitch-detection [threshold ms]
+static void parse_profiler_arguments(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--profiler-capture") == 0 && i + 1 < argc)
+        {
+            const uint32_t frame_count = static_cast<uint32_t>(atoi(argv[i + 1]));
+            if (i + 2 < argc && argv[i + 2][0] != '-')
+            {
+                Spartan::Profiler::StartCapture(frame_count, argv[i + 2]);
+            }
+            else
+            {
+                Spartan::Profiler::StartCapture(frame_count);
+            }
+        }
+        else if (strcmp(argv[i], "--hitch-detection") == 0)
+        {
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                Spartan::Profiler::SetHitchDetection(true, static_cast<float>(atof(argv[i + 1])));
+            }
+            else
+            {
+                Spartan::Profiler::SetHitchDetection(true);
+            }
+        }
+    }
+}
 
 #ifdef _MSC_VER // Windows
 #include <Windows.h>
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
+{
+    int argc    = __argc;
+    char** argv = __argv;
 #else // Linux
 int main(int argc, char** argv)
-#endif
 {
+#endif
     Editor editor;
+    parse_profiler_arguments(argc, argv);
     editor.Tick();
     return 0;
 }
@@ -92,6 +92,7 @@ if (!(##expression))                  \
 {                                     \
     Spartan::Log::SetLogToFile(true); \
     SP_LOG_ERROR(#expression);        \
+    Spartan::Log::Flush();            \
     SP_DEBUG_BREAK();                 \
 }
 #endif
@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "Window.h"
 #include "ThreadPool.h"
+#include "EventBus.h"
+#include "FrameAllocator.h"
 #include "../Audio/Audio.h"
 #include "../Input/Input.h"
 #include "../Physics/Physics.h"
@@ -75,16 +77,19 @@ namespace Spartan
         ResourceCache::Clear();
         ThreadPool::Shutdown();
         Event::Shutdown();
+        EventBus::Shutdown();
         Settings::Shutdown();
         Audio::Shutdown();
         Profiler::Shutdown();
         Window::Shutdown();
+        Log::Flush();
     }
 
     void Engine::Tick()
     {
         // Pre-tick
         Profiler::PreTick();
+        EventBus::PreTick();
         World::PreTick();
 
         // Tick
@@ -94,11 +99,13 @@ namespace Spartan
         Physics::Tick();
         Audio::Tick();
         World::Tick();
+        EventBus::Dispatch(); // once per frame, delivers what was queued (the world included) before the renderer ticks
         Renderer::Tick();
 
         // Post-tick
         Input::PostTick();
         Profiler::PostTick();
+        FrameAllocator::Tick(); // last, anything allocated from the frame allocator is invalid after this
     }
 
     void Engine::SetFlag(const EngineMode flag)
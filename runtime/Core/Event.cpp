@@ -30,7 +30,7 @@ using namespace std;
 
 namespace Spartan
 {
-    static std::array<std::vector<subscriber>, 12> event_subscribers;
+    static std::array<std::vector<subscriber>, static_cast<uint32_t>(EventType::Max)> event_subscribers;
 
     void Event::Shutdown()
     {
@@ -34,7 +34,7 @@ To unsubscribe a function from an event -> SP_SUBSCRIBE_TO_EVENT(EVENT_ID, Handl
 To fire an event                        -> SP_FIRE_EVENT(EVENT_ID);
 To fire an event with data              -> SP_FIRE_EVENT_DATA(EVENT_ID, Variant);
 
-Note: This is a blocking event system
+Note: This is a blocking event system, for typed, queued or thread pool dispatched events see EventBus.h
 ====================================================================================
 */
 
@@ -66,12 +66,14 @@ enum class EventType
     WorldLoadStart,               // The world is about to be loaded from a file
     WorldLoadEnd,                 // The world finished loading from file
     WorldClear,                   // The world is about to clear everything
-    WorldResolve,                 // The world is resolving
-    WorldResolved,                // The world has finished resolving
+    WorldResolve,                 // The world is resolving (an entity as data means only that entity changed)
+    WorldResolved,                // The world has finished resolving (the entities are sent through EventChannel<WorldResolvedEvent>)
     // SDL                        
     EventSDL,                     // An SDL event
     // Window
-    WindowOnFullScreenToggled
+    WindowOnFullScreenToggled,
+    // Count
+    Max
 };
 
 namespace Spartan
@@ -0,0 +1,119 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "pch.h"
+#include "EventBus.h"
+#include "../Profiling/Profiler.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        struct Channel
+        {
+            uint32_t (*dispatch)() = nullptr;
+            void (*clear)()        = nullptr;
+        };
+
+        mutex channels_mutex;
+        vector<Channel> channels;
+        atomic<EventToken> token_next = 1;
+        atomic<uint32_t> event_count  = 0;
+        atomic<uint32_t> queued_count = 0; // Events queued since the last dispatch
+        uint32_t event_count_last     = 0;
+    }
+
+    void EventBus::Shutdown()
+    {
+        lock_guard lock(channels_mutex);
+
+        for (const Channel& channel : channels)
+        {
+            channel.clear();
+        }
+    }
+
+    void EventBus::PreTick()
+    {
+        event_count_last = event_count.exchange(0);
+    }
+
+    void EventBus::Dispatch()
+    {
+        // Most frames nothing is queued, so don't touch the channels
+        if (queued_count.load(memory_order_relaxed) == 0 || queued_count.exchange(0, memory_order_acquire) == 0)
+            return;
+
+        SP_PROFILE_FUNCTION();
+
+        // Copy the channels, so handlers can queue events on (or subscribe to) channels which haven't been used yet
+        vector<Channel> channels_to_dispatch;
+        {
+            lock_guard lock(channels_mutex);
+            channels_to_dispatch = channels;
+        }
+
+        uint32_t count = 0;
+        for (const Channel& channel : channels_to_dispatch)
+        {
+            count += channel.dispatch();
+        }
+
+        CountEvents(count);
+    }
+
+    uint32_t EventBus::GetEventCount()
+    {
+        return event_count.load(memory_order_relaxed);
+    }
+
+    uint32_t EventBus::GetEventCountLast()
+    {
+        return event_count_last;
+    }
+
+    void EventBus::RegisterChannel(uint32_t (*dispatch)(), void (*clear)())
+    {
+        lock_guard lock(channels_mutex);
+        channels.push_back({ dispatch, clear });
+    }
+
+    EventToken EventBus::GenerateToken()
+    {
+        return token_next.fetch_add(1, memory_order_relaxed);
+    }
+
+    void EventBus::CountEvents(const uint32_t count)
+    {
+        event_count.fetch_add(count, memory_order_relaxed);
+    }
+
+    void EventBus::CountQueued()
+    {
+        queued_count.fetch_add(1, memory_order_release);
+    }
+}
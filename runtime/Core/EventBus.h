@@ -0,0 +1,232 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ============
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include "Definitions.h"
+#include "ThreadPool.h"
+//=======================
+
+/*
+HOW TO USE
+=============================================================================================================
+Any type can be an event, the type itself is the channel, so there is no id to register.
+
+To subscribe    -> EventToken token = EventChannel<MyEvent>::Subscribe([](const MyEvent& e) { ... });
+To unsubscribe  -> EventChannel<MyEvent>::Unsubscribe(token);
+To fire         -> EventChannel<MyEvent>::Fire(MyEvent{ ... });  // blocking, runs every handler right away
+To queue        -> EventChannel<MyEvent>::Queue(MyEvent{ ... }); // non-blocking, runs on the next EventBus::Dispatch()
+
+Notes:
+- Fire() only borrows the payload, so it can carry spans which point into storage owned by the sender.
+- Queue() takes ownership of the payload (move-only types are fine), so never queue a span.
+- Queue() can be called from any thread, it takes a short lock and doesn't allocate once the channel's queue has grown.
+- Queued events are dispatched once per frame, between World::Tick() and Renderer::Tick().
+- Handlers subscribed with EventDispatch::ThreadPool run as thread pool tasks when a queued event is
+  dispatched, they must be thread safe. When fired, they run on the caller's thread like any other handler.
+=============================================================================================================
+*/
+
+namespace Spartan
+{
+    // Identifies a subscription, zero is never a valid token
+    using EventToken = uint64_t;
+
+    enum class EventDispatch
+    {
+        Caller,    // The handler runs on the thread which fires or dispatches the event
+        ThreadPool // The handler runs as a thread pool task when a queued event is dispatched
+    };
+
+    class SP_CLASS EventBus
+    {
+    public:
+        static void Shutdown();
+
+        // Resets the per-frame stats
+        static void PreTick();
+
+        // Dispatches every queued event, of every channel, in the order it was queued (per channel), returns right away if nothing was queued
+        static void Dispatch();
+
+        // Stats
+        static uint32_t GetEventCount();      // Events fired and dispatched so far this frame
+        static uint32_t GetEventCountLast();  // Events fired and dispatched during the previous frame
+
+        // Used by EventChannel
+        static void RegisterChannel(uint32_t (*dispatch)(), void (*clear)());
+        static EventToken GenerateToken();
+        static void CountEvents(const uint32_t count);
+        static void CountQueued();
+    };
+
+    template<class T>
+    class EventChannel
+    {
+    public:
+        using Handler = std::function<void(const T&)>;
+
+        static EventToken Subscribe(Handler&& handler, const EventDispatch dispatch = EventDispatch::Caller)
+        {
+            Register();
+            const EventToken token = EventBus::GenerateToken();
+
+            // Copy on write, so that firing never has to hold the lock while handlers run
+            std::lock_guard lock(m_mutex);
+            auto subscribers = m_subscribers ? std::make_shared<std::vector<Subscriber>>(*m_subscribers) : std::make_shared<std::vector<Subscriber>>();
+            subscribers->push_back({ std::move(handler), dispatch, token });
+            m_subscribers = std::move(subscribers);
+
+            return token;
+        }
+
+        // A handler which is running on another thread while this is called, will finish running
+        static void Unsubscribe(const EventToken token)
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_subscribers)
+                return;
+
+            auto subscribers = std::make_shared<std::vector<Subscriber>>(*m_subscribers);
+            subscribers->erase(std::remove_if(subscribers->begin(), subscribers->end(), [token](const Subscriber& subscriber) { return subscriber.token == token; }), subscribers->end());
+            m_subscribers = std::move(subscribers);
+        }
+
+        static void Fire(const T& payload)
+        {
+            if (std::shared_ptr<const std::vector<Subscriber>> subscribers = GetSubscribers())
+            {
+                for (const Subscriber& subscriber : *subscribers)
+                {
+                    subscriber.handler(payload);
+                }
+            }
+
+            EventBus::CountEvents(1);
+        }
+
+        static void Queue(T&& payload)
+        {
+            Register();
+
+            {
+                std::lock_guard lock(m_queue_mutex);
+                m_queue.emplace_back(std::move(payload));
+            }
+
+            EventBus::CountQueued();
+        }
+
+    private:
+        struct Subscriber
+        {
+            Handler handler;
+            EventDispatch dispatch;
+            EventToken token;
+        };
+
+        static void Register()
+        {
+            std::call_once(m_registered, []() { EventBus::RegisterChannel(&Dispatch, &Clear); });
+        }
+
+        static std::shared_ptr<const std::vector<Subscriber>> GetSubscribers()
+        {
+            std::lock_guard lock(m_mutex);
+            return m_subscribers;
+        }
+
+        static uint32_t Dispatch()
+        {
+            // Take everything that's queued, handlers can queue more while this runs, that goes to the next dispatch
+            std::vector<T> queued;
+            {
+                std::lock_guard lock(m_queue_mutex);
+                queued.swap(m_queue);
+            }
+
+            if (queued.empty())
+                return 0;
+
+            std::shared_ptr<const std::vector<Subscriber>> subscribers = GetSubscribers();
+            const bool has_tasks = subscribers && std::any_of(subscribers->begin(), subscribers->end(), [](const Subscriber& subscriber) { return subscriber.dispatch == EventDispatch::ThreadPool; });
+
+            if (subscribers)
+            {
+                for (T& queued_payload : queued)
+                {
+                    // Tasks can outlive this function, so they share ownership of the payload
+                    std::shared_ptr<T> payload_shared = has_tasks ? std::make_shared<T>(std::move(queued_payload)) : nullptr;
+                    const T& payload                  = has_tasks ? *payload_shared : queued_payload;
+
+                    for (const Subscriber& subscriber : *subscribers)
+                    {
+                        if (subscriber.dispatch == EventDispatch::ThreadPool)
+                        {
+                            ThreadPool::AddTask([handler = subscriber.handler, payload_shared]() { handler(*payload_shared); });
+                        }
+                        else
+                        {
+                            subscriber.handler(payload);
+                        }
+                    }
+                }
+            }
+
+            // Hand the storage back, so that queuing doesn't allocate once the queue has grown
+            const uint32_t count = static_cast<uint32_t>(queued.size());
+            queued.clear();
+            {
+                std::lock_guard lock(m_queue_mutex);
+                if (m_queue.empty())
+                {
+                    m_queue.swap(queued);
+                }
+            }
+
+            return count;
+        }
+
+        static void Clear()
+        {
+            {
+                std::lock_guard lock(m_queue_mutex);
+                m_queue = std::vector<T>();
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_subscribers = nullptr;
+        }
+
+        static inline std::once_flag m_registered;
+        static inline std::mutex m_mutex;
+        static inline std::shared_ptr<const std::vector<Subscriber>> m_subscribers;
+        static inline std::mutex m_queue_mutex;
+        static inline std::vector<T> m_queue;
+    };
+}
@@ -0,0 +1,240 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "pch.h"
+#include "FrameAllocator.h"
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        static constexpr size_t k_block_size_min       = 256 * 1024;
+        static constexpr uint64_t k_frames_blocked_max = 60; // Frames an arena can go without rewinding before it's reported
+
+        static atomic<uint64_t> m_frame           = 0;
+        static uint64_t m_bytes_allocated_frame   = 0;
+        static uint64_t m_bytes_capacity          = 0;
+
+        class FrameArena : public pmr::memory_resource
+        {
+        public:
+            ~FrameArena()
+            {
+                for (Block& block : m_blocks)
+                {
+                    ::operator delete(block.data);
+                }
+            }
+
+            atomic<uint64_t> bytes_allocated = 0; // Since the last tick, exchanged by the tick
+            atomic<uint64_t> bytes_capacity  = 0;
+
+        private:
+            struct Block
+            {
+                uint8_t* data = nullptr;
+                size_t size   = 0;
+            };
+
+            void* do_allocate(const size_t size, const size_t alignment) override
+            {
+                // Rewind once per frame, unless something from an earlier frame is still alive
+                const uint64_t frame = m_frame.load(memory_order_relaxed);
+                if (m_frame_current != frame)
+                {
+                    m_frame_current = frame;
+                    m_bytes_frame   = 0;
+                }
+
+                if (m_frame_rewound != frame)
+                {
+                    if (m_allocations_live.load(memory_order_acquire) == 0)
+                    {
+                        Rewind();
+                        m_frame_rewound = frame;
+                        m_blocked       = false;
+                    }
+                    else if (!m_blocked && frame - m_frame_rewound > k_frames_blocked_max)
+                    {
+                        // Every allocation since the last rewind is still in the blocks, so they keep growing
+                        SP_LOG_WARNING("A frame allocation has been alive for %llu frames, the arena can't rewind and has grown to %llu KiB. Frame allocations must not outlive the frame.",
+                            static_cast<unsigned long long>(frame - m_frame_rewound), static_cast<unsigned long long>(bytes_capacity.load(memory_order_relaxed) / 1024));
+                        m_blocked = true;
+                    }
+                }
+
+                void* memory = Bump(size, alignment);
+                if (!memory)
+                {
+                    Grow(size + alignment);
+                    memory = Bump(size, alignment);
+                }
+                SP_ASSERT(memory != nullptr);
+
+                m_allocations_live.fetch_add(1, memory_order_relaxed);
+                bytes_allocated.fetch_add(size, memory_order_relaxed);
+
+                return memory;
+            }
+
+            void do_deallocate(void* /*memory*/, const size_t /*size*/, const size_t /*alignment*/) override
+            {
+                // Nothing to free, the memory is reclaimed when the arena rewinds.
+                // A container can be destroyed by a thread other than the one which allocated it, hence the atomic.
+                const uint64_t allocations_live = m_allocations_live.fetch_sub(1, memory_order_release);
+                SP_ASSERT(allocations_live != 0);
+            }
+
+            bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            void* Bump(const size_t size, const size_t alignment)
+            {
+                if (m_blocks.empty())
+                    return nullptr;
+
+                Block& block          = m_blocks.back();
+                const uintptr_t start = reinterpret_cast<uintptr_t>(block.data) + m_offset;
+                const uintptr_t align = (start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+                const size_t offset   = m_offset + static_cast<size_t>(align - start);
+                if (offset + size > block.size)
+                    return nullptr;
+
+                // Including the padding, so that a block sized from it fits the frame
+                m_bytes_frame      += offset + size - m_offset;
+                m_bytes_frame_peak  = max(m_bytes_frame_peak, m_bytes_frame);
+                m_offset            = offset + size;
+
+                return block.data + offset;
+            }
+
+            void Grow(const size_t size)
+            {
+                Block block;
+                block.size = max(k_block_size_min, size);
+                block.data = static_cast<uint8_t*>(::operator new(block.size));
+                m_blocks.emplace_back(block);
+                m_offset   = 0;
+
+                bytes_capacity.fetch_add(block.size, memory_order_relaxed);
+            }
+
+            void Rewind()
+            {
+                // The frames since the last rewind spilled into more blocks, replace them with one that fits the largest of them.
+                // Not all of them together, those only added up because something blocked the rewinds in between.
+                if (m_blocks.size() > 1)
+                {
+                    size_t size = k_block_size_min;
+                    while (size < m_bytes_frame_peak)
+                    {
+                        size *= 2;
+                    }
+
+                    for (Block& block : m_blocks)
+                    {
+                        ::operator delete(block.data);
+                    }
+                    m_blocks.clear();
+                    bytes_capacity.store(0, memory_order_relaxed);
+
+                    Grow(size);
+                }
+
+                m_offset           = 0;
+                m_bytes_frame      = 0;
+                m_bytes_frame_peak = 0;
+            }
+
+            vector<Block> m_blocks;
+            size_t m_offset                     = 0; // Into the last block
+            size_t m_bytes_frame                = 0; // Since the frame started, with padding
+            size_t m_bytes_frame_peak           = 0; // Of the frames since the last rewind
+            atomic<uint64_t> m_allocations_live = 0;
+            uint64_t m_frame_current            = 0;
+            uint64_t m_frame_rewound            = 0;
+            bool m_blocked                      = false; // Reported, until it rewinds again
+        };
+
+        // Arenas of the threads that are alive, for the stats
+        static mutex m_arenas_mutex;
+        static vector<FrameArena*> m_arenas;
+
+        struct ArenaRegistration
+        {
+            ArenaRegistration()
+            {
+                lock_guard<mutex> lock(m_arenas_mutex);
+                m_arenas.emplace_back(&arena);
+            }
+
+            ~ArenaRegistration()
+            {
+                lock_guard<mutex> lock(m_arenas_mutex);
+                m_arenas.erase(remove(m_arenas.begin(), m_arenas.end(), &arena), m_arenas.end());
+            }
+
+            FrameArena arena;
+        };
+
+        static thread_local ArenaRegistration m_arena_local;
+    }
+
+    void FrameAllocator::Tick()
+    {
+        {
+            lock_guard<mutex> lock(m_arenas_mutex);
+
+            m_bytes_allocated_frame = 0;
+            m_bytes_capacity        = 0;
+            for (FrameArena* arena : m_arenas)
+            {
+                m_bytes_allocated_frame += arena->bytes_allocated.exchange(0, memory_order_relaxed);
+                m_bytes_capacity        += arena->bytes_capacity.load(memory_order_relaxed);
+            }
+        }
+
+        m_frame.fetch_add(1, memory_order_relaxed);
+    }
+
+    pmr::memory_resource* FrameAllocator::GetResource()
+    {
+        return &m_arena_local.arena;
+    }
+
+    uint64_t FrameAllocator::GetBytesAllocatedFrame()
+    {
+        return m_bytes_allocated_frame;
+    }
+
+    uint64_t FrameAllocator::GetBytesCapacity()
+    {
+        return m_bytes_capacity;
+    }
+}
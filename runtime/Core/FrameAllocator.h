@@ -0,0 +1,57 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+#include <memory_resource>
+#include <vector>
+//======================
+
+namespace Spartan
+{
+    // Bump allocator for data which doesn't outlive the frame (scratch containers in the renderer, cascades, picking etc.).
+    // Every thread has its own arena, so allocating is a pointer increment and needs no locks. When the frame ends, the
+    // arena of each thread is rewound the next time that thread allocates, provided nothing it handed out is still alive.
+    // If a frame didn't fit, the arena grows to a single block which does, so a steady state never touches the heap.
+    // Anything that outlives its frame keeps the arena from rewinding, so it grows every frame, that gets logged after a while.
+    class SP_CLASS FrameAllocator
+    {
+    public:
+        // Ends the frame, the engine calls it once per frame
+        static void Tick();
+
+        // The arena of the calling thread
+        static std::pmr::memory_resource* GetResource();
+
+        // Stats, as of the last tick
+        static uint64_t GetBytesAllocatedFrame(); // All threads
+        static uint64_t GetBytesCapacity();       // All threads
+    };
+
+    // A vector which allocates from the arena of the calling thread
+    template<typename T>
+    std::pmr::vector<T> frame_vector()
+    {
+        return std::pmr::vector<T>(FrameAllocator::GetResource());
+    }
+}
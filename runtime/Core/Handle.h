@@ -0,0 +1,180 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <array>
+#include "Definitions.h"
+//======================
+
+namespace Spartan
+{
+    // A 32 bit reference to an object which lives in a HandlePool, the low bits index a slot and the high
+    // bits hold the generation of that slot. Releasing a slot bumps its generation, so a handle which outlived
+    // its object resolves to null (in O(1)) instead of dangling. A value of zero is the null handle.
+    template<class T>
+    class Handle
+    {
+    public:
+        static constexpr uint32_t index_bits      = 20;
+        static constexpr uint32_t generation_bits = 32 - index_bits;
+        static constexpr uint32_t index_mask      = (1u << index_bits) - 1;
+        static constexpr uint32_t generation_mask = (1u << generation_bits) - 1;
+
+        Handle() = default;
+        Handle(const uint32_t index, const uint32_t generation) : m_value((generation << index_bits) | index) {}
+
+        uint32_t GetIndex()      const { return m_value & index_mask; }
+        uint32_t GetGeneration() const { return m_value >> index_bits; }
+        uint32_t GetValue()      const { return m_value; }
+        bool IsNull()            const { return m_value == 0; }
+
+        bool operator==(const Handle& rhs) const { return m_value == rhs.m_value; }
+        bool operator!=(const Handle& rhs) const { return m_value != rhs.m_value; }
+
+    private:
+        uint32_t m_value = 0;
+    };
+
+    // Hands out handles to objects it doesn't own. Slots live in fixed size chunks which never move,
+    // so Get() is lock free and can be called from any thread, adding and removing takes a lock.
+    // Released slots are reused first in first out, and only once enough of them are free, so a slot goes through its
+    // generations as slowly as possible. A slot whose generation would wrap is retired, a stale handle can never match again.
+    template<class T>
+    class HandlePool
+    {
+    public:
+        HandlePool() { m_chunks.fill(nullptr); }
+        ~HandlePool()
+        {
+            for (Slot* chunk : m_chunks)
+            {
+                delete[] chunk;
+            }
+        }
+
+        Handle<T> Add(T* object)
+        {
+            SP_ASSERT(object != nullptr);
+
+            std::lock_guard lock(m_mutex);
+
+            uint32_t index = 0;
+            if (m_free.size() > free_min)
+            {
+                index = m_free.front();
+                m_free.pop_front();
+            }
+            else
+            {
+                index = m_slot_count;
+                SP_ASSERT_MSG(index <= Handle<T>::index_mask, "Out of handles");
+
+                if (index % chunk_size == 0)
+                {
+                    m_chunks[index / chunk_size] = new Slot[chunk_size];
+                }
+
+                m_slot_count = index + 1;
+            }
+
+            Slot& slot = GetSlot(index);
+            slot.object.store(object);
+            return Handle<T>(index, slot.generation.load());
+        }
+
+        void Remove(const Handle<T> handle)
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (!IsValid(handle))
+                return;
+
+            Release(handle.GetIndex());
+        }
+
+        // Invalidates every handle which has been handed out
+        void Clear()
+        {
+            std::lock_guard lock(m_mutex);
+
+            for (uint32_t index = 0; index < m_slot_count; index++)
+            {
+                if (GetSlot(index).object.load() != nullptr)
+                {
+                    Release(index);
+                }
+            }
+        }
+
+        T* Get(const Handle<T> handle) const
+        {
+            if (handle.IsNull() || handle.GetIndex() >= m_slot_count.load())
+                return nullptr;
+
+            // Read the generation on both sides of the object, so a slot which is recycled in between isn't trusted
+            const Slot& slot = GetSlot(handle.GetIndex());
+            if (slot.generation.load() != handle.GetGeneration())
+                return nullptr;
+
+            T* object = slot.object.load();
+            return slot.generation.load() == handle.GetGeneration() ? object : nullptr;
+        }
+
+        bool IsValid(const Handle<T> handle) const { return Get(handle) != nullptr; }
+
+    private:
+        static constexpr uint32_t chunk_size  = 4096;
+        static constexpr uint32_t chunk_count = (Handle<T>::index_mask + 1) / chunk_size;
+        static constexpr uint32_t free_min    = 1024; // released slots wait for this many others before they are reused
+
+        struct Slot
+        {
+            std::atomic<T*> object           = nullptr;
+            std::atomic<uint32_t> generation = 1; // zero is reserved for null handles and retired slots
+        };
+
+        Slot& GetSlot(const uint32_t index) const { return m_chunks[index / chunk_size][index % chunk_size]; }
+
+        void Release(const uint32_t index)
+        {
+            Slot& slot = GetSlot(index);
+            slot.object.store(nullptr);
+
+            // Once every generation has been handed out the slot is never used again
+            const uint32_t generation = (slot.generation.load() + 1) & Handle<T>::generation_mask;
+            slot.generation.store(generation);
+            if (generation != 0)
+            {
+                m_free.emplace_back(index);
+            }
+        }
+
+        std::array<Slot*, chunk_count> m_chunks;
+        std::atomic<uint32_t> m_slot_count = 0;
+        std::deque<uint32_t> m_free;
+        std::mutex m_mutex;
+    };
+}
@@ -24,12 +24,25 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Object.h"
 //=================
 
+//= NAMESPACES =====
+using namespace std;
+//==================
+
 namespace Spartan
 {
-    uint64_t g_id = 0;
+    atomic<uint64_t> g_id = 0;
 
     Object::Object()
     {
         m_object_id = GenerateObjectId();
     }
+
+    void Object::SetObjectId(const uint64_t id)
+    {
+        m_object_id = id;
+
+        // Ids which come from elsewhere (e.g. a file) move the counter past them, so generated ids don't collide with them
+        uint64_t id_current = g_id.load(memory_order_relaxed);
+        while (id_current < id && !g_id.compare_exchange_weak(id_current, id, memory_order_relaxed)) {}
+    }
 }
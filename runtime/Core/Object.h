@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===========
 #include <string>
+#include <atomic>
 #include "Definitions.h"
 //======================
 
@@ -33,21 +34,22 @@ namespace Spartan
     //========================
     
     // Globals
-    extern uint64_t g_id;
+    extern std::atomic<uint64_t> g_id;
 
     class SP_CLASS Object
     {
     public:
         Object();
+        virtual ~Object() = default;
         
-        // Name
-        const std::string& GetName()    const { return m_name; }
-        void SetName(const std::string& name) { m_name = name; }
+        // Name, virtual so that derived classes which are indexed by name (e.g. entities) can keep their index in sync
+        const std::string& GetName()            const { return m_name; }
+        virtual void SetName(const std::string& name) { m_name = name; }
 
-        // Id
+        // Id, virtual for the same reason
         const uint64_t GetObjectId()        const { return m_object_id; }
-        void SetObjectId(const uint64_t id)       { m_object_id = id; }
-        static uint64_t GenerateObjectId()        { return ++g_id; }
+        virtual void SetObjectId(const uint64_t id);
+        static uint64_t GenerateObjectId()        { return g_id.fetch_add(1, std::memory_order_relaxed) + 1; }
 
         // CPU & GPU sizes
         const uint64_t GetObjectSizeCpu() const { return m_object_size_cpu; }
@@ -0,0 +1,154 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+//======================
+
+namespace Spartan
+{
+    // Fixed size blocks for objects of type T, carved out of slabs. Freed blocks go to a free list and are reused first,
+    // so allocating and freeing are O(1), nothing fragments and objects of the same type end up next to each other.
+    // Slabs are never released, a pool stays at the peak number of objects which were alive at once.
+    template<typename T>
+    class FixedSizePool
+    {
+    public:
+        static FixedSizePool& Get()
+        {
+            // Never destroyed, objects can still be freed during static destruction (e.g. when the world releases its entities)
+            static FixedSizePool* pool = new FixedSizePool();
+            return *pool;
+        }
+
+        void* Allocate()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_free)
+            {
+                Grow();
+            }
+
+            Block* block = m_free;
+            m_free       = block->next;
+            m_live_count++;
+
+            return block;
+        }
+
+        void Free(void* memory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            Block* block = static_cast<Block*>(memory);
+            block->next  = m_free;
+            m_free       = block;
+            m_live_count--;
+        }
+
+        uint32_t GetLiveCount() const { return m_live_count; }
+        uint32_t GetCapacity() const  { return m_capacity; }
+
+    private:
+        union Block
+        {
+            Block* next;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        static constexpr uint32_t m_slab_size   = 64 * 1024;
+        static constexpr uint32_t m_slab_blocks = std::max<uint32_t>(m_slab_size / sizeof(Block), 16);
+
+        FixedSizePool() = default;
+
+        void Grow()
+        {
+            Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * m_slab_blocks, std::align_val_t(alignof(Block))));
+
+            // Linked in address order, so that objects which are created one after the other are adjacent
+            for (uint32_t i = m_slab_blocks; i-- > 0;)
+            {
+                slab[i].next = m_free;
+                m_free       = &slab[i];
+            }
+
+            m_capacity += m_slab_blocks;
+        }
+
+        std::mutex m_mutex;
+        Block* m_free         = nullptr;
+        uint32_t m_live_count = 0;
+        uint32_t m_capacity   = 0;
+    };
+
+    // Standard allocator on top of the pools. std::allocate_shared() rebinds it to a type which holds both
+    // the object and its control block, so every type which is created through it gets a pool of its own.
+    // Building with SP_POOL_ALLOCATOR_DISABLED allocates every object on its own instead, like std::make_shared().
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+    #if defined(SP_POOL_ALLOCATOR_DISABLED)
+        static constexpr bool pooled = false;
+    #else
+        static constexpr bool pooled = true;
+    #endif
+
+        PoolAllocator() = default;
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) {}
+
+        T* allocate(const size_t count)
+        {
+            if (pooled && count == 1)
+                return static_cast<T*>(FixedSizePool<T>::Get().Allocate());
+
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T* memory, const size_t count)
+        {
+            if (pooled && count == 1)
+            {
+                FixedSizePool<T>::Get().Free(memory);
+                return;
+            }
+
+            ::operator delete(memory, std::align_val_t(alignof(T)));
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>&) const { return true; }
+
+        template<typename U>
+        bool operator!=(const PoolAllocator<U>&) const { return false; }
+    };
+}
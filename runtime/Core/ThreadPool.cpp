@@ -19,10 +19,12 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES =========
+//= INCLUDES ======================
 #include "pch.h"
 #include "ThreadPool.h"
-//====================
+#include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
+//=================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -38,6 +40,8 @@ namespace Spartan
     // Sync objects
     static mutex mutex_tasks;
     static condition_variable condition_var;
+    static mutex mutex_done;
+    static condition_variable condition_var_done;
 
     // Threads
     static vector<thread> threads;
@@ -48,8 +52,10 @@ namespace Spartan
     // Misc
     static bool is_stopping;
 
-    static void thread_loop()
+    static void thread_loop(const uint32_t index)
     {
+        Profiler::SetThreadName(("Worker " + to_string(index)).c_str());
+
         while (true)
         {
             // Lock tasks mutex
@@ -86,7 +92,7 @@ namespace Spartan
 
         for (uint32_t i = 0; i < thread_count; i++)
         {
-            threads.emplace_back(thread(&thread_loop));
+            threads.emplace_back(thread(&thread_loop, i));
         }
 
         SP_LOG_INFO("%d threads have been created", thread_count);
@@ -130,8 +136,12 @@ namespace Spartan
         // Lock tasks mutex
         unique_lock<mutex> lock(mutex_tasks);
 
-        // Save the task
-        tasks.emplace_back(bind(forward<Task>(task)));
+        // Save the task, it runs with the memory tag of the thread which added it
+        tasks.emplace_back([tag = MemoryTracker::GetThreadTag(), task = forward<Task>(task)]()
+        {
+            MemoryTagScope memory_tag_scope(tag);
+            task();
+        });
 
         // Unlock the mutex
         lock.unlock();
@@ -140,16 +150,38 @@ namespace Spartan
         condition_var.notify_one();
     }
 
+    void ThreadPool::AddTask(Task&& task, atomic<uint32_t>& pending)
+    {
+        pending++;
+
+        AddTask([&pending, task = move(task)]()
+        {
+            task();
+
+            // Under the lock, so that a waiter can't miss the notification between checking the counter and going to sleep
+            lock_guard<mutex> lock(mutex_done);
+            pending--;
+            condition_var_done.notify_all();
+        });
+    }
+
+    void ThreadPool::Wait(atomic<uint32_t>& pending)
+    {
+        unique_lock<mutex> lock(mutex_done);
+        condition_var_done.wait(lock, [&pending]() { return pending == 0; });
+    }
+
     void ThreadPool::ParallelLoop(function<void(uint32_t work_index_start, uint32_t work_index_end)>&& function, uint32_t loop_range)
     {
         SP_ASSERT_MSG(loop_range > 1, "A parallel loop can't have a range of 1 or smaller");
 
-        uint32_t available_threads = GetIdleThreadCount();
+        // No more tasks than there is work, otherwise the work per task rounds down to zero and the remainder ends up in a single task
+        uint32_t available_threads = min(GetIdleThreadCount(), loop_range);
         uint32_t work_total        = loop_range;
         uint32_t work_per_thread   = work_total / available_threads;
         uint32_t work_remainder    = work_total % available_threads;
         uint32_t work_index        = 0;
-        atomic<uint32_t> work_done = 0;
+        atomic<uint32_t> pending   = 0;
 
         // Split work into multiple tasks
         while(work_index < work_total)
@@ -163,11 +195,10 @@ namespace Spartan
                 work_remainder = 0;
             }
 
-            AddTask([&function, &work_done, work_index, work_to_do]()
+            AddTask([&function, work_index, work_to_do]()
             {
                 function(work_index, work_index + work_to_do);
-                work_done += work_to_do;
-            });
+            }, pending);
 
             work_index += work_to_do;
         }
@@ -175,12 +206,7 @@ namespace Spartan
         SP_ASSERT_MSG(work_index == work_total, "Some work wasn't assigned to any thread");
 
         // Wait for threads to finish work
-        while (work_done != work_total)
-        {
-            this_thread::sleep_for(chrono::microseconds(16));
-        }
-
-        SP_ASSERT_MSG(work_done == work_total, "One or more threads, didn't finish their work");
+        Wait(pending);
     }
 
     void ThreadPool::Flush(bool remove_queued /*= false*/)
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===========
 #include "Definitions.h"
 #include <functional>
+#include <atomic>
 //======================
 
 namespace Spartan
@@ -39,6 +40,12 @@ namespace Spartan
         // Add a task.
         static void AddTask(Task&& task);
 
+        // Add a task which increments the counter and decrements it once it's done, see Wait()
+        static void AddTask(Task&& task, std::atomic<uint32_t>& pending);
+
+        // Blocks the calling thread (without spinning) until every task added with the counter is done
+        static void Wait(std::atomic<uint32_t>& pending);
+
         // Adds multiple tasks to spread execution of a given function across all available threads.
         static void ParallelLoop(std::function<void(uint32_t work_index_start, uint32_t work_index_end)>&& function, uint32_t work_count);
 
@@ -64,7 +64,18 @@ namespace Spartan
         // Initialise video subsystem (if needed)
         if (SDL_WasInit(SDL_INIT_VIDEO) != 1)
         {
-            if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0)
+            bool initialised = SDL_InitSubSystem(SDL_INIT_VIDEO) == 0;
+
+            #if defined(API_GRAPHICS_NULL)
+            // Headless machines have no display, fall back to SDL's dummy video driver
+            if (!initialised)
+            {
+                SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+                initialised = SDL_InitSubSystem(SDL_INIT_VIDEO) == 0;
+            }
+            #endif
+
+            if (!initialised)
             {
                 SP_LOG_ERROR("Failed to initialise SDL video subsystem: %s.", SDL_GetError());
                 return;
@@ -81,14 +92,16 @@ namespace Spartan
             }
         }
 
-        // Show a splash screen
-        CreateAndShowSplashScreen();
-
         // Set window flags
         uint32_t flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_MAXIMIZED;
 
+        #if !defined(API_GRAPHICS_NULL)
+        // Show a splash screen
+        CreateAndShowSplashScreen();
+
         // If the swapchain surface is created using SDL_Vulkan_CreateSurface(), then the window needs this flag.
         flags |= SDL_WINDOW_VULKAN;
+        #endif
 
         // Create window
         m_title  = "Spartan " + to_string(sp_version_major) + "." + to_string(sp_version_minor) + "." + to_string(sp_version_revision);
@@ -388,6 +401,9 @@ namespace Spartan
         Show();
 
         // Hide and destroy splash screen window
+        if (!m_splash_sceen_window)
+            return;
+
         SDL_DestroyTexture(m_splash_screen_texture);
         SDL_DestroyRenderer(m_splash_screen_renderer);
         SDL_DestroyWindow(m_splash_sceen_window);
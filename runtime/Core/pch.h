@@ -38,6 +38,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <map>
 #include <unordered_map>
 #include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <regex>
 #include <locale>
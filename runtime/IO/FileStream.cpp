@@ -43,8 +43,9 @@ namespace Spartan
 
         if (m_flags & FileStream_Write)
         {
-            out.open(path, ios_flags);
-            if (out.fail())
+            out = &m_file_out;
+            m_file_out.open(path, ios_flags);
+            if (m_file_out.fail())
             {
                 SP_LOG_ERROR("Failed to open \"%s\" for writing", path.c_str());
                 return;
@@ -52,8 +53,9 @@ namespace Spartan
         }
         else if (m_flags & FileStream_Read)
         {
-            in.open(path, ios_flags);
-            if(in.fail())
+            in = &m_file_in;
+            m_file_in.open(path, ios_flags);
+            if(m_file_in.fail())
             {
                 SP_LOG_ERROR("Failed to open \"%s\" for reading", path.c_str());
                 return;
@@ -63,6 +65,16 @@ namespace Spartan
         m_is_open = true;
     }
 
+    FileStream::FileStream(uint32_t flags, string&& buffer /*= string()*/)
+    {
+        m_flags     = flags;
+        m_is_memory = true;
+        m_memory    = stringstream(move(buffer), ios::in | ios::out | ios::binary);
+        out         = &m_memory;
+        in          = &m_memory;
+        m_is_open   = true;
+    }
+
     FileStream::~FileStream()
     {
         Close();
@@ -70,15 +82,18 @@ namespace Spartan
 
     void FileStream::Close()
     {
+        if (m_is_memory)
+            return;
+
         if (m_flags & FileStream_Write)
         {
-            out.flush();
-            out.close();
+            m_file_out.flush();
+            m_file_out.close();
         }
         else if (m_flags & FileStream_Read)
         {
-            in.clear();
-            in.close();
+            m_file_in.clear();
+            m_file_in.close();
         }
     }
 
@@ -87,7 +102,7 @@ namespace Spartan
         const auto length = static_cast<uint32_t>(value.length());
         Write(length);
 
-        out.write(const_cast<char*>(value.c_str()), length);
+        out->write(const_cast<char*>(value.c_str()), length);
     }
 
     void FileStream::Write(const vector<string>& value)
@@ -105,33 +120,38 @@ namespace Spartan
     {
         const auto length = static_cast<uint32_t>(value.size());
         Write(length);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosTexNorTan) * length);
+        out->write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosTexNorTan) * length);
     }
 
     void FileStream::Write(const vector<uint32_t>& value)
     {
         const auto length = static_cast<uint32_t>(value.size());
         Write(length);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(uint32_t) * length);
+        out->write(reinterpret_cast<const char*>(&value[0]), sizeof(uint32_t) * length);
     }
 
     void FileStream::Write(const vector<unsigned char>& value)
     {
         const auto size = static_cast<uint32_t>(value.size());
         Write(size);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
+        out->write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
     }
 
     void FileStream::Write(const vector<byte>& value)
     {
         const auto size = static_cast<uint32_t>(value.size());
         Write(size);
-        out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+        out->write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
     }
 
     void FileStream::Write(const atomic<bool>& value)
     {
-        out.write(reinterpret_cast<const char*>(&value), sizeof(bool));
+        out->write(reinterpret_cast<const char*>(&value), sizeof(bool));
+    }
+
+    void FileStream::WriteBytes(const void* data, const uint64_t size)
+    {
+        out->write(reinterpret_cast<const char*>(data), size);
     }
 
     void FileStream::Skip(uint64_t n)
@@ -139,21 +159,42 @@ namespace Spartan
         // Set the seek cursor to offset n from the current position
         if (m_flags & FileStream_Write)
         {
-            out.seekp(n, ios::cur);
+            out->seekp(n, ios::cur);
         }
         else if (m_flags & FileStream_Read)
         {
-            in.ignore(n, ios::cur);
+            in->ignore(n, ios::cur);
         }
     }
 
+    void FileStream::Seek(const uint64_t position)
+    {
+        // Set the cursor to an absolute position
+        if (m_flags & FileStream_Write)
+        {
+            out->seekp(position, ios::beg);
+        }
+        else if (m_flags & FileStream_Read)
+        {
+            in->seekg(position, ios::beg);
+        }
+    }
+
+    uint64_t FileStream::GetPosition()
+    {
+        if (m_flags & FileStream_Write)
+            return static_cast<uint64_t>(out->tellp());
+
+        return static_cast<uint64_t>(in->tellg());
+    }
+
     void FileStream::Read(string* value)
     {
         uint32_t length = 0;
         Read(&length);
 
         value->resize(length);
-        in.read(const_cast<char*>(value->c_str()), length);
+        in->read(const_cast<char*>(value->c_str()), length);
     }
 
     void FileStream::Read(vector<string>* vec)
@@ -186,7 +227,7 @@ namespace Spartan
         vec->reserve(length);
         vec->resize(length);
 
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosTexNorTan) * length);
+        in->read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosTexNorTan) * length);
     }
 
     void FileStream::Read(vector<uint32_t>* vec)
@@ -201,7 +242,7 @@ namespace Spartan
         vec->reserve(length);
         vec->resize(length);
 
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
+        in->read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
     }
 
     void FileStream::Read(vector<unsigned char>* vec)
@@ -216,7 +257,7 @@ namespace Spartan
         vec->reserve(length);
         vec->resize(length);
 
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+        in->read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
     }
 
     void FileStream::Read(vector<std::byte>* vec)
@@ -231,11 +272,16 @@ namespace Spartan
         vec->reserve(length);
         vec->resize(length);
 
-        in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+        in->read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
     }
 
     void FileStream::Read(std::atomic<bool>* value)
     {
-        in.read(reinterpret_cast<char*>(value), sizeof(bool));
+        in->read(reinterpret_cast<char*>(value), sizeof(bool));
+    }
+
+    void FileStream::ReadBytes(void* data, const uint64_t size)
+    {
+        in->read(reinterpret_cast<char*>(data), size);
     }
 }
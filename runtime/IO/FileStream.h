@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -47,6 +48,8 @@ namespace Spartan
     {
     public:
         FileStream(const std::string& path, uint32_t flags);
+        // In memory stream, used to encode or decode independent blocks of a file on different threads
+        FileStream(uint32_t flags, std::string&& buffer = std::string());
         ~FileStream();
 
         auto IsOpen() const { return m_is_open; }
@@ -78,7 +81,7 @@ namespace Spartan
         >::type>
         void Write(T value)
         {
-            out.write(reinterpret_cast<char*>(&value), sizeof(value));
+            out->write(reinterpret_cast<char*>(&value), sizeof(value));
         }
 
         void Write(const std::string& value);
@@ -88,7 +91,10 @@ namespace Spartan
         void Write(const std::vector<unsigned char>& value);
         void Write(const std::vector<std::byte>& value);
         void Write(const std::atomic<bool>& value);
+        void WriteBytes(const void* data, uint64_t size);
         void Skip(uint64_t n);
+        void Seek(uint64_t position);
+        uint64_t GetPosition();
         //===========================================================
         
         //= READING ===========================================
@@ -118,7 +124,7 @@ namespace Spartan
         >::type>
         void Read(T* value)
         {
-            in.read(reinterpret_cast<char*>(value), sizeof(T));
+            in->read(reinterpret_cast<char*>(value), sizeof(T));
         }
         void Read(std::string* value);
         void Read(std::vector<std::string>* vec);
@@ -127,6 +133,7 @@ namespace Spartan
         void Read(std::vector<unsigned char>* vec);
         void Read(std::vector<std::byte>* vec);
         void Read(std::atomic<bool>* value);
+        void ReadBytes(void* data, uint64_t size);
 
         // Reading with explicit type definition
         template <class T, class = typename std::enable_if
@@ -156,10 +163,17 @@ namespace Spartan
         }
         //=====================================================
 
+        // The written bytes of an in memory stream
+        std::string GetBuffer() const { return m_memory.str(); }
+
     private:
-        std::ofstream out;
-        std::ifstream in;
+        std::ofstream m_file_out;
+        std::ifstream m_file_in;
+        std::stringstream m_memory;
+        std::ostream* out = nullptr;
+        std::istream* in  = nullptr;
         uint32_t m_flags;
         bool m_is_open;
+        bool m_is_memory = false;
     };
 }
@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "ILogger.h"
 #include "../World/Entity.h"
+#include <unordered_set>
+#include <cstring>
 //==========================
 
 //= NAMESPACES ===============
@@ -32,83 +34,283 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-    static vector<LogCmd> logs;
-    static string log_file_name = "log.txt";
-    static ILogger* logger      = nullptr;
-    static bool log_to_file     = true;
-#ifdef DEBUG
-    static bool unique_logs     = true;
-#else
-    static bool unique_logs     = false;
-#endif
-
-    static void write_to_file(string text, const LogType type)
-    {
-        const string prefix = (type == LogType::Info) ? "Info:" : (type == LogType::Warning) ? "Warning:" : "Error:";
-        text                = prefix + " " + text;
-
-        // Delete the previous log file (if it exists)
-        static bool is_first_log = true;
-        if (is_first_log)
+    namespace
+    {
+        constexpr uint32_t k_entry_count     = 2048; // Power of two
+        constexpr uint32_t k_entry_text_size = 1024; // Longer logs are truncated
+        constexpr uint32_t k_idle_sleep_ms   = 2;
+
+        // A slot of the queue, a slot is free for the producer at position p when its sequence is p,
+        // and it holds a log which the consumer can read when its sequence is p + 1 (bounded MPMC queue by Dmitry Vyukov, used with a single consumer)
+        struct LogEntry
+        {
+            atomic<uint64_t> sequence      = 0;
+            LogType type                   = LogType::Info;
+            bool to_file                   = false;
+            time_t time                    = 0;
+            char text[k_entry_text_size]   = {};
+        };
+
+        struct LogQueue
+        {
+            LogQueue()
+            {
+                for (uint64_t i = 0; i < k_entry_count; i++)
+                {
+                    entries[i].sequence.store(i, memory_order_relaxed);
+                }
+
+                thread = std::thread([this]() { Consume(); });
+            }
+
+            ~LogQueue()
+            {
+                Stop();
+            }
+
+            LogEntry& Acquire(uint64_t& position)
+            {
+                position = position_enqueue.load(memory_order_relaxed);
+                while (true)
+                {
+                    LogEntry& entry      = entries[position & (k_entry_count - 1)];
+                    const int64_t offset = static_cast<int64_t>(entry.sequence.load(memory_order_acquire)) - static_cast<int64_t>(position);
+
+                    if (offset == 0)
+                    {
+                        if (position_enqueue.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+                            return entry;
+                    }
+                    else if (offset < 0)
+                    {
+                        // Full, wait for the consumer instead of losing logs
+                        this_thread::yield();
+                        position = position_enqueue.load(memory_order_relaxed);
+                    }
+                    else
+                    {
+                        position = position_enqueue.load(memory_order_relaxed);
+                    }
+                }
+            }
+
+            void Publish(LogEntry& entry, const uint64_t position)
+            {
+                entry.sequence.store(position + 1, memory_order_release);
+            }
+
+            void Flush()
+            {
+                const uint64_t position = position_enqueue.load(memory_order_acquire);
+                while (position_flushed.load(memory_order_acquire) < position && running.load(memory_order_relaxed))
+                {
+                    this_thread::yield();
+                }
+            }
+
+            void Stop()
+            {
+                if (running.exchange(false) && thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+
+            void Consume();
+            void Output(const string& text, const LogType type, const bool to_file);
+
+            LogEntry entries[k_entry_count];
+            atomic<uint64_t> position_enqueue = 0;
+            atomic<uint64_t> position_flushed = 0; // Everything before it has been written
+            atomic<bool> running              = true;
+            std::thread thread;
+
+            // Consumer only
+            uint64_t position_dequeue = 0;
+            ofstream file;
+            bool file_opened          = false;
+            string text_last;
+            LogType type_last         = LogType::Info;
+            bool to_file_last         = false;
+            uint32_t repeat_count     = 0;
+            unordered_set<size_t> error_hashes;
+            vector<LogCmd> logs; // Logs to pass to the logger once it's set
+        };
+
+        static string log_file_name      = "log.txt";
+        static ILogger* logger           = nullptr;
+        static mutex logger_mutex;
+        static atomic<bool> log_to_file  = true;
+    #ifdef DEBUG
+        static bool unique_logs          = true;
+    #else
+        static bool unique_logs          = false;
+    #endif
+
+        LogQueue& get_queue()
         {
-            FileSystem::Delete(log_file_name);
-            is_first_log = false;
+            static LogQueue queue;
+            return queue;
         }
 
-        // Open/Create a log file to write the log into
-        static ofstream fout;
-        fout.open(log_file_name, ofstream::out | ofstream::app);
+        const char* get_prefix(const LogType type)
+        {
+            return (type == LogType::Info) ? "Info:" : (type == LogType::Warning) ? "Warning:" : "Error:";
+        }
 
-        if (fout.is_open())
+        void write(const LogType type, const char* function, const char* text, va_list* args)
         {
-            // Write out the error message
-            fout << text << endl;
+            LogQueue& queue = get_queue();
 
-            // Close the file
-            fout.close();
+            uint64_t position = 0;
+            LogEntry& entry   = queue.Acquire(position);
+            entry.type        = type;
+            entry.to_file     = log_to_file.load(memory_order_relaxed);
+            entry.time        = time(nullptr);
+
+            // Copy what doesn't need formatting, it's much cheaper than printf
+            size_t length = 0;
+            auto append   = [&entry, &length](const char* text, const size_t text_length)
+            {
+                const size_t count = min(text_length, static_cast<size_t>(k_entry_text_size - 1) - length);
+                memcpy(entry.text + length, text, count);
+                length += count;
+            };
+
+            if (function)
+            {
+                append(function, strlen(function));
+                append(": ", 2);
+            }
+
+            if (args && strchr(text, '%'))
+            {
+                vsnprintf(entry.text + length, k_entry_text_size - length, text, *args);
+            }
+            else
+            {
+                append(text, strlen(text));
+                entry.text[length] = '\0';
+            }
+
+            queue.Publish(entry, position);
         }
     }
 
-    void Log::SetLogger(ILogger* logger_in)
+    void LogQueue::Consume()
     {
-        logger = logger_in;
-    }
+        time_t time_last = 0;
+        char time_text[16] = {};
 
-    // All functions resolve to this one
-    void Log::Write(const char* text, const LogType type)
-    {
-        SP_ASSERT_MSG(text != nullptr, "Text is null");
+        while (true)
+        {
+            // Drain
+            bool drained_any = false;
+            while (true)
+            {
+                LogEntry& entry = entries[position_dequeue & (k_entry_count - 1)];
+                if (entry.sequence.load(memory_order_acquire) != position_dequeue + 1)
+                    break;
 
-        // Lock mutex
-        static mutex log_mutex;
-        lock_guard<mutex> guard(log_mutex);
+                // Add time to the text
+                if (entry.time != time_last)
+                {
+                    time_last = entry.time;
+                    strftime(time_text, sizeof(time_text), "[%H:%M:%S]", localtime(&time_last));
+                }
+                const string body  = entry.text;
+                const string text  = string(time_text) + ": " + body;
+                const LogType type = entry.type;
+                const bool to_file = entry.to_file;
+
+                // Release the slot
+                entry.sequence.store(position_dequeue + k_entry_count, memory_order_release);
+                position_dequeue++;
+                drained_any = true;
+
+                // Only output unique errors, if requested
+                if (unique_logs && type == LogType::Error && !error_hashes.emplace(hash<string>()(body)).second)
+                    continue;
+
+                // Collapse repeated messages, a summary is written once they stop
+                if (type == type_last && body == text_last)
+                {
+                    repeat_count++;
+                    continue;
+                }
 
-        // Only output unique text, if requested.
-        static vector<string> logs_error_strings;
-        if (unique_logs && type == LogType::Error)
-        {
-            if (find(logs_error_strings.begin(), logs_error_strings.end(), text) == logs_error_strings.end())
+                if (repeat_count != 0)
+                {
+                    Output(string(time_text) + ": The previous message was repeated " + to_string(repeat_count) + " times", type_last, to_file_last);
+                    repeat_count = 0;
+                }
+
+                text_last    = body;
+                type_last    = type;
+                to_file_last = to_file;
+                Output(text, type, to_file);
+            }
+
+            if (drained_any)
             {
-                logs_error_strings.emplace_back(text);
+                if (file_opened)
+                {
+                    file.flush();
+                }
+
+                position_flushed.store(position_dequeue, memory_order_release);
+                continue;
             }
-            else
+
+            // Idle, summarize repeats so they don't wait for the next different message
+            if (repeat_count != 0)
             {
-                return;
+                Output(string(time_text) + ": The previous message was repeated " + to_string(repeat_count) + " times", type_last, to_file_last);
+                repeat_count = 0;
+                text_last.clear();
+
+                if (file_opened)
+                {
+                    file.flush();
+                }
             }
+
+            if (!running.load(memory_order_relaxed))
+                break;
+
+            this_thread::sleep_for(chrono::milliseconds(k_idle_sleep_ms));
         }
 
-        // Add time to the text
-        auto t  = time(nullptr);
-        auto tm = *localtime(&t);
-        ostringstream oss;
-        oss << std::put_time(&tm, "[%H:%M:%S]");
-        const string final_text = oss.str() + ": " + string(text);
+        if (file_opened)
+        {
+            file.close();
+        }
+    }
+
+    void LogQueue::Output(const string& text, const LogType type, const bool to_file)
+    {
+        lock_guard<mutex> guard(logger_mutex);
 
         // Log to file if requested or if an in-engine logger is not available.
-        if (log_to_file || !logger)
+        if (to_file || !logger)
+        {
+            // The file is recreated by the first log, and kept open
+            if (!file_opened)
+            {
+                file.open(log_file_name, ofstream::out | ofstream::trunc);
+                file_opened = true;
+            }
+
+            if (file.is_open())
+            {
+                file << get_prefix(type) << " " << text << '\n';
+            }
+        }
+
+        // Keep what is logged before there is a logger, so it can be passed on later
+        if (!logger)
         {
-            logs.emplace_back(final_text, type);
-            write_to_file(final_text, type);
+            logs.emplace_back(text, type);
         }
 
         // Log with the logger, if present.
@@ -124,10 +326,38 @@ namespace Spartan
                 logs.clear();
             }
 
-            logger->Log(final_text, static_cast<uint32_t>(type));
+            logger->Log(text, static_cast<uint32_t>(type));
         }
     }
 
+    void Log::SetLogger(ILogger* logger_in)
+    {
+        lock_guard<mutex> guard(logger_mutex);
+        logger = logger_in;
+    }
+
+    void Log::Flush()
+    {
+        get_queue().Flush();
+    }
+
+    void Log::WriteF(const LogType type, const char* function, const char* text, ...)
+    {
+        SP_ASSERT_MSG(text != nullptr, "Text is null");
+
+        va_list args;
+        va_start(args, text);
+        write(type, function, text, &args);
+        va_end(args);
+    }
+
+    // All functions resolve to this one
+    void Log::Write(const char* text, const LogType type)
+    {
+        SP_ASSERT_MSG(text != nullptr, "Text is null");
+        write(type, nullptr, text, nullptr);
+    }
+
     void Log::SetLogToFile(const bool log_to_file_in)
     {
         log_to_file = log_to_file_in;
@@ -135,35 +365,26 @@ namespace Spartan
 
     void Log::WriteFInfo(const char* text, ...)
     {
-        char buffer[1024];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+        write(LogType::Info, nullptr, text, &args);
         va_end(args);
-
-        Write(buffer, LogType::Info);
     }
 
     void Log::WriteFWarning(const char* text, ...)
     {
-        char buffer[1024];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+        write(LogType::Warning, nullptr, text, &args);
         va_end(args);
-
-        Write(buffer, LogType::Warning);
     }
 
     void Log::WriteFError(const char* text, ...)
     {
-        char buffer[1024];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+        write(LogType::Error, nullptr, text, &args);
         va_end(args);
-
-        Write(buffer, LogType::Error);
     }
 
     void Log::Write(const string& text, const LogType type)
@@ -173,35 +394,26 @@ namespace Spartan
 
     void Log::WriteFInfo(const string text, ...)
     {
-        char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        write(LogType::Info, nullptr, text.c_str(), &args);
         va_end(args);
-
-        Write(buffer, LogType::Info);
     }
 
     void Log::WriteFWarning(const string text, ...)
     {
-        char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        write(LogType::Warning, nullptr, text.c_str(), &args);
         va_end(args);
-
-        Write(buffer, LogType::Warning);
     }
 
     void Log::WriteFError(const string text, ...)
     {
-        char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        write(LogType::Error, nullptr, text.c_str(), &args);
         va_end(args);
-
-        Write(buffer, LogType::Error);
     }
 
     void Log::Write(const weak_ptr<Entity>& entity, const LogType type)
@@ -30,11 +30,30 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ILogger.h"
 //==============================
 
+// Logs below this severity are compiled out (0: info, 1: warning, 2: error, 3: nothing)
+#ifndef SP_LOG_LEVEL
+#define SP_LOG_LEVEL 0
+#endif
+
 namespace Spartan
 {
-    #define SP_LOG_INFO(text, ...)    { Spartan::Log::WriteFInfo(std::string(__FUNCTION__)    + ": " + std::string(text), ## __VA_ARGS__); }
-    #define SP_LOG_WARNING(text, ...) { Spartan::Log::WriteFWarning(std::string(__FUNCTION__) + ": " + std::string(text), ## __VA_ARGS__); }
-    #define SP_LOG_ERROR(text, ...)   { Spartan::Log::WriteFError(std::string(__FUNCTION__)   + ": " + std::string(text), ## __VA_ARGS__); }
+    #if SP_LOG_LEVEL <= 0
+    #define SP_LOG_INFO(text, ...)    { Spartan::Log::WriteF(Spartan::LogType::Info,    __FUNCTION__, Spartan::Log::ToCString(text), ## __VA_ARGS__); }
+    #else
+    #define SP_LOG_INFO(text, ...)    {}
+    #endif
+
+    #if SP_LOG_LEVEL <= 1
+    #define SP_LOG_WARNING(text, ...) { Spartan::Log::WriteF(Spartan::LogType::Warning, __FUNCTION__, Spartan::Log::ToCString(text), ## __VA_ARGS__); }
+    #else
+    #define SP_LOG_WARNING(text, ...) {}
+    #endif
+
+    #if SP_LOG_LEVEL <= 2
+    #define SP_LOG_ERROR(text, ...)   { Spartan::Log::WriteF(Spartan::LogType::Error,   __FUNCTION__, Spartan::Log::ToCString(text), ## __VA_ARGS__); }
+    #else
+    #define SP_LOG_ERROR(text, ...)   {}
+    #endif
 
     // Forward declarations
     class Entity;
@@ -66,6 +85,8 @@ namespace Spartan
         LogType type;
     };
 
+    // Writing a log formats it into a slot of a lock-free queue and returns, a background thread
+    // adds the time, writes it to a buffered file, passes it to the logger and collapses repeated messages.
     class SP_CLASS Log
     {
         friend class ILogger;
@@ -75,6 +96,14 @@ namespace Spartan
         // Set an ILogger object to handle writing logs
         static void SetLogger(ILogger* logger);
 
+        // Blocks until everything which was logged so far has been written
+        static void Flush();
+
+        // Used by the SP_LOG_* macros, the text is prefixed with the function name
+        static void WriteF(const LogType type, const char* function, const char* text, ...);
+        static const char* ToCString(const char* text)        { return text; }
+        static const char* ToCString(const std::string& text) { return text.c_str(); }
+
         // Alpha
         static void Write(const char* text, const LogType type);
         static void WriteFInfo(const char* text, ...);
@@ -109,7 +109,48 @@ namespace Spartan::Math
         }
     }
 
+    BoundingBox Simd::BoundingBoxTransform(const BoundingBox& box, const Matrix& transform)
+    {
+    #if defined(SP_SIMD_SSE)
+        const float* m = transform.Data();
+
+        // Transposed, so that each output component is a sum of rows instead of a dot product
+        __m128 row0 = _mm_loadu_ps(m + 0);
+        __m128 row1 = _mm_loadu_ps(m + 4);
+        __m128 row2 = _mm_loadu_ps(m + 8);
+        __m128 row3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+        const Vector3 center  = box.GetCenter();
+        const Vector3 extents = box.GetExtents();
+
+        // The center, with the perspective divide
+        __m128 center_new = _mm_add_ps(_mm_mul_ps(row0, _mm_set1_ps(center.x)), _mm_mul_ps(row1, _mm_set1_ps(center.y)));
+        center_new        = _mm_add_ps(_mm_add_ps(center_new, _mm_mul_ps(row2, _mm_set1_ps(center.z))), row3);
+        center_new        = _mm_mul_ps(center_new, _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(center_new, center_new, _MM_SHUFFLE(3, 3, 3, 3))));
+
+        // The extents, through the absolute rotation and scale
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        __m128 extents_new     = _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, row0), _mm_set1_ps(extents.x)), _mm_mul_ps(_mm_andnot_ps(sign_mask, row1), _mm_set1_ps(extents.y)));
+        extents_new            = _mm_add_ps(extents_new, _mm_mul_ps(_mm_andnot_ps(sign_mask, row2), _mm_set1_ps(extents.z)));
+
+        float min_new[4];
+        float max_new[4];
+        _mm_storeu_ps(min_new, _mm_sub_ps(center_new, extents_new));
+        _mm_storeu_ps(max_new, _mm_add_ps(center_new, extents_new));
+
+        return BoundingBox(Vector3(min_new[0], min_new[1], min_new[2]), Vector3(max_new[0], max_new[1], max_new[2]));
+    #else
+        return box.TransformScalar(transform);
+    #endif
+    }
+
     BoundingBox BoundingBox::Transform(const Matrix& transform) const
+    {
+        return Simd::BoundingBoxTransform(*this, transform);
+    }
+
+    BoundingBox BoundingBox::TransformScalar(const Matrix& transform) const
     {
         const Vector3 center_new = transform * GetCenter();
         const Vector3 extent_old = GetExtents();
@@ -71,6 +71,7 @@ namespace Spartan
 
             // Returns a transformed bounding box
             BoundingBox Transform(const Matrix& transform) const;
+            BoundingBox TransformScalar(const Matrix& transform) const;
 
             // Merge with another bounding box
             void Merge(const BoundingBox& box);
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Quaternion.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "Simd.h"
 //=====================
 
 namespace Spartan::Math
@@ -281,7 +282,8 @@ namespace Spartan::Math
 
         //= INVERT =======================================================================================
         [[nodiscard]] Matrix Inverted() const { return Invert(*this); }
-        static inline Matrix Invert(const Matrix& matrix)
+        static inline Matrix Invert(const Matrix& matrix) { return Simd::MatrixInvert(matrix); }
+        static inline Matrix InvertScalar(const Matrix& matrix)
         {
             float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
             float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
@@ -355,25 +357,26 @@ namespace Spartan::Math
         }
 
         //= MULTIPLICATION ===========================================================================
-        Matrix operator*(const Matrix& rhs) const
+        Matrix operator*(const Matrix& rhs) const { return Simd::MatrixMultiply(*this, rhs); }
+        static inline Matrix MultiplyScalar(const Matrix& lhs, const Matrix& rhs)
         {
             return Matrix(
-                m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
-                m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
-                m00 * rhs.m02 + m01 * rhs.m12 + m02 * rhs.m22 + m03 * rhs.m32,
-                m00 * rhs.m03 + m01 * rhs.m13 + m02 * rhs.m23 + m03 * rhs.m33,
-                m10 * rhs.m00 + m11 * rhs.m10 + m12 * rhs.m20 + m13 * rhs.m30,
-                m10 * rhs.m01 + m11 * rhs.m11 + m12 * rhs.m21 + m13 * rhs.m31,
-                m10 * rhs.m02 + m11 * rhs.m12 + m12 * rhs.m22 + m13 * rhs.m32,
-                m10 * rhs.m03 + m11 * rhs.m13 + m12 * rhs.m23 + m13 * rhs.m33,
-                m20 * rhs.m00 + m21 * rhs.m10 + m22 * rhs.m20 + m23 * rhs.m30,
-                m20 * rhs.m01 + m21 * rhs.m11 + m22 * rhs.m21 + m23 * rhs.m31,
-                m20 * rhs.m02 + m21 * rhs.m12 + m22 * rhs.m22 + m23 * rhs.m32,
-                m20 * rhs.m03 + m21 * rhs.m13 + m22 * rhs.m23 + m23 * rhs.m33,
-                m30 * rhs.m00 + m31 * rhs.m10 + m32 * rhs.m20 + m33 * rhs.m30,
-                m30 * rhs.m01 + m31 * rhs.m11 + m32 * rhs.m21 + m33 * rhs.m31,
-                m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
-                m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
+                lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20 + lhs.m03 * rhs.m30,
+                lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21 + lhs.m03 * rhs.m31,
+                lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22 + lhs.m03 * rhs.m32,
+                lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03 * rhs.m33,
+                lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20 + lhs.m13 * rhs.m30,
+                lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21 + lhs.m13 * rhs.m31,
+                lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22 + lhs.m13 * rhs.m32,
+                lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13 * rhs.m33,
+                lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20 + lhs.m23 * rhs.m30,
+                lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21 + lhs.m23 * rhs.m31,
+                lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22 + lhs.m23 * rhs.m32,
+                lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23 * rhs.m33,
+                lhs.m30 * rhs.m00 + lhs.m31 * rhs.m10 + lhs.m32 * rhs.m20 + lhs.m33 * rhs.m30,
+                lhs.m30 * rhs.m01 + lhs.m31 * rhs.m11 + lhs.m32 * rhs.m21 + lhs.m33 * rhs.m31,
+                lhs.m30 * rhs.m02 + lhs.m31 * rhs.m12 + lhs.m32 * rhs.m22 + lhs.m33 * rhs.m32,
+                lhs.m30 * rhs.m03 + lhs.m31 * rhs.m13 + lhs.m32 * rhs.m23 + lhs.m33 * rhs.m33
             );
         }
 
@@ -453,4 +456,102 @@ namespace Spartan::Math
     // Reverse order operators
     inline SP_CLASS Vector3 operator*(const Vector3& lhs, const Matrix& rhs) { return rhs * lhs; }
     inline SP_CLASS Vector4 operator*(const Vector4& lhs, const Matrix& rhs) { return rhs * lhs; }
+
+    //= SIMD =========================================================================================================================
+    // Matrices are stored column by column, so Data() + column * 4 loads a column
+    inline Matrix Simd::MatrixMultiply(const Matrix& lhs, const Matrix& rhs)
+    {
+    #if defined(SP_SIMD_AVX2)
+        // Two columns at a time, fused multiply-adds round once instead of twice, so the results can differ from the scalar version in the last bit
+        const float* a = lhs.Data();
+        const float* b = rhs.Data();
+        Matrix result;
+        float* c = &result.m00;
+
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+        for (uint32_t column = 0; column < 4; column += 2)
+        {
+            const __m256 b_columns = _mm256_loadu_ps(b + column * 4);
+
+            __m256 sum = _mm256_mul_ps(a0, _mm256_shuffle_ps(b_columns, b_columns, _MM_SHUFFLE(0, 0, 0, 0)));
+            sum        = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b_columns, b_columns, _MM_SHUFFLE(1, 1, 1, 1)), sum);
+            sum        = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b_columns, b_columns, _MM_SHUFFLE(2, 2, 2, 2)), sum);
+            sum        = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b_columns, b_columns, _MM_SHUFFLE(3, 3, 3, 3)), sum);
+
+            _mm256_storeu_ps(c + column * 4, sum);
+        }
+
+        return result;
+    #else
+        return Matrix::MultiplyScalar(lhs, rhs);
+    #endif
+    }
+
+    inline Matrix Simd::MatrixInvert(const Matrix& matrix)
+    {
+    #if defined(SP_SIMD_SSE)
+        // Block-wise inverse, the matrix is split into four 2x2 matrices. The inverse of the transpose is the transpose of the inverse,
+        // so it doesn't matter that the columns are loaded as rows. The operations differ from the scalar version, expect small differences.
+        const float* m = matrix.Data();
+        Matrix result;
+        float* r = &result.m00;
+
+        const __m128 row0 = _mm_loadu_ps(m + 0);
+        const __m128 row1 = _mm_loadu_ps(m + 4);
+        const __m128 row2 = _mm_loadu_ps(m + 8);
+        const __m128 row3 = _mm_loadu_ps(m + 12);
+
+        // Sub matrices
+        const __m128 a = _mm_movelh_ps(row0, row1);
+        const __m128 b = _mm_movehl_ps(row1, row0);
+        const __m128 c = _mm_movelh_ps(row2, row3);
+        const __m128 d = _mm_movehl_ps(row3, row2);
+
+        // Their determinants, as (|A|, |B|, |C|, |D|)
+        const __m128 det_sub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0)))
+        );
+        const __m128 det_a = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 det_b = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 det_c = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 det_d = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // The inverse is 1 / |M| * | X Y |
+        //                          | Z W |
+        const __m128 d_c = Mat2AdjugateMultiply(d, c);
+        const __m128 a_b = Mat2AdjugateMultiply(a, b);
+        __m128 x         = _mm_sub_ps(_mm_mul_ps(det_d, a), Mat2Multiply(b, d_c));
+        __m128 w         = _mm_sub_ps(_mm_mul_ps(det_a, d), Mat2Multiply(c, a_b));
+        __m128 y         = _mm_sub_ps(_mm_mul_ps(det_b, c), Mat2MultiplyAdjugate(d, a_b));
+        __m128 z         = _mm_sub_ps(_mm_mul_ps(det_c, b), Mat2MultiplyAdjugate(a, d_c));
+
+        // |M| = |A| * |D| + |B| * |C| - trace(A#B * D#C), the trace is summed with shuffles so that plain SSE is enough
+        __m128 trace     = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+        trace            = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+        trace            = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+        const __m128 det_inverse = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        x = _mm_mul_ps(x, det_inverse);
+        y = _mm_mul_ps(y, det_inverse);
+        z = _mm_mul_ps(z, det_inverse);
+        w = _mm_mul_ps(w, det_inverse);
+
+        // The adjugates, shuffled into place
+        _mm_storeu_ps(r + 0,  _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(r + 4,  _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(r + 8,  _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(r + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+        return result;
+    #else
+        return Matrix::InvertScalar(matrix);
+    #endif
+    }
+    //================================================================================================================================
 }
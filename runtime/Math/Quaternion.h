@@ -157,6 +157,26 @@ namespace Spartan::Math
             return quaternion.Normalized();
         }
 
+        // Spherical linear interpolation, constant angular velocity along the shortest path
+        static inline Quaternion Slerp(const Quaternion& a, const Quaternion& b, const float t)
+        {
+            // Take the shortest path
+            float cos_theta      = Dot(a, b);
+            const Quaternion end = cos_theta < 0.0f ? -b : b;
+            cos_theta            = Helper::Abs(cos_theta);
+
+            // Almost parallel, sin(theta) approaches zero, so fall back to a normalized lerp
+            if (cos_theta > 0.9995f)
+                return (a * (1.0f - t) + end * t).Normalized();
+
+            const float theta     = acosf(cos_theta);
+            const float sin_theta = sinf(theta);
+            const float weight_a  = sinf((1.0f - t) * theta) / sin_theta;
+            const float weight_b  = sinf(t * theta) / sin_theta;
+
+            return a * weight_a + end * weight_b;
+        }
+
         static inline Quaternion Multiply(const Quaternion& Qa, const Quaternion& Qb)
         {
             const float x     = Qa.x;
@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include "../Core/Definitions.h"
+//==============================
+
+//= SIMD ===============================================================================================================
+// The instruction set is selected at compile time, so the math below inlines into its callers.
+// SSE is part of every x86-64 target, AVX2 (with FMA) needs to be enabled explicitly (e.g. /arch:AVX2 or -mavx2 -mfma).
+#if (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(SP_SIMD_DISABLED)
+    #define SP_SIMD_SSE
+    #include <immintrin.h>
+    #if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER)) // MSVC implies FMA with /arch:AVX2
+        #define SP_SIMD_AVX2
+    #endif
+#endif
+//======================================================================================================================
+
+namespace Spartan::Math
+{
+    class Matrix;
+    class BoundingBox;
+
+    // SIMD versions of the math which runs on hot paths every frame (transforms, cascades, culling, picking), each one
+    // is only used where it measured faster than the scalar version, otherwise it is the scalar version:
+    // - MatrixMultiply:       AVX2 with FMA, scalar without it (SSE measured slower than what the compiler does with the scalar code)
+    // - MatrixInvert:         SSE, a 2x2 block-wise inverse
+    // - BoundingBoxTransform: SSE
+    // Quaternion multiplication and slerp stay scalar, SIMD measured slower for both.
+    class SP_CLASS Simd
+    {
+    public:
+        static constexpr const char* GetName()
+        {
+        #if defined(SP_SIMD_AVX2)
+            return "AVX2";
+        #elif defined(SP_SIMD_SSE)
+            return "SSE";
+        #else
+            return "Scalar";
+        #endif
+        }
+
+        static Matrix MatrixMultiply(const Matrix& lhs, const Matrix& rhs);                   // Defined in Matrix.h
+        static Matrix MatrixInvert(const Matrix& matrix);                                     // Defined in Matrix.h
+        static BoundingBox BoundingBoxTransform(const BoundingBox& box, const Matrix& transform); // Defined in BoundingBox.cpp
+
+    #if defined(SP_SIMD_SSE)
+        // 2x2 matrices, packed as (m00, m01, m10, m11)
+        static inline __m128 Mat2Multiply(const __m128 a, const __m128 b) // a * b
+        {
+            return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        static inline __m128 Mat2AdjugateMultiply(const __m128 a, const __m128 b) // adjugate(a) * b
+        {
+            return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        static inline __m128 Mat2MultiplyAdjugate(const __m128 a, const __m128 b) // a * adjugate(b)
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+    #endif
+    };
+}
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "PhysicsDebugDraw.h"
 #include "BulletPhysicsHelper.h"
 #include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
 #include "../World/Components/Camera.h"
@@ -71,6 +72,9 @@ namespace Spartan
         static  float m_picking_distance_previous         = 0.0f;
 
         static const bool m_soft_body_support = true;
+
+        // Bodies and constraints can be added from other threads, e.g. while a world loads
+        static mutex m_world_mutex;
     }
 
     void Physics::Initialize()
@@ -141,6 +145,8 @@ namespace Spartan
 
     void Physics::Tick()
     {
+        SP_MEMORY_TAG(Physics);
+
         if (!m_world)
             return;
         
@@ -184,9 +190,13 @@ namespace Spartan
         }
 
         // Step the physics world. 
-        m_simulating = true;
-        m_world->stepSimulation(static_cast<float>(Timer::GetDeltaTimeSec()), max_substeps, internal_time_step);
-        m_simulating = false;
+        {
+            lock_guard lock(m_world_mutex);
+
+            m_simulating = true;
+            m_world->stepSimulation(static_cast<float>(Timer::GetDeltaTimeSec()), max_substeps, internal_time_step);
+            m_simulating = false;
+        }
     }
 
     void Physics::AddBody(btRigidBody* body)
@@ -194,6 +204,7 @@ namespace Spartan
         if (!m_world)
             return;
 
+        lock_guard lock(m_world_mutex);
         m_world->addRigidBody(body);
     }
 
@@ -202,6 +213,7 @@ namespace Spartan
         if (!m_world)
             return;
 
+        lock_guard lock(m_world_mutex);
         m_world->removeRigidBody(body);
         delete body->getMotionState();
         delete body;
@@ -212,6 +224,7 @@ namespace Spartan
         if (!m_world)
             return;
 
+        lock_guard lock(m_world_mutex);
         m_world->addConstraint(constraint, !collision_with_linked_body);
     }
 
@@ -220,6 +233,7 @@ namespace Spartan
         if (!m_world)
             return;
 
+        lock_guard lock(m_world_mutex);
         m_world->removeConstraint(constraint);
         delete constraint;
     }
@@ -229,6 +243,7 @@ namespace Spartan
         if (!m_world)
             return;
 
+        lock_guard lock(m_world_mutex);
         if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
         {
             world->addSoftBody(body);
@@ -237,6 +252,7 @@ namespace Spartan
 
     void Physics::RemoveBody(btSoftBody*& body)
     {
+        lock_guard lock(m_world_mutex);
         if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
         {
             world->removeSoftBody(body);
@@ -270,6 +286,15 @@ namespace Spartan
         return m_simulating;
     }
 
+    uint32_t Physics::GetBodyCount()
+    {
+        if (!m_world)
+            return 0;
+
+        lock_guard lock(m_world_mutex);
+        return static_cast<uint32_t>(m_world->getNumCollisionObjects());
+    }
+
     void Physics::PickBody()
     {
         if (shared_ptr<Camera> camera = Renderer::GetCamera())
@@ -64,6 +64,7 @@ namespace Spartan
         static btSoftBodyWorldInfo& GetSoftWorldInfo();
         static auto GetPhysicsDebugDraw();
         static bool IsSimulating();
+        static uint32_t GetBodyCount(); // Rigid and soft bodies in the physics world
 
     private:
         // Picking
@@ -0,0 +1,252 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ============
+#include "pch.h"
+#include "MemoryTracker.h"
+#include <cstdlib>
+#include <new>
+//=======================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        // Prepended to every allocation, its size keeps the default alignment of the allocation intact
+        struct AllocationHeader
+        {
+            uint64_t size   = 0;
+            uint32_t offset = 0; // From the start of the block which malloc returned
+            MemoryTag tag   = MemoryTag::Untagged;
+        };
+        constexpr size_t k_header_size = 16;
+        static_assert(sizeof(AllocationHeader) <= k_header_size, "The allocation header doesn't fit");
+
+        constexpr uint32_t k_tag_count = static_cast<uint32_t>(MemoryTag::Max);
+
+        // Updated by every allocation, so they are lock free (and constant initialized, since allocations happen before any dynamic initialization)
+        struct TagCounters
+        {
+            atomic<int64_t> bytes_live        = 0;
+            atomic<int64_t> bytes_peak        = 0;
+            atomic<uint64_t> bytes_allocated  = 0;
+            atomic<uint64_t> allocations      = 0;
+        };
+        static TagCounters m_counters[k_tag_count];
+
+        thread_local MemoryTag m_thread_tag = MemoryTag::Untagged;
+
+        // Written by Tick() only
+        static MemoryTagStats m_stats[k_tag_count];
+        static uint64_t m_bytes_allocated_previous[k_tag_count] = {};
+        static uint64_t m_allocations_previous[k_tag_count]     = {};
+        static bool m_over_budget[k_tag_count]                  = {};
+        static uint64_t m_bytes_live                            = 0;
+        static uint32_t m_allocations_frame                     = 0;
+
+        // Device memory, which is allocated in large blocks so a map (and a mutex) is fine
+        static mutex m_gpu_mutex;
+        static unordered_map<const void*, MemoryTag> m_gpu_blocks;
+        static uint64_t m_gpu_bytes_live[k_tag_count] = {};
+
+        static const char* m_tag_names[k_tag_count] =
+        {
+            "Untagged",
+            "World",
+            "Renderer",
+            "Physics",
+            "Resources/Mesh",
+            "Resources/Texture",
+            "Editor"
+        };
+
+        static void* allocate(size_t size, size_t alignment)
+        {
+            alignment = alignment > k_header_size ? alignment : k_header_size;
+
+            // Room for the header and for moving the allocation forward until it's aligned
+            uint8_t* block = static_cast<uint8_t*>(malloc(size + alignment));
+            if (!block)
+                return nullptr;
+
+            uint8_t* memory = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(block) + k_header_size + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+
+            AllocationHeader* header = reinterpret_cast<AllocationHeader*>(memory - k_header_size);
+            header->size             = size;
+            header->offset           = static_cast<uint32_t>(memory - block);
+            header->tag              = m_thread_tag;
+
+            TagCounters& counters = m_counters[static_cast<uint32_t>(header->tag)];
+            const int64_t live    = counters.bytes_live.fetch_add(static_cast<int64_t>(size), memory_order_relaxed) + static_cast<int64_t>(size);
+            counters.bytes_allocated.fetch_add(size, memory_order_relaxed);
+            counters.allocations.fetch_add(1, memory_order_relaxed);
+
+            int64_t peak = counters.bytes_peak.load(memory_order_relaxed);
+            while (live > peak && !counters.bytes_peak.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+
+            return memory;
+        }
+
+        static void deallocate(void* memory)
+        {
+            if (!memory)
+                return;
+
+            const AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(memory) - k_header_size);
+            m_counters[static_cast<uint32_t>(header->tag)].bytes_live.fetch_sub(static_cast<int64_t>(header->size), memory_order_relaxed);
+
+            std::free(static_cast<uint8_t*>(memory) - header->offset);
+        }
+
+        static void* allocate_or_throw(size_t size, size_t alignment)
+        {
+            if (void* memory = allocate(size == 0 ? 1 : size, alignment))
+                return memory;
+
+            throw bad_alloc();
+        }
+    }
+
+    void MemoryTracker::Tick()
+    {
+        m_bytes_live        = 0;
+        m_allocations_frame = 0;
+
+        for (uint32_t i = 0; i < k_tag_count; i++)
+        {
+            const uint64_t bytes_allocated = m_counters[i].bytes_allocated.load(memory_order_relaxed);
+            const uint64_t allocations     = m_counters[i].allocations.load(memory_order_relaxed);
+
+            MemoryTagStats& stats       = m_stats[i];
+            stats.bytes_live            = static_cast<uint64_t>(max<int64_t>(m_counters[i].bytes_live.load(memory_order_relaxed), 0));
+            stats.bytes_peak            = static_cast<uint64_t>(max<int64_t>(m_counters[i].bytes_peak.load(memory_order_relaxed), 0));
+            stats.bytes_allocated_frame = bytes_allocated - m_bytes_allocated_previous[i];
+            stats.allocations_frame     = static_cast<uint32_t>(allocations - m_allocations_previous[i]);
+            {
+                lock_guard lock(m_gpu_mutex);
+                stats.bytes_gpu_live = m_gpu_bytes_live[i];
+            }
+
+            m_bytes_allocated_previous[i] = bytes_allocated;
+            m_allocations_previous[i]     = allocations;
+            m_bytes_live                 += stats.bytes_live;
+            m_allocations_frame          += stats.allocations_frame;
+
+            // Budget, warn once per crossing
+            const bool over_budget = stats.bytes_budget != 0 && (stats.bytes_live + stats.bytes_gpu_live) > stats.bytes_budget;
+            if (over_budget && !m_over_budget[i])
+            {
+                SP_LOG_WARNING("%s is using %.2f MB, which is over its budget of %.2f MB",
+                    m_tag_names[i],
+                    static_cast<double>(stats.bytes_live + stats.bytes_gpu_live) / 1048576.0,
+                    static_cast<double>(stats.bytes_budget) / 1048576.0
+                );
+            }
+            m_over_budget[i] = over_budget;
+        }
+    }
+
+    MemoryTag MemoryTracker::GetThreadTag()
+    {
+        return m_thread_tag;
+    }
+
+    MemoryTag MemoryTracker::SetThreadTag(const MemoryTag tag)
+    {
+        const MemoryTag tag_previous = m_thread_tag;
+        m_thread_tag                 = tag;
+        return tag_previous;
+    }
+
+    const char* MemoryTracker::GetTagName(const MemoryTag tag)
+    {
+        SP_ASSERT(tag < MemoryTag::Max);
+        return m_tag_names[static_cast<uint32_t>(tag)];
+    }
+
+    void MemoryTracker::SetBudget(const MemoryTag tag, const uint64_t bytes)
+    {
+        SP_ASSERT(tag < MemoryTag::Max);
+        m_stats[static_cast<uint32_t>(tag)].bytes_budget = bytes;
+    }
+
+    void MemoryTracker::OnGpuAllocate(const void* memory, const uint64_t size)
+    {
+        lock_guard lock(m_gpu_mutex);
+        m_gpu_blocks[memory] = m_thread_tag;
+        m_gpu_bytes_live[static_cast<uint32_t>(m_thread_tag)] += size;
+    }
+
+    void MemoryTracker::OnGpuFree(const void* memory, const uint64_t size)
+    {
+        lock_guard lock(m_gpu_mutex);
+
+        auto it = m_gpu_blocks.find(memory);
+        if (it == m_gpu_blocks.end())
+            return;
+
+        m_gpu_bytes_live[static_cast<uint32_t>(it->second)] -= size;
+        m_gpu_blocks.erase(it);
+    }
+
+    const MemoryTagStats& MemoryTracker::GetStats(const MemoryTag tag)
+    {
+        SP_ASSERT(tag < MemoryTag::Max);
+        return m_stats[static_cast<uint32_t>(tag)];
+    }
+
+    uint64_t MemoryTracker::GetBytesLive()
+    {
+        return m_bytes_live;
+    }
+
+    uint32_t MemoryTracker::GetAllocationsFrame()
+    {
+        return m_allocations_frame;
+    }
+}
+
+//= GLOBAL OPERATOR NEW/DELETE ===================================================================================================================
+void* operator new(size_t size)                                                     { return Spartan::allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size)                                                   { return Spartan::allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, align_val_t alignment)                              { return Spartan::allocate_or_throw(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, align_val_t alignment)                            { return Spartan::allocate_or_throw(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const nothrow_t&) noexcept                          { return Spartan::allocate(size == 0 ? 1 : size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const nothrow_t&) noexcept                        { return Spartan::allocate(size == 0 ? 1 : size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept   { return Spartan::allocate(size == 0 ? 1 : size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept { return Spartan::allocate(size == 0 ? 1 : size, static_cast<size_t>(alignment)); }
+void operator delete(void* memory) noexcept                                         { Spartan::deallocate(memory); }
+void operator delete[](void* memory) noexcept                                       { Spartan::deallocate(memory); }
+void operator delete(void* memory, size_t) noexcept                                 { Spartan::deallocate(memory); }
+void operator delete[](void* memory, size_t) noexcept                               { Spartan::deallocate(memory); }
+void operator delete(void* memory, align_val_t) noexcept                            { Spartan::deallocate(memory); }
+void operator delete[](void* memory, align_val_t) noexcept                          { Spartan::deallocate(memory); }
+void operator delete(void* memory, size_t, align_val_t) noexcept                    { Spartan::deallocate(memory); }
+void operator delete[](void* memory, size_t, align_val_t) noexcept                  { Spartan::deallocate(memory); }
+void operator delete(void* memory, const nothrow_t&) noexcept                       { Spartan::deallocate(memory); }
+void operator delete[](void* memory, const nothrow_t&) noexcept                     { Spartan::deallocate(memory); }
+void operator delete(void* memory, align_val_t, const nothrow_t&) noexcept          { Spartan::deallocate(memory); }
+void operator delete[](void* memory, align_val_t, const nothrow_t&) noexcept        { Spartan::deallocate(memory); }
+//================================================================================================================================================
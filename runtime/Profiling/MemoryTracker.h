@@ -0,0 +1,98 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <cstdint>
+#include "../Core/Definitions.h"
+//==============================
+
+// Attributes the allocations which the calling thread makes until the end of the scope to a tag
+#define SP_MEMORY_TAG(tag) Spartan::MemoryTagScope memory_tag_scope = Spartan::MemoryTagScope(Spartan::MemoryTag::tag);
+
+namespace Spartan
+{
+    enum class MemoryTag : uint8_t
+    {
+        Untagged,
+        World,
+        Renderer,
+        Physics,
+        ResourceMesh,
+        ResourceTexture,
+        Editor,
+        Max
+    };
+
+    struct MemoryTagStats
+    {
+        uint64_t bytes_live            = 0;
+        uint64_t bytes_peak            = 0;
+        uint64_t bytes_budget          = 0; // Zero means no budget
+        uint64_t bytes_gpu_live        = 0; // Device memory which the RHI allocated while the tag was active
+        uint64_t bytes_allocated_frame = 0;
+        uint32_t allocations_frame     = 0;
+    };
+
+    // Tracks every allocation that goes through the global operator new (and device memory reported by the RHI),
+    // per tag. The tag is a property of the thread, tasks which are added to the thread pool inherit the tag of the thread which added them.
+    class SP_CLASS MemoryTracker
+    {
+    public:
+        // Computes the per frame stats and checks the budgets, the profiler calls it once per frame
+        static void Tick();
+
+        // Tags
+        static MemoryTag GetThreadTag();
+        static MemoryTag SetThreadTag(const MemoryTag tag); // Returns the previous tag
+        static const char* GetTagName(const MemoryTag tag);
+
+        // Budgets, a warning is logged when the live bytes of a tag cross its budget
+        static void SetBudget(const MemoryTag tag, const uint64_t bytes);
+
+        // Device memory blocks, reported by the RHI
+        static void OnGpuAllocate(const void* memory, const uint64_t size);
+        static void OnGpuFree(const void* memory, const uint64_t size);
+
+        // Stats, as of the last tick
+        static const MemoryTagStats& GetStats(const MemoryTag tag);
+        static uint64_t GetBytesLive();
+        static uint32_t GetAllocationsFrame();
+    };
+
+    class MemoryTagScope
+    {
+    public:
+        MemoryTagScope(const MemoryTag tag)
+        {
+            m_tag_previous = MemoryTracker::SetThreadTag(tag);
+        }
+
+        ~MemoryTagScope()
+        {
+            MemoryTracker::SetThreadTag(m_tag_previous);
+        }
+
+    private:
+        MemoryTag m_tag_previous = MemoryTag::Untagged;
+    };
+}
@@ -22,14 +22,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =========================
 #include "pch.h"
 #include "Profiler.h"
+#include "MemoryTracker.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../Core/ThreadPool.h"
+#include "../Core/EventBus.h"
+#include "../Core/ProgressTracker.h"
+#include "../Core/FrameAllocator.h"
 #include "../RHI/RHI_SwapChain.h"
 //====================================
 
+//= TIMESTAMPS =========================
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+//======================================
+
 //= NAMESPACES =====
 using namespace std;
 //==================
@@ -54,6 +66,7 @@ namespace Spartan
     uint32_t Profiler::m_rhi_bindings_pipeline          = 0;
     uint32_t Profiler::m_rhi_pipeline_barriers          = 0;
     uint32_t Profiler::m_rhi_timeblock_count            = 0;
+    uint32_t Profiler::m_rhi_resources_released         = 0;
 
     // Metrics - Renderer
     uint32_t Profiler::m_renderer_meshes_rendered = 0;
@@ -75,6 +88,7 @@ namespace Spartan
     // Memory
     uint32_t Profiler::m_descriptor_set_count    = 0;
     uint32_t Profiler::m_descriptor_set_capacity = 0;
+    uint32_t Profiler::m_rhi_resources_pending   = 0;
 
     namespace
     {
@@ -90,6 +104,20 @@ namespace Spartan
         static std::vector<TimeBlock> m_time_blocks_write;
         static std::vector<TimeBlock> m_time_blocks_read;
 
+        // GPU time blocks wait in a ring until the GPU has executed them, so that their results are read without ever waiting on it
+        struct GpuFrame
+        {
+            std::vector<TimeBlock> time_blocks; // Same indices as m_time_blocks_write, which their parents point into
+            uint32_t count = 0;
+        };
+        static const uint32_t m_gpu_frames_capacity = 4;
+        static std::array<GpuFrame, m_gpu_frames_capacity> m_gpu_frames;
+        static uint32_t m_gpu_frame_oldest  = 0;
+        static uint32_t m_gpu_frame_pending = 0;
+        static std::unordered_map<std::string, TimeBlockHistory> m_time_block_histories;
+        static std::unordered_map<std::string, float> m_time_block_frame_totals;
+        static bool m_gpu_frame_resolved = false; // Whether ResolveGpuFrames() published a frame this tick
+
         // FPS
         static float m_fps = 0.0f;
 
@@ -111,6 +139,252 @@ namespace Spartan
         static bool m_increase_capacity    = false;
         static bool m_allow_time_block_end = true;
         static void* m_query_disjoint      = nullptr;
+
+        // CPU events, every thread records into a ring buffer of its own (without locking) and PostTick() drains them all
+        struct CpuEvent
+        {
+            const char* name   = nullptr; // Null ends the innermost open scope
+            uint64_t timestamp = 0;
+        };
+
+        struct CpuScopeOpen
+        {
+            const char* name = nullptr;
+            uint64_t start   = 0;
+        };
+
+        struct ThreadEvents
+        {
+            static constexpr uint64_t capacity = 1 << 14;
+            static constexpr uint64_t slack    = 64; // Ends can use these slots, so that a scope whose begin was recorded can always end
+
+            std::array<CpuEvent, capacity> events;
+            std::atomic<uint64_t> head = 0; // Written by the owning thread only
+            std::atomic<uint64_t> tail = 0; // Written by the profiler only
+            uint32_t dropped_depth     = 0; // Scopes which began while the buffer was full, owning thread only
+            std::vector<CpuScopeOpen> open; // Scopes which haven't ended yet, profiler only
+            std::string name;
+            bool is_main = false;
+        };
+
+        static std::mutex m_thread_events_mutex;
+        static std::vector<std::unique_ptr<ThreadEvents>> m_thread_events;
+        static thread_local ThreadEvents* m_thread_events_local = nullptr;
+        static thread_local std::string m_thread_name_local;
+        static std::thread::id m_main_thread_id;
+
+        // Timestamps are cheap to take (TSC where available) and are converted to milliseconds when merged
+        static uint64_t m_timestamp_calibration_ticks = 0;
+        static std::chrono::steady_clock::time_point m_timestamp_calibration_time;
+        static double m_timestamp_ticks_per_ms = 1.0;
+        static uint64_t m_timestamp_frame_start = 0;
+
+        // CPU timelines (read side)
+        static std::vector<CpuTimeline> m_cpu_timelines;
+        static float m_cpu_timeline_duration = 0.0f;
+
+        // Trace (Chrome trace format), the events of a frame are written here and then go to a capture and/or the hitch ring
+        static constexpr uint32_t m_trace_gpu_tid = 0xFFFF;
+        static std::string m_trace_frame;
+        static double m_trace_frame_start_us = 0.0;
+        static float m_trace_frame_duration  = 0.0f;
+        static bool m_trace_frame_recorded   = false; // Whether the frame that was just merged is traced
+
+        // Trace events, context for what happened during a frame (resource loads, pipeline creations etc.), from any thread
+        struct TraceEvent
+        {
+            const char* category = nullptr;
+            std::string name;
+            uint64_t timestamp   = 0;
+        };
+        static std::mutex m_trace_events_mutex;
+        static std::vector<TraceEvent> m_trace_events;
+        static std::vector<TraceEvent> m_trace_events_frame;
+
+        // Capture
+        static uint32_t m_capture_frames_left = 0;
+        static uint32_t m_capture_frame_count = 0;
+        static bool m_capture_started         = false; // Set once the frame which was in progress when the capture was requested ends
+        static bool m_capture_frame_recorded  = false; // Whether the frame that was just merged belongs to the capture
+        static bool m_capture_profile_restore = false;
+        static std::string m_capture_file_path;
+        static std::string m_capture_json;
+
+        // Hitch detection, the trace of the last frames is kept around and dumped (with the frames after) when one of them takes too long
+        static constexpr uint32_t m_hitch_frames_before = 120;
+        static constexpr uint32_t m_hitch_frames_after  = 30;
+        static constexpr uint32_t m_hitch_frames_min    = 30; // Frames needed for a meaningful median
+        static bool m_hitch_detection                   = false;
+        static float m_hitch_threshold_ms               = 50.0f;
+        static float m_hitch_median_multiple            = 3.0f;
+        static std::array<std::string, m_hitch_frames_before> m_hitch_frames;
+        static std::array<float, m_hitch_frames_before> m_hitch_frame_durations;
+        static uint32_t m_hitch_frame_index             = 0;
+        static uint32_t m_hitch_frame_count             = 0;
+        static uint32_t m_hitch_frames_left             = 0; // Frames which are yet to be added to the dump in progress
+        static uint32_t m_hitch_dump_count              = 0;
+        static std::string m_hitch_json;
+
+        static const char* trace_header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        static double trace_us(const uint64_t timestamp)
+        {
+            return static_cast<double>(static_cast<int64_t>(timestamp - m_timestamp_calibration_ticks)) / m_timestamp_ticks_per_ms * 1000.0;
+        }
+
+        static void trace_append_string(std::string& json, const char* text)
+        {
+            json += '"';
+            for (const char* c = text ? text : ""; *c; c++)
+            {
+                if (*c == '"' || *c == '\\')
+                {
+                    json += '\\';
+                }
+                json += *c;
+            }
+            json += '"';
+        }
+
+        static void trace_append_scope(std::string& json, const char* name, const double start_us, const double duration_us, const uint32_t tid)
+        {
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", tid, start_us, duration_us);
+            json += buffer;
+            trace_append_string(json, name);
+            json += "},\n";
+        }
+
+        static void trace_append_instant(std::string& json, const char* category, const char* name, const double start_us)
+        {
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "{\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"cat\":", start_us);
+            json += buffer;
+            trace_append_string(json, category);
+            json += ",\"name\":";
+            trace_append_string(json, name);
+            json += "},\n";
+        }
+
+        static void trace_append_thread_name(std::string& json, const uint32_t tid, const std::string& name)
+        {
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", tid);
+            json += buffer;
+            trace_append_string(json, name.c_str());
+            json += "}},\n";
+        }
+
+        // Names the tracks and closes the event list, json is ready to be written after this
+        static void trace_finish(std::string& json)
+        {
+            {
+                std::lock_guard lock(m_thread_events_mutex);
+                for (uint32_t i = 0; i < static_cast<uint32_t>(m_thread_events.size()); i++)
+                {
+                    trace_append_thread_name(json, i, m_thread_events[i]->name);
+                }
+            }
+            trace_append_thread_name(json, m_trace_gpu_tid, "GPU");
+
+            // The last event has to be followed by the closing bracket, not a comma
+            json.erase(json.find_last_of(','));
+            json += "\n]}\n";
+        }
+
+        static uint64_t timestamp_now()
+        {
+        #if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+        }
+
+        static ThreadEvents* get_thread_events()
+        {
+            if (!m_thread_events_local)
+            {
+                std::unique_ptr<ThreadEvents> events = std::make_unique<ThreadEvents>();
+                events->is_main                      = std::this_thread::get_id() == m_main_thread_id;
+
+                std::lock_guard lock(m_thread_events_mutex);
+                events->name          = !m_thread_name_local.empty() ? m_thread_name_local : events->is_main ? "Main" : "Thread " + std::to_string(m_thread_events.size());
+                m_thread_events_local = events.get();
+                m_thread_events.emplace_back(std::move(events));
+            }
+
+            return m_thread_events_local;
+        }
+
+        static void record_cpu_event(const char* name)
+        {
+            ThreadEvents* events = get_thread_events();
+
+            // Everything within a scope which was dropped, is dropped as well
+            if (events->dropped_depth > 0)
+            {
+                if (name)
+                {
+                    events->dropped_depth++;
+                }
+                else
+                {
+                    events->dropped_depth--;
+                }
+
+                return;
+            }
+
+            const uint64_t head = events->head.load(std::memory_order_relaxed);
+            const uint64_t used = head - events->tail.load(std::memory_order_acquire);
+            if (used >= (name ? ThreadEvents::capacity - ThreadEvents::slack : ThreadEvents::capacity))
+            {
+                if (name)
+                {
+                    events->dropped_depth++;
+                }
+
+                return;
+            }
+
+            events->events[head & (ThreadEvents::capacity - 1)] = { name, timestamp_now() };
+            events->head.store(head + 1, std::memory_order_release);
+        }
+
+        static void release_gpu_frame(GpuFrame& frame)
+        {
+            for (uint32_t i = 0; i < frame.count; i++)
+            {
+                frame.time_blocks[i].Reset();
+            }
+
+            frame.count = 0;
+        }
+
+        static void add_history_sample(TimeBlockHistory& history, const float sample)
+        {
+            history.samples[history.sample_index] = sample;
+            history.sample_index                  = (history.sample_index + 1) % TimeBlockHistory::sample_capacity;
+            history.sample_count                  = std::min(history.sample_count + 1, TimeBlockHistory::sample_capacity);
+            history.last                          = sample;
+
+            float sum   = 0.0f;
+            history.min = std::numeric_limits<float>::max();
+            history.max = std::numeric_limits<float>::lowest();
+            for (uint32_t i = 0; i < history.sample_count; i++)
+            {
+                sum += history.samples[i];
+                history.min = std::min(history.min, history.samples[i]);
+                history.max = std::max(history.max, history.samples[i]);
+            }
+            history.avg = sum / static_cast<float>(history.sample_count);
+
+            std::array<float, TimeBlockHistory::sample_capacity> sorted = history.samples;
+            const uint32_t index = (history.sample_count * 99 + 99) / 100 - 1;
+            std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + history.sample_count);
+            history.p99 = sorted[index];
+        }
     }
     
     void Profiler::Initialize()
@@ -122,6 +396,10 @@ namespace Spartan
         m_time_blocks_write.reserve(initial_capacity);
         m_time_blocks_write.resize(initial_capacity);
 
+        m_main_thread_id              = this_thread::get_id();
+        m_timestamp_calibration_ticks = timestamp_now();
+        m_timestamp_calibration_time  = chrono::steady_clock::now();
+
         SP_SUBSCRIBE_TO_EVENT(EventType::RendererPostPresent, SP_EVENT_HANDLER_STATIC(OnPostPresent));
     }
 
@@ -132,6 +410,13 @@ namespace Spartan
             SwapBuffers();
         }
 
+        // Release the queries of the frames which the GPU is still behind on
+        for (GpuFrame& frame : m_gpu_frames)
+        {
+            release_gpu_frame(frame);
+        }
+        m_gpu_frame_pending = 0;
+
         Renderer::GetRhiDevice()->QueryRelease(m_query_disjoint);
 
         ClearRhiMetrics();
@@ -165,6 +450,7 @@ namespace Spartan
             m_poll              = true;
 
             SP_LOG_WARNING("Time block list has grown to %d. Consider making the default capacity as large by default, to avoid re-allocating.", size_new);
+            AddTraceEvent("Profiler", "Time block list growth (" + to_string(size_new) + ")");
         }
 
         ClearRhiMetrics();
@@ -172,6 +458,15 @@ namespace Spartan
 
     void Profiler::PostTick()
     {
+        // Drain the CPU events of every thread, this also computes the CPU time
+        MergeCpuEvents();
+
+        // Live bytes and allocation rate per memory tag
+        MemoryTracker::Tick();
+
+        // Read the GPU time blocks of the frames which the GPU has caught up with
+        ResolveGpuFrames();
+
         // Compute timings
         {
             // Detect stutters
@@ -182,7 +477,6 @@ namespace Spartan
 
             frames_to_accumulate = 20.0f;
             delta_feedback       = 1.0f / frames_to_accumulate;
-            m_time_cpu_last      = 0.0f;
             m_time_gpu_last      = 0.0f;
 
             for (const TimeBlock& time_block : m_time_blocks_read)
@@ -190,11 +484,6 @@ namespace Spartan
                 if (!time_block.IsComplete())
                     continue;
 
-                if (!time_block.GetParent() && time_block.GetType() == TimeBlockType::Cpu)
-                {
-                    m_time_cpu_last += time_block.GetDuration();
-                }
-
                 if (!time_block.GetParent() && time_block.GetType() == TimeBlockType::Gpu)
                 {
                     m_time_gpu_last += time_block.GetDuration();
@@ -233,6 +522,12 @@ namespace Spartan
             m_poll = false;
         }
 
+        // A capture needs every frame
+        if (m_capture_frames_left > 0)
+        {
+            m_poll = true;
+        }
+
         // Updating every m_profiling_interval_sec
         if (m_poll)
         {
@@ -251,6 +546,263 @@ namespace Spartan
         {
             SwapBuffers();
         }
+
+        if (m_trace_frame_recorded)
+        {
+            TraceFrame();
+        }
+    }
+
+    void Profiler::StartCapture(const uint32_t frame_count, const string& file_path /*= "profiler_capture.json"*/)
+    {
+        if (m_capture_frames_left > 0)
+        {
+            SP_LOG_WARNING("A capture is already in progress");
+            return;
+        }
+
+        if (frame_count == 0)
+            return;
+
+        m_capture_frames_left     = frame_count;
+        m_capture_frame_count     = frame_count;
+        m_capture_started         = false;
+        m_capture_file_path       = file_path;
+        m_capture_json            = trace_header;
+        m_capture_profile_restore = m_profile;
+
+        // Record everything from now on, so that the frame which the capture starts with is complete
+        m_profile = true;
+        m_poll    = true;
+
+        SP_LOG_INFO("Capturing %d frames to \"%s\"...", frame_count, file_path.c_str());
+    }
+
+    bool Profiler::IsCapturing()
+    {
+        return m_capture_frames_left > 0;
+    }
+
+    void Profiler::SetHitchDetection(const bool enabled, const float threshold_ms /*= 50.0f*/, const float median_multiple /*= 3.0f*/)
+    {
+        m_hitch_threshold_ms    = threshold_ms;
+        m_hitch_median_multiple = median_multiple;
+
+        if (m_hitch_detection == enabled)
+            return;
+
+        m_hitch_detection   = enabled;
+        m_hitch_frame_index = 0;
+        m_hitch_frame_count = 0;
+        m_hitch_frames_left = 0;
+        m_hitch_json.clear();
+        for (string& frame : m_hitch_frames)
+        {
+            frame.clear();
+        }
+
+        if (enabled)
+        {
+            SP_LOG_INFO("Hitch detection enabled, frames above %.1f ms or %.1fx the median are dumped", threshold_ms, median_multiple);
+        }
+    }
+
+    bool Profiler::GetHitchDetection()
+    {
+        return m_hitch_detection;
+    }
+
+    void Profiler::AddTraceEvent(const char* category, const string& name)
+    {
+        if (m_capture_frames_left == 0 && !m_hitch_detection)
+            return;
+
+        lock_guard lock(m_trace_events_mutex);
+        m_trace_events.push_back({ category, name, timestamp_now() });
+    }
+
+    void Profiler::TraceFrame()
+    {
+        char buffer[512];
+
+        // GPU time blocks only have durations, so they are laid out back to back (children within their parent) from the start of the frame.
+        // They are the ones which were resolved this frame, so they trail the CPU by the frames in flight.
+        if (m_gpu_frame_resolved)
+        {
+            unordered_map<const TimeBlock*, double> child_start; // Keyed by the time block in the write list, which is what parents point to
+            double root_start = m_trace_frame_start_us;
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_time_blocks_read.size()); i++)
+            {
+                const TimeBlock& time_block = m_time_blocks_read[i];
+                if (time_block.GetType() != TimeBlockType::Gpu || !time_block.IsComplete())
+                    continue;
+
+                const double duration = static_cast<double>(time_block.GetDuration()) * 1000.0;
+                double& start         = time_block.GetParent() ? child_start[time_block.GetParent()] : root_start;
+
+                trace_append_scope(m_trace_frame, time_block.GetName(), start, duration, m_trace_gpu_tid);
+                child_start[&m_time_blocks_write[i]] = start;
+                start += duration;
+            }
+        }
+
+        // Events
+        for (const TraceEvent& event : m_trace_events_frame)
+        {
+            trace_append_instant(m_trace_frame, event.category, event.name.c_str(), trace_us(event.timestamp));
+        }
+
+        // Counters
+        snprintf(buffer, sizeof(buffer),
+            "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"RHI\",\"args\":{\"draw\":%u,\"dispatch\":%u,\"pipeline_barriers\":%u,\"meshes_rendered\":%u}},\n"
+            "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"RHI bindings\",\"args\":{\"index_buffer\":%u,\"vertex_buffer\":%u,\"constant_buffer\":%u,\"structured_buffer\":%u,\"sampler\":%u,\"texture_sampled\":%u,\"texture_storage\":%u,\"render_target\":%u,\"descriptor_set\":%u,\"pipeline\":%u}},\n"
+            "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"Memory (MB)\",\"args\":{\"gpu_used\":%u,\"resources_cpu\":%.2f,\"resources_gpu\":%.2f}},\n",
+            m_trace_frame_start_us, m_rhi_draw, m_rhi_dispatch, m_rhi_pipeline_barriers, m_renderer_meshes_rendered,
+            m_trace_frame_start_us, m_rhi_bindings_buffer_index, m_rhi_bindings_buffer_vertex, m_rhi_bindings_buffer_constant, m_rhi_bindings_buffer_structured,
+            m_rhi_bindings_sampler, m_rhi_bindings_texture_sampled, m_rhi_bindings_texture_storage, m_rhi_bindings_render_target, m_rhi_bindings_descriptor_set, m_rhi_bindings_pipeline,
+            m_trace_frame_start_us, m_gpu_memory_used, static_cast<double>(ResourceCache::GetMemoryUsageCpu()) / 1048576.0, static_cast<double>(ResourceCache::GetMemoryUsageGpu()) / 1048576.0
+        );
+        m_trace_frame += buffer;
+
+        // Memory tags
+        for (const bool allocations : { false, true })
+        {
+            snprintf(buffer, sizeof(buffer), "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":\"%s\",\"args\":{", m_trace_frame_start_us, allocations ? "Allocations" : "Memory tags (MB)");
+            m_trace_frame += buffer;
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::Max); i++)
+            {
+                const MemoryTagStats& stats = MemoryTracker::GetStats(static_cast<MemoryTag>(i));
+                if (allocations)
+                {
+                    snprintf(buffer, sizeof(buffer), "%s\"%s\":%u", i == 0 ? "" : ",", MemoryTracker::GetTagName(static_cast<MemoryTag>(i)), stats.allocations_frame);
+                }
+                else
+                {
+                    snprintf(buffer, sizeof(buffer), "%s\"%s\":%.2f", i == 0 ? "" : ",", MemoryTracker::GetTagName(static_cast<MemoryTag>(i)), static_cast<double>(stats.bytes_live) / 1048576.0);
+                }
+                m_trace_frame += buffer;
+            }
+
+            m_trace_frame += "}},\n";
+        }
+
+        if (m_capture_frame_recorded)
+        {
+            CaptureFrame();
+        }
+
+        if (m_hitch_detection)
+        {
+            DetectHitch();
+        }
+    }
+
+    void Profiler::CaptureFrame()
+    {
+        m_capture_json += m_trace_frame;
+
+        if (--m_capture_frames_left > 0)
+            return;
+
+        trace_finish(m_capture_json);
+
+        ofstream file(m_capture_file_path, ios::out | ios::trunc);
+        if (file.is_open())
+        {
+            file << m_capture_json;
+            SP_LOG_INFO("Captured %d frames to \"%s\"", m_capture_frame_count, m_capture_file_path.c_str());
+        }
+        else
+        {
+            SP_LOG_ERROR("Failed to write capture to \"%s\"", m_capture_file_path.c_str());
+        }
+
+        m_capture_json.clear();
+        m_capture_json.shrink_to_fit();
+        m_capture_started        = false;
+        m_capture_frame_recorded = false;
+        m_profile                = m_capture_profile_restore;
+    }
+
+    void Profiler::DetectHitch()
+    {
+        // A dump in progress takes the frames which follow the hitch
+        if (m_hitch_frames_left > 0)
+        {
+            m_hitch_json += m_trace_frame;
+
+            if (--m_hitch_frames_left == 0)
+            {
+                trace_finish(m_hitch_json);
+
+                char file_path[64];
+                const time_t time_now = time(nullptr);
+                const size_t length   = strftime(file_path, sizeof(file_path), "hitch_%Y%m%d_%H%M%S", localtime(&time_now));
+                snprintf(file_path + length, sizeof(file_path) - length, "_%u.json", m_hitch_dump_count++);
+
+                // Written on another thread, as writing it here would be a hitch of its own
+                ThreadPool::AddTask([json = move(m_hitch_json), file_path = string(file_path)]()
+                {
+                    ofstream file(file_path, ios::out | ios::trunc);
+                    if (file.is_open())
+                    {
+                        file << json;
+                        SP_LOG_INFO("Saved hitch trace to \"%s\"", file_path.c_str());
+                    }
+                    else
+                    {
+                        SP_LOG_ERROR("Failed to write hitch trace to \"%s\"", file_path.c_str());
+                    }
+                });
+                m_hitch_json = string();
+            }
+
+            return;
+        }
+
+        // Compare against the median of the frames before, frames spent loading a world are expected to take long
+        bool is_hitch     = false;
+        float median      = 0.0f;
+        const float frame = m_trace_frame_duration;
+        if (m_hitch_frame_count >= m_hitch_frames_min && !ProgressTracker::GetProgress(ProgressType::World).IsProgressing())
+        {
+            array<float, m_hitch_frames_before> durations = m_hitch_frame_durations;
+            const uint32_t middle                         = m_hitch_frame_count / 2;
+            nth_element(durations.begin(), durations.begin() + middle, durations.begin() + m_hitch_frame_count);
+            median   = durations[middle];
+            is_hitch = frame > m_hitch_threshold_ms || frame > median * m_hitch_median_multiple;
+        }
+
+        // Ring, swapping keeps the capacity of both strings around
+        m_hitch_frames[m_hitch_frame_index].swap(m_trace_frame);
+        m_hitch_frame_durations[m_hitch_frame_index] = frame;
+        m_hitch_frame_index                          = (m_hitch_frame_index + 1) % m_hitch_frames_before;
+        m_hitch_frame_count                          = min(m_hitch_frame_count + 1, m_hitch_frames_before);
+
+        if (!is_hitch)
+            return;
+
+        SP_LOG_WARNING("Hitch, a frame took %.2f ms (median is %.2f ms), saving a trace of the surrounding frames...", frame, median);
+
+        // Start the dump with the frames before, oldest first, and mark the frame which took too long
+        m_hitch_json = trace_header;
+        for (uint32_t i = 0; i < m_hitch_frame_count; i++)
+        {
+            string& trace = m_hitch_frames[(m_hitch_frame_index + m_hitch_frames_before - m_hitch_frame_count + i) % m_hitch_frames_before];
+            m_hitch_json += trace;
+            trace.clear();
+        }
+
+        char name[128];
+        snprintf(name, sizeof(name), "Hitch (%.2f ms, median %.2f ms)", frame, median);
+        trace_append_instant(m_hitch_json, "Hitch", name, m_trace_frame_start_us);
+
+        // Start over, so that the hitch doesn't affect the median of the next detection
+        m_hitch_frame_index = 0;
+        m_hitch_frame_count = 0;
+        m_hitch_frames_left = m_hitch_frames_after;
     }
 
     void Profiler::OnPostPresent()
@@ -264,53 +816,122 @@ namespace Spartan
 
     void Profiler::SwapBuffers()
     {
-        // Copy completed time blocks write to time blocks read vector (double buffering)
+        // Hand this frame's time blocks over to the ring, their results are read a few frames later (see ResolveGpuFrames())
         {
-            uint32_t pass_index_gpu = 0;
+            // If the ring is full, the GPU is too far behind (or the results were lost), so drop the oldest frame
+            if (m_gpu_frame_pending == m_gpu_frames_capacity)
+            {
+                release_gpu_frame(m_gpu_frames[m_gpu_frame_oldest]);
+                m_gpu_frame_oldest = (m_gpu_frame_oldest + 1) % m_gpu_frames_capacity;
+                m_gpu_frame_pending--;
+            }
 
-            for (uint32_t i = 0; i < static_cast<uint32_t>(m_time_blocks_read.size()); i++)
+            GpuFrame& frame = m_gpu_frames[(m_gpu_frame_oldest + m_gpu_frame_pending) % m_gpu_frames_capacity];
+            frame.time_blocks.resize(m_time_blocks_write.size());
+            frame.count = static_cast<uint32_t>(m_time_block_index + 1);
+
+            for (uint32_t i = 0; i < frame.count; i++)
             {
                 TimeBlock& time_block = m_time_blocks_write[i];
 
-                // Compute time block duration
+                if (!time_block.IsComplete() && time_block.GetType() != TimeBlockType::Undefined) // If undefined, then it wasn't used this frame, nothing wrong with that.
+                {
+                    SP_LOG_WARNING("TimeBlockEnd() was not called for time block \"%s\"", time_block.GetName());
+                }
+
+                // The ring owns the GPU query objects from now on, the write list will create new ones
+                frame.time_blocks[i] = time_block;
+                time_block.ClearGpuObjects();
+                time_block.Reset();
+            }
+
+            if (frame.count != 0)
+            {
+                m_gpu_frame_pending++;
+            }
+        }
+        
+        m_time_block_index = -1;
+    }
+
+    void Profiler::ResolveGpuFrames()
+    {
+        m_gpu_frame_resolved = false;
+
+        // Oldest first, stopping at the first frame which the GPU hasn't finished, nothing here waits on the GPU
+        while (m_gpu_frame_pending != 0)
+        {
+            GpuFrame& frame = m_gpu_frames[m_gpu_frame_oldest];
+
+            bool ready = true;
+            for (uint32_t i = 0; i < frame.count && ready; i++)
+            {
+                TimeBlock& time_block = frame.time_blocks[i];
                 if (time_block.IsComplete())
                 {
-                    // ComputeDuration() must only be called here, at the end of the frame, and not in TimeBlockEnd().
-                    // This is because D3D11 waits too much for the results to be ready, which increases CPU time.
-                    time_block.ComputeDuration(pass_index_gpu);
+                    ready = time_block.ComputeDuration();
+                }
+            }
 
-                    if (time_block.GetType() == TimeBlockType::Gpu)
-                    {
-                        pass_index_gpu += 2;
-                    }
+            if (!ready)
+                break;
+
+            // Publish, the read list keeps the indices of the write list
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_time_blocks_read.size()); i++)
+            {
+                if (i < frame.count)
+                {
+                    m_time_blocks_read[i] = frame.time_blocks[i];
+                    // Nullify GPU query objects as we don't want them to de-allocate twice (ring and read vectors).
+                    m_time_blocks_read[i].ClearGpuObjects();
                 }
-                else if (time_block.GetType() != TimeBlockType::Undefined) // If undefined, then it wasn't used this frame, nothing wrong with that.
+                else
                 {
-                    SP_LOG_WARNING("TimeBlockEnd() was not called for time block \"%s\"", time_block.GetName());
+                    m_time_blocks_read[i].Reset();
                 }
+            }
 
-                // Copy over
-                m_time_blocks_read[i] = time_block;
-                // Nullify GPU query objects as we don't want them to de-allocate twice (read and write vectors) once the profiler deconstructs.
-                m_time_blocks_read[i].ClearGpuObjects();
+            // Histories, with time blocks that share a name (e.g. one per light) summed up
+            m_time_block_frame_totals.clear();
+            for (uint32_t i = 0; i < frame.count; i++)
+            {
+                const TimeBlock& time_block = frame.time_blocks[i];
+                if (time_block.IsComplete() && time_block.GetType() == TimeBlockType::Gpu)
+                {
+                    m_time_block_frame_totals[time_block.GetName()] += time_block.GetDuration();
+                }
+            }
 
-                // Reset
-                time_block.Reset();
+            for (const auto& [name, duration] : m_time_block_frame_totals)
+            {
+                add_history_sample(m_time_block_histories[name], duration);
             }
+
+            release_gpu_frame(frame);
+            m_gpu_frame_oldest   = (m_gpu_frame_oldest + 1) % m_gpu_frames_capacity;
+            m_gpu_frame_resolved = true;
+            m_gpu_frame_pending--;
         }
-        
-        m_time_block_index = -1;
     }
 
     void Profiler::TimeBlockStart(const char* func_name, TimeBlockType type, RHI_CommandList* cmd_list /*= nullptr*/)
     {
-        if (!m_profile || !m_poll)
+        // Hitch detection needs the CPU scopes of every frame, even if nobody is looking at the profiler
+        if (!m_profile && !m_hitch_detection)
             return;
 
-        const bool can_profile_cpu = (type == TimeBlockType::Cpu) && m_profile_cpu;
-        const bool can_profile_gpu = (type == TimeBlockType::Gpu) && m_profile_gpu;
+        // CPU scopes are recorded every frame and on any thread, so that the ones which span frames show up as well
+        if (type == TimeBlockType::Cpu)
+        {
+            if (m_profile_cpu)
+            {
+                record_cpu_event(func_name);
+            }
+
+            return;
+        }
 
-        if (!can_profile_cpu && !can_profile_gpu)
+        if (!m_poll || !m_profile_gpu || type != TimeBlockType::Gpu)
             return;
 
         // Last incomplete block of the same type, is the parent
@@ -322,14 +943,124 @@ namespace Spartan
         }
     }
 
-    void Profiler::TimeBlockEnd()
+    void Profiler::TimeBlockEnd(TimeBlockType type /*= TimeBlockType::Cpu*/)
     {
-        if (TimeBlock* time_block = GetLastIncompleteTimeBlock())
+        if (type == TimeBlockType::Cpu)
+        {
+            // Ends are recorded even if profiling was disabled in the meantime, the scope has to close
+            if (m_thread_events_local)
+            {
+                record_cpu_event(nullptr);
+            }
+
+            return;
+        }
+
+        if (TimeBlock* time_block = GetLastIncompleteTimeBlock(type))
         {
             time_block->End();
         }
     }
 
+    void Profiler::MergeCpuEvents()
+    {
+        const uint64_t frame_end   = timestamp_now();
+        const uint64_t frame_start = m_timestamp_frame_start != 0 ? m_timestamp_frame_start : frame_end;
+        m_timestamp_frame_start    = frame_end;
+
+        // Calibrate against the steady clock, over everything since initialization, so it only gets more accurate
+        const double calibration_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - m_timestamp_calibration_time).count();
+        if (calibration_ms > 0.0 && frame_end > m_timestamp_calibration_ticks)
+        {
+            m_timestamp_ticks_per_ms = static_cast<double>(frame_end - m_timestamp_calibration_ticks) / calibration_ms;
+        }
+
+        auto to_ms = [frame_start](const uint64_t timestamp)
+        {
+            return static_cast<float>(static_cast<double>(static_cast<int64_t>(timestamp - frame_start)) / m_timestamp_ticks_per_ms);
+        };
+
+        // A capture begins with the first complete frame after it was requested
+        m_capture_frame_recorded = m_capture_frames_left > 0 && m_capture_started;
+        m_capture_started        = m_capture_frames_left > 0;
+
+        // The frame is traced for a capture and for hitch detection
+        m_trace_frame_recorded = m_capture_frame_recorded || m_hitch_detection;
+        m_trace_frame_start_us = trace_us(frame_start);
+        m_trace_frame_duration = to_ms(frame_end);
+        m_trace_frame.clear();
+
+        // Trace events are drained every frame, so that they are never stale
+        m_trace_events_frame.clear();
+        {
+            lock_guard lock(m_trace_events_mutex);
+            m_trace_events_frame.swap(m_trace_events);
+        }
+
+        // Timelines are only published when the profiler polls, the events are drained every frame regardless
+        const bool publish = m_profile && m_poll;
+        if (publish)
+        {
+            m_cpu_timelines.clear();
+            m_cpu_timeline_duration = to_ms(frame_end);
+        }
+
+        float time_cpu = 0.0f;
+
+        lock_guard lock(m_thread_events_mutex);
+        for (uint32_t thread_index = 0; thread_index < static_cast<uint32_t>(m_thread_events.size()); thread_index++)
+        {
+            ThreadEvents* events  = m_thread_events[thread_index].get();
+            CpuTimeline* timeline = nullptr;
+            if (publish)
+            {
+                timeline              = &m_cpu_timelines.emplace_back();
+                timeline->thread_name = events->name;
+            }
+
+            const uint64_t head = events->head.load(memory_order_acquire);
+            for (uint64_t i = events->tail.load(memory_order_relaxed); i < head; i++)
+            {
+                const CpuEvent& event = events->events[i & (ThreadEvents::capacity - 1)];
+
+                if (event.name)
+                {
+                    events->open.push_back({ event.name, event.timestamp });
+                    continue;
+                }
+
+                if (events->open.empty())
+                    continue;
+
+                const CpuScopeOpen scope = events->open.back();
+                events->open.pop_back();
+
+                const uint32_t depth = static_cast<uint32_t>(events->open.size());
+                const float duration = static_cast<float>(static_cast<double>(event.timestamp - scope.start) / m_timestamp_ticks_per_ms);
+
+                // Like before, the CPU time is the sum of the main thread's root scopes
+                if (events->is_main && depth == 0)
+                {
+                    time_cpu += duration;
+                }
+
+                if (timeline)
+                {
+                    timeline->scopes.push_back({ scope.name, to_ms(scope.start), duration, depth });
+                }
+
+                if (m_trace_frame_recorded)
+                {
+                    trace_append_scope(m_trace_frame, scope.name, trace_us(scope.start), static_cast<double>(duration) * 1000.0, thread_index);
+                }
+            }
+
+            events->tail.store(head, memory_order_release);
+        }
+
+        m_time_cpu_last = time_cpu;
+    }
+
     void Profiler::ClearMetrics()
     {
         m_time_frame_avg  = 0.0f;
@@ -366,6 +1097,34 @@ namespace Spartan
         return m_time_blocks_read;
     }
 
+    const TimeBlockHistory* Profiler::GetTimeBlockHistory(const char* name)
+    {
+        auto it = m_time_block_histories.find(name);
+        return it != m_time_block_histories.end() ? &it->second : nullptr;
+    }
+
+    const vector<CpuTimeline>& Profiler::GetCpuTimelines()
+    {
+        return m_cpu_timelines;
+    }
+
+    float Profiler::GetCpuTimelineDuration()
+    {
+        return m_cpu_timeline_duration;
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        // The event buffer is only created once the thread profiles something, so keep the name until then
+        m_thread_name_local = name;
+
+        if (m_thread_events_local)
+        {
+            lock_guard lock(m_thread_events_mutex);
+            m_thread_events_local->name = name;
+        }
+    }
+
     float Profiler::GetTimeCpuLast()
     {
         return m_time_cpu_last;
@@ -496,6 +1255,7 @@ namespace Spartan
             "\n"
             "CPU\n"
             "Worker threads: %d/%d\n"
+            "Events:\t\t\t%d/frame\n"
             // Resolution
             "\n"
             "Resolution\n"
@@ -519,7 +1279,9 @@ namespace Spartan
             "Meshes rendered:\t\t\t%d\n"
             "Textures:\t\t\t\t%d\n"
             "Materials:\t\t\t\t%d\n"
-            "Descriptor set capacity:\t%d/%d";
+            "Descriptor set capacity:\t%d/%d\n"
+            "Pending deletions:\t\t%d\n"
+            "Released this frame:\t\t%d";
 
         static char buffer[2048];
         sprintf
@@ -545,6 +1307,7 @@ namespace Spartan
             // CPU
             ThreadPool::GetWorkingThreadCount(),
             ThreadPool::GetThreadCount(),
+            EventBus::GetEventCountLast(),
 
             // Resolution
             static_cast<int>(Renderer::GetResolutionOutput().x), static_cast<int>(Renderer::GetResolutionOutput().y),
@@ -566,9 +1329,35 @@ namespace Spartan
             texture_count,
             material_count,
             m_descriptor_set_count,
-            m_descriptor_set_capacity
+            m_descriptor_set_capacity,
+            m_rhi_resources_pending,
+            m_rhi_resources_released
         );
 
         m_metrics = string(buffer);
+
+        // Memory
+        m_metrics += "\n\nMemory\t\t\t\tlive\t\tpeak\t\tallocations\n";
+        for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryTag::Max); i++)
+        {
+            const MemoryTag tag         = static_cast<MemoryTag>(i);
+            const MemoryTagStats& stats = MemoryTracker::GetStats(tag);
+
+            sprintf(buffer, "%-18s\t%7.2f\t%7.2f MB\t%u/frame%s\n",
+                MemoryTracker::GetTagName(tag),
+                static_cast<double>(stats.bytes_live + stats.bytes_gpu_live) / 1048576.0,
+                static_cast<double>(stats.bytes_peak) / 1048576.0,
+                stats.allocations_frame,
+                (stats.bytes_budget != 0 && stats.bytes_live + stats.bytes_gpu_live > stats.bytes_budget) ? " (over budget)" : ""
+            );
+            m_metrics += buffer;
+        }
+
+        sprintf(buffer, "Heap allocations\t%u/frame\nFrame allocator\t%.2f/%.2f MB",
+            MemoryTracker::GetAllocationsFrame(),
+            static_cast<double>(FrameAllocator::GetBytesAllocatedFrame()) / 1048576.0,
+            static_cast<double>(FrameAllocator::GetBytesCapacity()) / 1048576.0
+        );
+        m_metrics += buffer;
     }
 }
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===================
+#include <array>
 #include <string>
 #include <vector>
 #include "TimeBlock.h"
@@ -37,6 +38,36 @@ namespace Spartan
 {
     class Context;
 
+    // A completed CPU scope, times are relative to the start of the frame (scopes which began in an earlier frame start below zero)
+    struct CpuScope
+    {
+        const char* name = nullptr;
+        float start      = 0.0f;
+        float duration   = 0.0f;
+        uint32_t depth   = 0;
+    };
+
+    // The CPU scopes which a thread completed during the frame, in the order they ended
+    struct CpuTimeline
+    {
+        std::string thread_name;
+        std::vector<CpuScope> scopes;
+    };
+
+    // Rolling statistics of a GPU time block over its last sample_capacity frames (time blocks which share a name are summed per frame)
+    struct TimeBlockHistory
+    {
+        static constexpr uint32_t sample_capacity = 128;
+        std::array<float, sample_capacity> samples = {};
+        uint32_t sample_count = 0;
+        uint32_t sample_index = 0;
+        float last            = 0.0f;
+        float min             = 0.0f;
+        float avg             = 0.0f;
+        float max             = 0.0f;
+        float p99             = 0.0f;
+    };
+
     class SP_CLASS Profiler
     {
     public:
@@ -46,7 +77,7 @@ namespace Spartan
         static void PostTick();
 
         static void TimeBlockStart(const char* func_name, TimeBlockType type, RHI_CommandList* cmd_list = nullptr);
-        static void TimeBlockEnd();
+        static void TimeBlockEnd(TimeBlockType type = TimeBlockType::Cpu);
         static void ClearMetrics();
         
         // Properties
@@ -54,6 +85,23 @@ namespace Spartan
         static void SetEnabled(const bool enabled);
         static const std::string& GetMetrics();
         static const std::vector<TimeBlock>& GetTimeBlocks();
+        static const TimeBlockHistory* GetTimeBlockHistory(const char* name);
+        static const std::vector<CpuTimeline>& GetCpuTimelines();
+        static float GetCpuTimelineDuration();
+        static void SetThreadName(const char* name);
+
+        // Capture, records the next frame_count frames (CPU scopes of every thread, GPU time blocks, RHI counters and memory)
+        // and saves them as a Chrome trace, which chrome://tracing and ui.perfetto.dev can open.
+        static void StartCapture(uint32_t frame_count, const std::string& file_path = "profiler_capture.json");
+        static bool IsCapturing();
+
+        // Hitch detection, keeps a trace of the last frames and saves it (with the frames that follow) to hitch_<date>_<n>.json,
+        // whenever a frame takes longer than threshold_ms or median_multiple times the median frame time.
+        static void SetHitchDetection(bool enabled, float threshold_ms = 50.0f, float median_multiple = 3.0f);
+        static bool GetHitchDetection();
+
+        // Context for captures and hitch traces (resource loads, pipeline creations etc.), can be called from any thread
+        static void AddTraceEvent(const char* category, const std::string& name);
         static float GetTimeCpuLast();
         static float GetTimeGpuLast();
         static float GetTimeFrameLast();
@@ -84,6 +132,7 @@ namespace Spartan
         static uint32_t m_rhi_bindings_pipeline;
         static uint32_t m_rhi_pipeline_barriers;
         static uint32_t m_rhi_timeblock_count;
+        static uint32_t m_rhi_resources_released;
 
         // Metrics - Renderer
         static uint32_t m_renderer_meshes_rendered;
@@ -105,6 +154,7 @@ namespace Spartan
         // Memory
         static uint32_t m_descriptor_set_count;
         static uint32_t m_descriptor_set_capacity;
+        static uint32_t m_rhi_resources_pending;
 
     private:
         static void OnPostPresent();
@@ -130,8 +180,14 @@ namespace Spartan
             m_rhi_bindings_pipeline          = 0;
             m_rhi_pipeline_barriers          = 0;
             m_rhi_timeblock_count            = 0;
+            m_rhi_resources_released         = 0;
         }
 
+        static void MergeCpuEvents();
+        static void ResolveGpuFrames();
+        static void TraceFrame();
+        static void CaptureFrame();
+        static void DetectHitch();
         static TimeBlock* GetNewTimeBlock();
         static void AcquireGpuData();
         static void UpdateRhiMetricsString();
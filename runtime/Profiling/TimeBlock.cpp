@@ -66,6 +66,8 @@ namespace Spartan
                 Renderer::GetRhiDevice()->QueryCreate(&m_query_end, RHI_Query_Type::Timestamp);
             }
 
+            m_recording       = cmd_list->GetRecording();
+            m_timestamp_start = cmd_list->GetTimestampIndex();
             cmd_list->BeginTimestamp(m_query_start);
         }
     }
@@ -78,13 +80,14 @@ namespace Spartan
         }
         else if (m_type == TimeBlockType::Gpu)
         {
+            m_timestamp_end = m_cmd_list->GetTimestampIndex();
             m_cmd_list->EndTimestamp(m_query_end);
         }
 
         m_is_complete = true;
     }
 
-    void TimeBlock::ComputeDuration(const uint32_t pass_index)
+    bool TimeBlock::ComputeDuration()
     {
         // Ensure this time block has completed.
         SP_ASSERT(m_is_complete);
@@ -96,8 +99,16 @@ namespace Spartan
         }
         else if (m_type == TimeBlockType::Gpu)
         {
-            m_duration = m_cmd_list->GetTimestampDuration(m_query_start, m_query_end, pass_index);
+            // Returns false (without waiting) if the GPU hasn't executed the timestamps yet
+            float duration = 0.0f;
+            if (!m_cmd_list->GetTimestampDuration(m_query_start, m_query_end, m_recording, m_timestamp_start, m_timestamp_end, &duration))
+                return false;
+
+            // Negative if the results were lost
+            m_duration = Math::Helper::Max(duration, 0.0f);
         }
+
+        return true;
     }
 
     void TimeBlock::Reset()
@@ -46,7 +46,7 @@ namespace Spartan
 
         void Begin(const uint32_t id, const char* name, TimeBlockType type, const TimeBlock* parent = nullptr, RHI_CommandList* cmd_list = nullptr);
         void End();
-        void ComputeDuration(const uint32_t pass_index);
+        bool ComputeDuration();
         void Reset();
         TimeBlockType GetType()      const { return m_type; }
         const char* GetName()        const { return m_name; }
@@ -78,7 +78,10 @@ namespace Spartan
         std::chrono::high_resolution_clock::time_point m_end;
     
         // GPU timing
-        void* m_query_start = nullptr;
-        void* m_query_end   = nullptr;
+        void* m_query_start        = nullptr;
+        void* m_query_end          = nullptr;
+        uint64_t m_recording       = 0;
+        uint32_t m_timestamp_start = 0;
+        uint32_t m_timestamp_end   = 0;
     };
 }
@@ -63,6 +63,7 @@ namespace Spartan
     void RHI_CommandList::Begin()
     {
         m_state = RHI_CommandListState::Recording;
+        m_recording++;
     }
 
     void RHI_CommandList::End()
@@ -445,6 +446,11 @@ namespace Spartan
         Profiler::m_rhi_draw++;
     }
 
+    void RHI_CommandList::DrawIndexedIndirectCount(RHI_StructuredBuffer* argument_buffer, RHI_StructuredBuffer* count_buffer, const uint32_t max_draw_count)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
     void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async /*= false*/)
     {
         ID3D11Device5* device = Renderer::GetRhiDevice()->GetRhiContext()->device;
@@ -460,6 +466,19 @@ namespace Spartan
         device_context->CSSetUnorderedAccessViews(0, 8, reinterpret_cast<ID3D11UnorderedAccessView* const*>(&resource_array), nullptr);
     }
 
+    void RHI_CommandList::InsertMemoryBarrierIndirect()
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(RHI_Texture* texture, const RHI_Image_Layout layout)
+    {
+        SP_ASSERT(texture != nullptr);
+
+        // The driver tracks hazards, only the layout bookkeeping is kept in sync
+        texture->SetLayout(layout, this);
+    }
+
     void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
     {
         // Ensure restrictions based on: https://docs.microsoft.com/en-us/windows/win32/api/d3d11/nf-d3d11-id3d11devicecontext-copyresource
@@ -763,26 +782,34 @@ namespace Spartan
         Renderer::GetRhiDevice()->QueryEnd(query);
     }
 
-    float RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint32_t pass_index)
+    bool RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint64_t recording, const uint32_t index_start, const uint32_t index_end, float* duration_ms)
     {
         SP_ASSERT(query_start != nullptr);
         SP_ASSERT(query_end != nullptr);
+        SP_ASSERT(duration_ms != nullptr);
 
         RHI_Context* rhi_context = Renderer::GetRhiDevice()->GetRhiContext();
 
-        // Get start time
-        uint64_t start_time = 0; 
-        rhi_context->device_context->GetData(static_cast<ID3D11Query*>(query_start), &start_time, sizeof(start_time), 0);
+        // Don't flush or wait, S_FALSE means that the GPU hasn't got there yet
+        uint64_t start_time = 0;
+        uint64_t end_time   = 0;
+        if (rhi_context->device_context->GetData(static_cast<ID3D11Query*>(query_end), &end_time, sizeof(end_time), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_FALSE)
+            return false;
 
-        // Get end time
-        uint64_t end_time = 0;
-        rhi_context->device_context->GetData(static_cast<ID3D11Query*>(query_end), &end_time, sizeof(end_time), 0);
+        if (rhi_context->device_context->GetData(static_cast<ID3D11Query*>(query_start), &start_time, sizeof(start_time), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_FALSE)
+            return false;
 
         // Compute duration in ms
-        const uint64_t delta        = end_time - start_time;
-        const double duration_ms    = (delta * 1000.0) / static_cast<double>(Renderer::GetRhiDevice()->GetTimestampPeriod());
+        if (end_time < start_time)
+        {
+            *duration_ms = -1.0f;
+            return true;
+        }
+
+        const uint64_t delta = end_time - start_time;
+        *duration_ms         = static_cast<float>((delta * 1000.0) / static_cast<double>(Renderer::GetRhiDevice()->GetTimestampPeriod()));
 
-        return static_cast<float>(duration_ms);
+        return true;
     }
 
     uint32_t RHI_CommandList::GetGpuMemoryUsed()
@@ -846,8 +873,8 @@ namespace Spartan
         // Allowed to profile ?
         if (rhi_context->gpu_profiling)
         {
-            Profiler::TimeBlockEnd(); // cpu
-            Profiler::TimeBlockEnd(); // gpu
+            Profiler::TimeBlockEnd(TimeBlockType::Cpu);
+            Profiler::TimeBlockEnd(TimeBlockType::Gpu);
         }
     }
 
@@ -43,7 +43,7 @@ namespace Spartan
 
     void RHI_IndexBuffer::_create(const void* indices)
     {
-        const bool is_dynamic = indices == nullptr;
+        const bool is_dynamic = m_is_mappable;
 
         // Destroy previous buffer
         if (m_rhi_resource)
@@ -54,7 +54,7 @@ namespace Spartan
         D3D11_BUFFER_DESC buffer_desc;
         ZeroMemory(&buffer_desc, sizeof(buffer_desc));
         buffer_desc.ByteWidth           = m_stride * m_index_count;
-        buffer_desc.Usage               = is_dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_IMMUTABLE;
+        buffer_desc.Usage               = is_dynamic ? D3D11_USAGE_DYNAMIC : (indices ? D3D11_USAGE_IMMUTABLE : D3D11_USAGE_DEFAULT); // default usage for static buffers which are filled with Update()
         buffer_desc.CPUAccessFlags      = is_dynamic ? D3D11_CPU_ACCESS_WRITE : 0;
         buffer_desc.BindFlags           = D3D11_BIND_INDEX_BUFFER;
         buffer_desc.MiscFlags           = 0;
@@ -65,7 +65,7 @@ namespace Spartan
         init_data.SysMemPitch               = 0;
         init_data.SysMemSlicePitch          = 0;
 
-        SP_ASSERT(d3d11_utility::error_check(Renderer::GetRhiDevice()->GetRhiContext()->device->CreateBuffer(&buffer_desc, is_dynamic ? nullptr : &init_data, reinterpret_cast<ID3D11Buffer**>(&m_rhi_resource))));
+        SP_ASSERT(d3d11_utility::error_check(Renderer::GetRhiDevice()->GetRhiContext()->device->CreateBuffer(&buffer_desc, indices ? &init_data : nullptr, reinterpret_cast<ID3D11Buffer**>(&m_rhi_resource))));
     }
 
     void* RHI_IndexBuffer::Map()
@@ -88,4 +88,19 @@ namespace Spartan
 
         Renderer::GetRhiDevice()->GetRhiContext()->device_context->Unmap(static_cast<ID3D11Resource*>(m_rhi_resource), 0);
     }
+
+    void RHI_IndexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+        SP_ASSERT_MSG(!m_is_mappable, "Mappable buffers are written through Map()");
+        SP_ASSERT_MSG(offset + size <= m_object_size_gpu, "The range is out of bounds");
+
+        // The driver stages the range itself
+        D3D11_BOX box = {};
+        box.left      = static_cast<UINT>(offset);
+        box.right     = static_cast<UINT>(offset + size);
+        box.bottom    = 1;
+        box.back      = 1;
+
+        Renderer::GetRhiDevice()->GetRhiContext()->device_context->UpdateSubresource(static_cast<ID3D11Resource*>(m_rhi_resource), 0, &box, data, 0, 0);
+    }
 }
@@ -43,7 +43,7 @@ namespace Spartan
 
     void RHI_VertexBuffer::_create(const void* vertices)
     {
-        const bool is_dynamic = vertices == nullptr;
+        const bool is_dynamic = m_is_mappable;
 
         // Destroy previous buffer
         if (m_rhi_resource)
@@ -54,7 +54,7 @@ namespace Spartan
         // fill in a buffer description.
         D3D11_BUFFER_DESC buffer_desc   = {};
         buffer_desc.ByteWidth           = static_cast<UINT>(m_object_size_gpu);
-        buffer_desc.Usage               = is_dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_IMMUTABLE;
+        buffer_desc.Usage               = is_dynamic ? D3D11_USAGE_DYNAMIC : (vertices ? D3D11_USAGE_IMMUTABLE : D3D11_USAGE_DEFAULT); // default usage for static buffers which are filled with Update()
         buffer_desc.CPUAccessFlags      = is_dynamic ? D3D11_CPU_ACCESS_WRITE : 0;
         buffer_desc.BindFlags           = D3D11_BIND_VERTEX_BUFFER;
         buffer_desc.MiscFlags           = 0;
@@ -67,7 +67,7 @@ namespace Spartan
         init_data.SysMemSlicePitch       = 0;
 
         const auto ptr = reinterpret_cast<ID3D11Buffer**>(&m_rhi_resource);
-        SP_ASSERT(d3d11_utility::error_check(Renderer::GetRhiDevice()->GetRhiContext()->device->CreateBuffer(&buffer_desc, is_dynamic ? nullptr : &init_data, ptr)));
+        SP_ASSERT(d3d11_utility::error_check(Renderer::GetRhiDevice()->GetRhiContext()->device->CreateBuffer(&buffer_desc, vertices ? &init_data : nullptr, ptr)));
     }
 
     void* RHI_VertexBuffer::Map()
@@ -93,4 +93,19 @@ namespace Spartan
         // Re-enable GPU access to the vertex buffer data.
         Renderer::GetRhiDevice()->GetRhiContext()->device_context->Unmap(static_cast<ID3D11Resource*>(m_rhi_resource), 0);
     }
+
+    void RHI_VertexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+        SP_ASSERT_MSG(!m_is_mappable, "Mappable buffers are written through Map()");
+        SP_ASSERT_MSG(offset + size <= m_object_size_gpu, "The range is out of bounds");
+
+        // The driver stages the range itself
+        D3D11_BOX box = {};
+        box.left      = static_cast<UINT>(offset);
+        box.right     = static_cast<UINT>(offset + size);
+        box.bottom    = 1;
+        box.back      = 1;
+
+        Renderer::GetRhiDevice()->GetRhiContext()->device_context->UpdateSubresource(static_cast<ID3D11Resource*>(m_rhi_resource), 0, &box, data, 0, 0);
+    }
 }
@@ -191,6 +191,11 @@ namespace Spartan
         // Profile
         Profiler::m_rhi_draw++;
     }
+
+    void RHI_CommandList::DrawIndexedIndirectCount(RHI_StructuredBuffer* argument_buffer, RHI_StructuredBuffer* count_buffer, const uint32_t max_draw_count)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
   
     void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z, bool async /*= false*/)
     {
@@ -207,6 +212,16 @@ namespace Spartan
         Profiler::m_rhi_dispatch++;
     }
 
+    void RHI_CommandList::InsertMemoryBarrierIndirect()
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(RHI_Texture* texture, const RHI_Image_Layout layout)
+    {
+        SP_ASSERT_MSG(false, "Function is not implemented");
+    }
+
     void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
     {
         SP_ASSERT_MSG(false, "Function is not implemented");
@@ -322,9 +337,10 @@ namespace Spartan
         SP_ASSERT_MSG(false, "Function is not implemented");
     }
 
-    float RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint32_t pass_index)
+    bool RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint64_t recording, const uint32_t index_start, const uint32_t index_end, float* duration_ms)
     {
-        return 0.0f;
+        *duration_ms = 0.0f;
+        return true;
     }
 
     uint32_t RHI_CommandList::GetGpuMemoryUsed()
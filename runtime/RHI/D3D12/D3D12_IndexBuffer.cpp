@@ -84,4 +84,9 @@ namespace Spartan
     {
 
     }
+
+    void RHI_IndexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+
+    }
 }
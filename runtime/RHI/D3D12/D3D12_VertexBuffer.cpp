@@ -82,4 +82,9 @@ namespace Spartan
     {
 
     }
+
+    void RHI_VertexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+
+    }
 }
@@ -0,0 +1,527 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==========================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_StructuredBuffer.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_DescriptorSet.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Fence.h"
+#include "../RHI_Shader.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Texture.h"
+#include "../RHI_CommandPool.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Rendering/Renderer.h"
+#include "../../Core/FrameAllocator.h"
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    unordered_map<uint64_t, shared_ptr<RHI_Pipeline>> RHI_CommandList::m_pipelines;
+
+    RHI_CommandList::RHI_CommandList(const RHI_Queue_Type queue_type, const uint32_t index, void* cmd_pool, const char* name) : Object()
+    {
+        m_queue_type   = queue_type;
+        m_name         = name;
+        m_index        = index;
+        m_rhi_resource = null_utility::handle::create();
+        m_timestamps.fill(0);
+
+        // Sync objects
+        m_proccessed_fence     = make_shared<RHI_Fence>(name);
+        m_proccessed_semaphore = make_shared<RHI_Semaphore>(false, name);
+    }
+
+    RHI_CommandList::~RHI_CommandList()
+    {
+
+    }
+
+    void RHI_CommandList::Begin()
+    {
+        m_discard = false;
+
+        // Validate command list state
+        SP_ASSERT(m_state == RHI_CommandListState::Idle);
+
+        m_timestamp_index = 0;
+
+        // Update states
+        m_state          = RHI_CommandListState::Recording;
+        m_pipeline_dirty = true;
+    }
+
+    void RHI_CommandList::End()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (swapchain_to_transition)
+        {
+            swapchain_to_transition->SetLayout(RHI_Image_Layout::Present_Src, this);
+            swapchain_to_transition = nullptr;
+        }
+
+        m_state = RHI_CommandListState::Ended;
+    }
+
+    void RHI_CommandList::Submit()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Ended);
+
+        if (!m_discard)
+        {
+            Renderer::GetRhiDevice()->QueueSubmit(
+                m_queue_type,                 // queue
+                0,                            // wait flags
+                m_rhi_resource,               // cmd buffer
+                nullptr,                      // wait semaphore
+                m_proccessed_semaphore.get(), // signal semaphore
+                m_proccessed_fence.get()      // signal fence
+            );
+        }
+
+        m_state = RHI_CommandListState::Submitted;
+    }
+
+    void RHI_CommandList::SetPipelineState(RHI_PipelineState& pso)
+    {
+        SP_ASSERT_MSG(pso.IsValid(), "Invalide pipeline state");
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Update the descriptor cache with the pipeline state
+        GetDescriptorSetLayoutFromPipelineState(pso);
+
+        // If no pipeline exists for this state, create one
+        uint64_t hash_previous = m_pso.ComputeHash();
+        uint64_t hash = pso.ComputeHash();
+        auto it = m_pipelines.find(hash);
+        if (it == m_pipelines.end())
+        {
+            // Create a new pipeline
+            it = m_pipelines.emplace(make_pair(hash, move(make_shared<RHI_Pipeline>(pso, m_descriptor_layout_current)))).first;
+            SP_LOG_INFO("A new pipeline has been created.");
+        }
+
+        m_pipeline = it->second.get();
+        m_pso      = pso;
+
+        // Determine if the pipeline is dirty
+        if (!m_pipeline_dirty)
+        {
+            m_pipeline_dirty = hash_previous != hash;
+        }
+
+        // Bind pipeline
+        if (m_pipeline_dirty)
+        {
+            Profiler::m_rhi_bindings_pipeline++;
+
+            m_pipeline_dirty = false;
+
+            // Also, If the pipeline changed, resources have to be set again
+            m_vertex_buffer_id = 0;
+            m_index_buffer_id  = 0;
+        }
+    }
+
+    void RHI_CommandList::BeginRenderPass()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG(m_pso.IsGraphics(), "You can't use a render pass with a compute pipeline");
+        SP_ASSERT_MSG(!m_is_rendering, "The command list is already rendering");
+
+        if (!m_pso.IsGraphics())
+            return;
+
+        // Transition the attachments, this is where most of the barriers of a frame come from
+        if (RHI_SwapChain* swapchain = m_pso.render_target_swapchain)
+        {
+            swapchain_to_transition = swapchain;
+            swapchain->SetLayout(RHI_Image_Layout::Color_Attachment_Optimal, this);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                RHI_Texture* rt = m_pso.render_target_color_textures[i];
+
+                if (rt == nullptr)
+                    break;
+
+                SP_ASSERT_MSG(rt->IsRenderTargetColor(), "The texture wasn't created with the RHI_Texture_RenderTarget flag and/or isn't a color format");
+                rt->SetLayout(RHI_Image_Layout::Color_Attachment_Optimal, this);
+            }
+        }
+
+        if (RHI_Texture* rt = m_pso.render_target_depth_texture)
+        {
+            SP_ASSERT(rt->IsRenderTargetDepthStencil());
+
+            RHI_Image_Layout layout = rt->IsStencilFormat() ? RHI_Image_Layout::Depth_Stencil_Attachment_Optimal : RHI_Image_Layout::Depth_Attachment_Optimal;
+            if (m_pso.render_target_depth_texture_read_only)
+            {
+                layout = RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal;
+            }
+            rt->SetLayout(layout, this);
+        }
+
+        m_is_rendering = true;
+    }
+
+    void RHI_CommandList::EndRenderPass()
+    {
+        m_is_rendering = false;
+    }
+
+    void RHI_CommandList::ClearPipelineStateRenderTargets(RHI_PipelineState& pipeline_state)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::ClearRenderTarget(RHI_Texture* texture,
+        const uint32_t color_index          /*= 0*/,
+        const uint32_t depth_stencil_index  /*= 0*/,
+        const bool storage                  /*= false*/,
+        const Color& clear_color            /*= rhi_color_load*/,
+        const float clear_depth             /*= rhi_depth_load*/,
+        const uint32_t clear_stencil        /*= rhi_stencil_load*/
+    )
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG((texture->GetFlags() & RHI_Texture_ClearOrBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+
+        // One of the required layouts for clear functions
+        texture->SetLayout(RHI_Image_Layout::Transfer_Dst_Optimal, this);
+    }
+
+    void RHI_CommandList::Draw(const uint32_t vertex_count, uint32_t vertex_start_index /*= 0*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to draw
+        OnDraw();
+
+        Profiler::m_rhi_draw++;
+    }
+
+    void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to draw
+        OnDraw();
+
+        Profiler::m_rhi_draw++;
+    }
+
+    void RHI_CommandList::DrawIndexedIndirectCount(RHI_StructuredBuffer* argument_buffer, RHI_StructuredBuffer* count_buffer, const uint32_t max_draw_count)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(argument_buffer != nullptr && count_buffer != nullptr);
+
+        // Ensure correct state before attempting to draw
+        OnDraw();
+
+        Profiler::m_rhi_draw++;
+    }
+
+    void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/, bool async /*= false*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Ensure correct state before attempting to dispatch
+        OnDraw();
+
+        Profiler::m_rhi_dispatch++;
+    }
+
+    void RHI_CommandList::InsertMemoryBarrierIndirect()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(RHI_Texture* texture, const RHI_Image_Layout layout)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG(!m_is_rendering, "Barriers can't be inserted within a render pass");
+        SP_ASSERT(texture != nullptr);
+
+        for (uint32_t i = 0; i < texture->GetMipCount(); i++)
+        {
+            if (texture->GetLayout(i) != layout)
+            {
+                texture->SetLayout(layout, this);
+                return;
+            }
+        }
+
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
+    {
+        SP_ASSERT(source != nullptr);
+        SP_ASSERT(destination != nullptr);
+        SP_ASSERT(source->GetRhiResource() != destination->GetRhiResource());
+        SP_ASSERT_MSG((source->GetFlags() & RHI_Texture_ClearOrBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+        SP_ASSERT_MSG((destination->GetFlags() & RHI_Texture_ClearOrBlit) != 0, "The texture needs the RHI_Texture_ClearOrBlit flag");
+
+        // Save the initial layouts
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_source      = source->GetLayouts();
+        array<RHI_Image_Layout, rhi_max_mip_count> layouts_initial_destination = destination->GetLayouts();
+
+        // Transition to blit appropriate layouts
+        source->SetLayout(RHI_Image_Layout::Transfer_Src_Optimal,      this);
+        destination->SetLayout(RHI_Image_Layout::Transfer_Dst_Optimal, this);
+
+        // Transition to the initial layouts
+        source->SetLayout(layouts_initial_source[0], this);
+        destination->SetLayout(layouts_initial_destination[0], this);
+    }
+
+    void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Skip if already set
+        if (m_vertex_buffer_id == buffer->GetObjectId())
+            return;
+
+        m_vertex_buffer_id = buffer->GetObjectId();
+
+        Profiler::m_rhi_bindings_buffer_vertex++;
+    }
+
+    void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Skip if already set
+        if (m_index_buffer_id == buffer->GetObjectId())
+            return;
+
+        m_index_buffer_id = buffer->GetObjectId();
+
+        Profiler::m_rhi_bindings_buffer_index++;
+    }
+
+    void RHI_CommandList::SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+            return;
+
+        m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer);
+    }
+
+    void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+            return;
+
+        m_descriptor_layout_current->SetSampler(slot, sampler);
+    }
+
+    void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const uint32_t mip_index /*= all_mips*/, uint32_t mip_range /*= 0*/, const bool uav /*= false*/)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (mip_index != rhi_all_mips)
+        {
+            SP_ASSERT_MSG(mip_range != 0, "If a mip was specified, then mip_range can't be 0");
+        }
+
+        // If the texture is null or it's still loading, ignore it.
+        if (!m_descriptor_layout_current || !texture || !texture->IsReadyForUse())
+            return;
+
+        // Transition to the same layouts that a real API would
+        RHI_Image_Layout target_layout = RHI_Image_Layout::Undefined;
+        if (uav)
+        {
+            SP_ASSERT(texture->IsUav());
+            target_layout = RHI_Image_Layout::General;
+        }
+        else
+        {
+            SP_ASSERT(texture->IsSrv());
+            target_layout = texture->IsDepthFormat() ? RHI_Image_Layout::Depth_Stencil_Read_Only_Optimal : RHI_Image_Layout::Shader_Read_Only_Optimal;
+        }
+
+        texture->SetLayout(target_layout, this, mip_index, mip_range);
+
+        m_descriptor_layout_current->SetTexture(slot, texture, mip_index, mip_range);
+    }
+
+    void RHI_CommandList::SetStructuredBuffer(const uint32_t slot, RHI_StructuredBuffer* structured_buffer) const
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        if (!m_descriptor_layout_current)
+            return;
+
+        m_descriptor_layout_current->SetStructuredBuffer(slot, structured_buffer);
+    }
+
+    uint32_t RHI_CommandList::GetGpuMemoryUsed()
+    {
+        return static_cast<uint32_t>(null_utility::stats::GetMemoryUsed() / 1024 / 1024); // MBs
+    }
+
+    void RHI_CommandList::BeginMarker(const char* name)
+    {
+
+    }
+
+    void RHI_CommandList::EndMarker()
+    {
+
+    }
+
+    void RHI_CommandList::BeginTimestamp(void* query)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    void RHI_CommandList::EndTimestamp(void* query)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+    }
+
+    bool RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint64_t recording, const uint32_t index_start, const uint32_t index_end, float* duration_ms)
+    {
+        *duration_ms = 0.0f;
+        return true;
+    }
+
+    void RHI_CommandList::BeginTimeblock(const char* name, const bool gpu_marker, const bool gpu_timing)
+    {
+        SP_ASSERT_MSG(m_timeblock_active == nullptr, "The previous time block is still active");
+        SP_ASSERT(name != nullptr);
+
+        // Only the cpu side of a time block is meaningful
+        if (Renderer::GetRhiDevice()->GetRhiContext()->gpu_profiling && gpu_timing)
+        {
+            Profiler::TimeBlockStart(name, TimeBlockType::Cpu, this);
+        }
+
+        m_timeblock_active = name;
+    }
+
+    void RHI_CommandList::EndTimeblock()
+    {
+        SP_ASSERT_MSG(m_timeblock_active != nullptr, "A time block wasn't started");
+
+        if (Renderer::GetRhiDevice()->GetRhiContext()->gpu_profiling)
+        {
+            Profiler::TimeBlockEnd();
+        }
+
+        m_timeblock_active = nullptr;
+    }
+
+    void RHI_CommandList::OnDraw()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+
+        // Resolve descriptor sets, this is CPU work that every API has to do
+        Renderer::SetGlobalShaderResources(this);
+
+        if (m_descriptor_layout_current->GetDescriptorSet())
+        {
+            static vector<uint32_t> dynamic_offsets;
+            m_descriptor_layout_current->GetDynamicOffsets(&dynamic_offsets);
+
+            Profiler::m_rhi_bindings_descriptor_set++;
+        }
+    }
+
+    void RHI_CommandList::UnbindOutputTextures()
+    {
+
+    }
+
+    void RHI_CommandList::GetDescriptorSetLayoutFromPipelineState(RHI_PipelineState& pipeline_state)
+    {
+        // Get pipeline
+        pmr::vector<RHI_Descriptor> descriptors = frame_vector<RHI_Descriptor>();
+        GetDescriptorsFromPipelineState(pipeline_state, descriptors);
+
+        // Compute a hash for the descriptors
+        uint64_t hash = 0;
+        for (const RHI_Descriptor& descriptor : descriptors)
+        {
+            hash = rhi_hash_combine(hash, descriptor.ComputeHash());
+        }
+
+        // Search for a descriptor set layout which matches this hash
+        auto it     = m_descriptor_set_layouts.find(hash);
+        bool cached = it != m_descriptor_set_layouts.end();
+
+        // If there is no descriptor set layout for this particular hash, create one
+        if (!cached)
+        {
+            string name  = "CS:" + (pipeline_state.shader_compute ? pipeline_state.shader_compute->GetName() : "null");
+            name        += "-VS:" + (pipeline_state.shader_vertex ? pipeline_state.shader_vertex->GetName()  : "null");
+            name        += "-PS:" + (pipeline_state.shader_pixel  ? pipeline_state.shader_pixel->GetName()   : "null");
+
+            it = m_descriptor_set_layouts.emplace(make_pair(hash, make_shared<RHI_DescriptorSetLayout>(vector<RHI_Descriptor>(descriptors.begin(), descriptors.end()), name.c_str()))).first;
+        }
+
+        m_descriptor_layout_current = it->second.get();
+
+        // Clear any data data the the descriptors might contain from previous uses
+        if (cached)
+        {
+            m_descriptor_layout_current->ClearDescriptorData();
+        }
+
+        m_descriptor_layout_current->NeedsToBind();
+    }
+}
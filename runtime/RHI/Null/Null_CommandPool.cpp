@@ -0,0 +1,67 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_CommandPool.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Implementation.h"
+#include "../Rendering/Renderer.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_CommandPool::RHI_CommandPool(const char* name, const uint64_t swap_chain_id) : Object()
+    {
+        m_name          = name;
+        m_swap_chain_id = swap_chain_id;
+    }
+
+    RHI_CommandPool::~RHI_CommandPool()
+    {
+        for (shared_ptr<RHI_CommandList>& cmd_list : m_cmd_lists)
+        {
+            cmd_list = nullptr;
+        }
+
+        for (void*& resource : m_rhi_resources)
+        {
+            resource = nullptr;
+        }
+    }
+
+    void RHI_CommandPool::CreateCommandPool(const RHI_Queue_Type queue_type)
+    {
+        m_queue_type = queue_type;
+
+        m_rhi_resources.emplace_back(null_utility::handle::create());
+    }
+
+    void RHI_CommandPool::Reset(const uint32_t pool_index)
+    {
+        SP_ASSERT_MSG(m_rhi_resources[0] != nullptr, "Can't reset an uninitialised command list pool");
+    }
+}
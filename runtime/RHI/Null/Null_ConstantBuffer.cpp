@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ========================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_Device.h"
+#include "../../Rendering/Renderer.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_ConstantBuffer::RHI_ConstantBuffer(const string& name)
+    {
+        m_name = name;
+    }
+
+    RHI_ConstantBuffer::~RHI_ConstantBuffer()
+    {
+        if (m_rhi_resource)
+        {
+            Renderer::AddToDeletionQueue(RHI_Resource_Type::buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+
+    void RHI_ConstantBuffer::_create()
+    {
+        // Destroy previous buffer
+        if (m_rhi_resource)
+        {
+            Renderer::AddToDeletionQueue(RHI_Resource_Type::buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+
+        // Calculate required alignment based on minimum device offset alignment
+        size_t min_alignment = Renderer::GetRhiDevice()->GetMinUniformBufferOffsetAllignment();
+        if (min_alignment > 0)
+        {
+            m_stride = static_cast<uint64_t>((m_stride + min_alignment - 1) & ~(min_alignment - 1));
+        }
+        m_object_size_gpu = m_stride * m_element_count;
+
+        // Create buffer
+        Renderer::GetRhiDevice()->CreateBuffer(m_rhi_resource, m_object_size_gpu, 0, null_utility::memory_property_host_visible);
+
+        // Get mapped data pointer
+        m_mapped_data = Renderer::GetRhiDevice()->GetMappedDataFromBuffer(m_rhi_resource);
+    }
+
+    void RHI_ConstantBuffer::Update(void* data_cpu)
+    {
+        SP_ASSERT_MSG(data_cpu != nullptr,                      "Invalid update data");
+        SP_ASSERT_MSG(m_mapped_data != nullptr,                 "Invalid mapped data");
+        SP_ASSERT_MSG(m_offset + m_stride <= m_object_size_gpu, "Out of memory");
+
+        // Advance offset
+        m_offset += m_stride;
+        if (m_reset_offset)
+        {
+            m_offset       = 0;
+            m_reset_offset = false;
+        }
+
+        // Keep the copy, it's part of the CPU cost of a real backend
+        memcpy(reinterpret_cast<std::byte*>(m_mapped_data) + m_offset, reinterpret_cast<std::byte*>(data_cpu), m_stride);
+        Renderer::GetRhiDevice()->FlushAllocation(m_rhi_resource, m_offset, m_stride);
+    }
+}
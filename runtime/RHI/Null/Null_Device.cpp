@@ -0,0 +1,324 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ======================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Fence.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_CommandPool.h"
+#include "../../Profiling/Profiler.h"
+//=================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    RHI_Device::RHI_Device(shared_ptr<RHI_Context> rhi_context)
+    {
+        m_rhi_context                      = rhi_context;
+        null_utility::globals::rhi_context = rhi_context.get();
+        null_utility::globals::rhi_device  = this;
+
+        // Device limits (the minimums that the Vulkan spec guarantees)
+        m_max_texture_1d_dimension            = 16384;
+        m_max_texture_2d_dimension            = 16384;
+        m_max_texture_3d_dimension            = 2048;
+        m_max_texture_cube_dimension          = 16384;
+        m_max_texture_array_layers            = 2048;
+        m_min_uniform_buffer_offset_alignment = 256;
+        m_min_storage_buffer_offset_alignment = 256;
+        m_timestamp_period                    = 1.0f;
+
+        // Find a physical device
+        SP_ASSERT_MSG(DetectPhysicalDevices(), "Failed to detect any devices");
+        SelectPrimaryPhysicalDevice();
+
+        // Queues only need to be non-null
+        m_queue_graphics = null_utility::handle::create();
+        m_queue_compute  = null_utility::handle::create();
+        m_queue_copy     = null_utility::handle::create();
+
+        // Set the descriptor set capacity to an initial value
+        SetDescriptorSetCapacity(2048);
+
+        m_rhi_context->api_version_str = "1.0.0";
+        SP_LOG_INFO("Null RHI, no GPU commands will be executed");
+    }
+
+    RHI_Device::~RHI_Device()
+    {
+        SP_ASSERT(m_rhi_context != nullptr);
+
+        QueueWaitAll();
+
+        // Destroy command pools
+        m_cmd_pools.clear();
+        m_cmd_pools_immediate.fill(nullptr);
+
+        SP_LOG_INFO(
+            "Submits: %llu, presents: %llu, pipelines: %llu, descriptor sets: %llu, uploaded: %.2f MB",
+            static_cast<unsigned long long>(null_utility::stats::queue_submits.load()),
+            static_cast<unsigned long long>(null_utility::stats::queue_presents.load()),
+            static_cast<unsigned long long>(null_utility::stats::pipeline_count.load()),
+            static_cast<unsigned long long>(null_utility::stats::descriptor_set_count.load()),
+            static_cast<double>(null_utility::stats::bytes_uploaded.load()) / 1024.0 / 1024.0
+        );
+
+        // Release whatever is left, the engine might still be holding on to some buffers
+        for (auto& it : m_allocations)
+        {
+            null_utility::allocation* allocation = static_cast<null_utility::allocation*>(it.second);
+            delete[] allocation->data;
+            delete allocation;
+        }
+        m_allocations.clear();
+    }
+
+    bool RHI_Device::DetectPhysicalDevices()
+    {
+        RegisterPhysicalDevice(PhysicalDevice
+        (
+            1 << 22,                      // api version
+            0,                            // driver version
+            0,                            // vendor id
+            RHI_PhysicalDevice_Type::Cpu, // type
+            "Null",                       // name
+            0,                            // memory
+            nullptr                       // data
+        ));
+
+        return true;
+    }
+
+    void RHI_Device::SelectPrimaryPhysicalDevice()
+    {
+        SetPrimaryPhysicalDevice(0);
+    }
+
+    void RHI_Device::QueuePresent(void* swapchain, uint32_t* image_index, vector<RHI_Semaphore*>& wait_semaphores)
+    {
+        for (RHI_Semaphore* semaphore : wait_semaphores)
+        {
+            semaphore->SetCpuState(RHI_Sync_State::Idle);
+        }
+
+        null_utility::stats::queue_presents++;
+    }
+
+    void RHI_Device::QueueSubmit(const RHI_Queue_Type type, const uint32_t wait_flags, void* cmd_buffer, RHI_Semaphore* wait_semaphore /*= nullptr*/, RHI_Semaphore* signal_semaphore /*= nullptr*/, RHI_Fence* signal_fence /*= nullptr*/)
+    {
+        SP_ASSERT_MSG(cmd_buffer != nullptr, "Invalid command buffer");
+
+        // Validate semaphores, the same way a real API would
+        if (wait_semaphore)   SP_ASSERT_MSG(wait_semaphore->GetCpuState()   != RHI_Sync_State::Idle,      "Wait semaphore is in an idle state and will never be signaled");
+        if (signal_semaphore) SP_ASSERT_MSG(signal_semaphore->GetCpuState() != RHI_Sync_State::Submitted, "Signal semaphore is already in a signaled state.");
+        if (signal_fence)     SP_ASSERT_MSG(signal_fence->GetCpuState()     != RHI_Sync_State::Submitted, "Signal fence is already in a signaled state.");
+
+        // Update semaphore states
+        if (wait_semaphore)   wait_semaphore->SetCpuState(RHI_Sync_State::Idle);
+        if (signal_semaphore) signal_semaphore->SetCpuState(RHI_Sync_State::Submitted);
+        if (signal_fence)     signal_fence->SetCpuState(RHI_Sync_State::Submitted);
+
+        null_utility::stats::queue_submits++;
+    }
+
+    void RHI_Device::QueueWait(const RHI_Queue_Type type)
+    {
+        // Work completes the moment it's submitted
+    }
+
+    void RHI_Device::QueryCreate(void** query, const RHI_Query_Type type)
+    {
+
+    }
+
+    void RHI_Device::QueryRelease(void*& query)
+    {
+
+    }
+
+    void RHI_Device::QueryBegin(void* query)
+    {
+
+    }
+
+    void RHI_Device::QueryEnd(void* query)
+    {
+
+    }
+
+    void RHI_Device::QueryGetData(void* query)
+    {
+
+    }
+
+    void RHI_Device::ParseDeletionQueue(const unordered_map<RHI_Resource_Type, vector<void*>>& deletion_queue)
+    {
+        for (const auto& it : deletion_queue)
+        {
+            // Views, samplers and shaders are plain handles, only buffers and textures own memory
+            if (it.first == RHI_Resource_Type::texture)
+            {
+                for (void* resource : it.second)
+                {
+                    DestroyTexture(resource);
+                }
+            }
+            else if (it.first == RHI_Resource_Type::buffer)
+            {
+                for (void* resource : it.second)
+                {
+                    DestroyBuffer(resource);
+                }
+            }
+        }
+    }
+
+    void RHI_Device::SetDescriptorSetCapacity(uint32_t descriptor_set_capacity)
+    {
+        // If the requested capacity is zero, then only recreate the descriptor pool
+        if (descriptor_set_capacity == 0)
+        {
+            descriptor_set_capacity = m_descriptor_set_capacity;
+        }
+
+        m_descriptor_pool         = null_utility::handle::create();
+        m_descriptor_set_capacity = descriptor_set_capacity;
+
+        Profiler::m_descriptor_set_count    = 0;
+        Profiler::m_descriptor_set_capacity = m_descriptor_set_capacity;
+    }
+
+    void* RHI_Device::GetAllocationFromResource(void* resource)
+    {
+        auto it = m_allocations.find(reinterpret_cast<uint64_t>(resource));
+        return it != m_allocations.end() ? it->second : nullptr;
+    }
+
+    void* RHI_Device::GetMappedDataFromBuffer(void* resource)
+    {
+        if (null_utility::allocation* allocation = static_cast<null_utility::allocation*>(GetAllocationFromResource(resource)))
+        {
+            return allocation->data;
+        }
+
+        return nullptr;
+    }
+
+    void RHI_Device::CreateBuffer(void*& resource, const uint64_t size, uint32_t usage, uint32_t memory_property_flags, const void* data_initial /* = nullptr */)
+    {
+        bool is_mappable = (memory_property_flags & null_utility::memory_property_host_visible) != 0;
+
+        // Only mappable buffers get backing memory, the engine writes into those directly
+        null_utility::allocation* allocation = new null_utility::allocation();
+        allocation->size                     = size;
+        allocation->data                     = is_mappable ? new std::byte[size] : nullptr;
+
+        if (data_initial != nullptr)
+        {
+            if (allocation->data)
+            {
+                memcpy(allocation->data, data_initial, size);
+            }
+
+            null_utility::stats::bytes_uploaded += size;
+        }
+
+        resource = static_cast<void*>(allocation);
+
+        null_utility::stats::buffer_count++;
+        null_utility::stats::buffer_bytes += size;
+
+        // Keep allocation reference
+        lock_guard<mutex> lock(m_mutex_allocation);
+        m_allocations[reinterpret_cast<uint64_t>(resource)] = allocation;
+    }
+
+    void RHI_Device::DestroyBuffer(void*& resource)
+    {
+        SP_ASSERT_MSG(resource != nullptr, "Resource is null");
+
+        lock_guard<mutex> lock(m_mutex_allocation);
+        if (null_utility::allocation* allocation = static_cast<null_utility::allocation*>(GetAllocationFromResource(resource)))
+        {
+            null_utility::stats::buffer_count--;
+            null_utility::stats::buffer_bytes -= allocation->size;
+
+            m_allocations.erase(reinterpret_cast<uint64_t>(resource));
+            delete[] allocation->data;
+            delete allocation;
+            resource = nullptr;
+        }
+    }
+
+    void RHI_Device::CreateTexture(void* size_in_bytes, void*& resource)
+    {
+        // Textures are never sampled on the CPU, so only their size is tracked
+        null_utility::allocation* allocation = new null_utility::allocation();
+        allocation->size                     = *static_cast<uint64_t*>(size_in_bytes);
+        resource                             = static_cast<void*>(allocation);
+
+        null_utility::stats::texture_count++;
+        null_utility::stats::texture_bytes += allocation->size;
+
+        // Keep allocation reference
+        lock_guard<mutex> lock(m_mutex_allocation);
+        m_allocations[reinterpret_cast<uint64_t>(resource)] = allocation;
+    }
+
+    void RHI_Device::DestroyTexture(void*& resource)
+    {
+        SP_ASSERT_MSG(resource != nullptr, "Resource is null");
+
+        lock_guard<mutex> lock(m_mutex_allocation);
+        if (null_utility::allocation* allocation = static_cast<null_utility::allocation*>(GetAllocationFromResource(resource)))
+        {
+            null_utility::stats::texture_count--;
+            null_utility::stats::texture_bytes -= allocation->size;
+
+            m_allocations.erase(reinterpret_cast<uint64_t>(resource));
+            delete allocation;
+            resource = nullptr;
+        }
+    }
+
+    void RHI_Device::MapMemory(void* resource, void*& mapped_data)
+    {
+        mapped_data = GetMappedDataFromBuffer(resource);
+    }
+
+    void RHI_Device::UnmapMemory(void* resource, void*& mapped_data)
+    {
+        SP_ASSERT_MSG(mapped_data, "Memory is already unmapped");
+        mapped_data = nullptr;
+    }
+
+    void RHI_Device::FlushAllocation(void* resource, uint64_t offset, uint64_t size)
+    {
+        null_utility::stats::bytes_uploaded += size;
+    }
+}
@@ -0,0 +1,99 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_Implementation.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // Timeline semaphores keep their counter in an atomic, binary semaphores are just a handle
+    static void create_semaphore(const bool is_timeline, void*& resource)
+    {
+        SP_ASSERT(resource == nullptr);
+
+        resource = is_timeline ? static_cast<void*>(new atomic<uint64_t>(0)) : null_utility::handle::create();
+    }
+
+    static void destroy_semaphore(const bool is_timeline, void*& resource)
+    {
+        if (!resource)
+            return;
+
+        if (is_timeline)
+        {
+            delete static_cast<atomic<uint64_t>*>(resource);
+        }
+
+        resource = nullptr;
+    }
+
+    RHI_Semaphore::RHI_Semaphore(bool is_timeline /*= false*/, const char* name /*= nullptr*/)
+    {
+        m_is_timeline = is_timeline;
+
+        create_semaphore(m_is_timeline, m_resource);
+
+        if (name)
+        {
+            m_name = name;
+        }
+    }
+
+    RHI_Semaphore::~RHI_Semaphore()
+    {
+        destroy_semaphore(m_is_timeline, m_resource);
+    }
+
+    void RHI_Semaphore::Reset()
+    {
+        destroy_semaphore(m_is_timeline, m_resource);
+        create_semaphore(m_is_timeline, m_resource);
+        m_cpu_state = RHI_Sync_State::Idle;
+    }
+
+    void RHI_Semaphore::Wait(const uint64_t value, uint64_t timeout /*= std::numeric_limits<uint64_t>::max()*/)
+    {
+        SP_ASSERT(m_is_timeline);
+        SP_ASSERT_MSG(GetValue() >= value, "Waiting on a value that will never be signaled");
+    }
+
+    void RHI_Semaphore::Signal(const uint64_t value)
+    {
+        SP_ASSERT(m_is_timeline);
+
+        static_cast<atomic<uint64_t>*>(m_resource)->store(value);
+    }
+
+    uint64_t RHI_Semaphore::GetValue()
+    {
+        SP_ASSERT(m_is_timeline);
+
+        return static_cast<atomic<uint64_t>*>(m_resource)->load();
+    }
+}
@@ -0,0 +1,75 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ============================
+#include "pch.h"
+#include "../RHI_Shader.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_InputLayout.h"
+//=======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_Shader::~RHI_Shader()
+    {
+        m_rhi_resource = nullptr;
+    }
+
+    void* RHI_Shader::GetRhiResource() const
+    {
+        return m_rhi_resource;
+    }
+
+    void* RHI_Shader::Compile2()
+    {
+        // Nothing is compiled, but the preprocessing (includes, defines) has
+        // already happened by now, which is the part that costs CPU time.
+
+        // Create input layout
+        if (m_shader_type == RHI_Shader_Vertex)
+        {
+            m_input_layout->Create(m_vertex_type, nullptr);
+        }
+
+        m_object_size_cpu = m_preprocessed_source.size();
+
+        return null_utility::handle::create();
+    }
+
+    void RHI_Shader::Reflect(const RHI_Shader_Type shader_type, const uint32_t* ptr, uint32_t size)
+    {
+
+    }
+
+    const char* RHI_Shader::GetTargetProfile() const
+    {
+        if (m_shader_type == RHI_Shader_Vertex)  return "vs_6_6";
+        if (m_shader_type == RHI_Shader_Pixel)   return "ps_6_6";
+        if (m_shader_type == RHI_Shader_Compute) return "cs_6_6";
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,228 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ========================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Device.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Semaphore.h"
+#include "../RHI_CommandPool.h"
+#include "../../Rendering/Renderer.h"
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    static void create(
+        const uint32_t buffer_count,
+        array<RHI_Image_Layout, 3>* layouts,
+        void*& swap_chain,
+        array<void*, 3>& backbuffer_textures,
+        array<void*, 3>& backbuffer_texture_views,
+        array<shared_ptr<RHI_Semaphore>, 3>& image_acquired_semaphore
+    )
+    {
+        swap_chain = null_utility::handle::create();
+
+        for (uint32_t i = 0; i < buffer_count; i++)
+        {
+            backbuffer_textures[i]      = null_utility::handle::create();
+            backbuffer_texture_views[i] = null_utility::handle::create();
+            (*layouts)[i]               = RHI_Image_Layout::Color_Attachment_Optimal;
+
+            string name = (string("swapchain_image_acquired_") + to_string(i));
+            image_acquired_semaphore[i] = make_shared<RHI_Semaphore>(false, name.c_str());
+        }
+    }
+
+    static void destroy(
+        const uint32_t buffer_count,
+        void*& swap_chain,
+        array<void*, 3>& backbuffer_texture_views,
+        array<shared_ptr<RHI_Semaphore>, 3>& image_acquired_semaphore
+    )
+    {
+        for (uint32_t i = 0; i < buffer_count; i++)
+        {
+            backbuffer_texture_views[i] = nullptr;
+            image_acquired_semaphore[i] = nullptr;
+        }
+
+        swap_chain = nullptr;
+    }
+
+    RHI_SwapChain::RHI_SwapChain(
+        void* sdl_window,
+        const uint32_t width,
+        const uint32_t height,
+        const RHI_Format format,
+        const uint32_t buffer_count,
+        const uint32_t flags,
+        const char* name
+    )
+    {
+        // Verify resolution
+        if (!Renderer::GetRhiDevice()->IsValidResolution(width, height))
+        {
+            SP_LOG_WARNING("%dx%d is an invalid resolution", width, height);
+            return;
+        }
+
+        m_acquire_semaphore.fill(nullptr);
+        m_rhi_backbuffer_resource.fill(nullptr);
+        m_rhi_backbuffer_srv.fill(nullptr);
+        m_layouts.fill(RHI_Image_Layout::Undefined);
+
+        // Copy parameters
+        m_format       = format;
+        m_buffer_count = buffer_count;
+        m_width        = width;
+        m_height       = height;
+        m_sdl_window   = sdl_window;
+        m_flags        = flags;
+        m_name         = name;
+
+        create(m_buffer_count, &m_layouts, m_rhi_resource, m_rhi_backbuffer_resource, m_rhi_backbuffer_srv, m_acquire_semaphore);
+
+        AcquireNextImage();
+    }
+
+    RHI_SwapChain::~RHI_SwapChain()
+    {
+        destroy(m_buffer_count, m_rhi_resource, m_rhi_backbuffer_srv, m_acquire_semaphore);
+    }
+
+    bool RHI_SwapChain::Resize(const uint32_t width, const uint32_t height, const bool force /*= false*/)
+    {
+        // Validate resolution
+        m_present_enabled = Renderer::GetRhiDevice()->IsValidResolution(width, height);
+
+        if (!m_present_enabled)
+            return false;
+
+        // Only resize if needed
+        if (!force)
+        {
+            if (m_width == width && m_height == height)
+                return false;
+        }
+
+        // Save new dimensions
+        m_width  = width;
+        m_height = height;
+
+        destroy(m_buffer_count, m_rhi_resource, m_rhi_backbuffer_srv, m_acquire_semaphore);
+        create(m_buffer_count, &m_layouts, m_rhi_resource, m_rhi_backbuffer_resource, m_rhi_backbuffer_srv, m_acquire_semaphore);
+
+        // Reset image index
+        m_image_index          = numeric_limits<uint32_t>::max();
+        m_image_index_previous = m_image_index;
+
+        AcquireNextImage();
+
+        return true;
+    }
+
+    void RHI_SwapChain::AcquireNextImage()
+    {
+        SP_ASSERT(m_present_enabled && "No need to acquire next image when presenting is disabled");
+
+        // Return if the swapchain has a single buffer and it has already been acquired
+        if (m_buffer_count == 1 && m_image_index != numeric_limits<uint32_t>::max())
+            return;
+
+        // Get signal semaphore
+        m_sync_index = (m_sync_index + 1) % m_buffer_count;
+        RHI_Semaphore* signal_semaphore = m_acquire_semaphore[m_sync_index].get();
+
+        // Ensure semaphore state
+        SP_ASSERT_MSG(signal_semaphore->GetCpuState() != RHI_Sync_State::Submitted, "The semaphore is already signaled");
+
+        m_image_index_previous = m_image_index;
+
+        // Images are handed out in order, like a fifo swapchain with no contention would
+        m_image_index = m_image_index == numeric_limits<uint32_t>::max() ? 0 : (m_image_index + 1) % m_buffer_count;
+
+        // Update semaphore state
+        signal_semaphore->SetCpuState(RHI_Sync_State::Submitted);
+    }
+
+    void RHI_SwapChain::Present()
+    {
+        SP_ASSERT_MSG(m_rhi_resource != nullptr,                                 "The swapchain has not been initialised");
+        SP_ASSERT_MSG(m_present_enabled,                                         "Presenting is disabled");
+        SP_ASSERT_MSG(m_image_index != m_image_index_previous,                   "No image was acquired");
+        SP_ASSERT_MSG(m_layouts[m_image_index] == RHI_Image_Layout::Present_Src, "The layout must be Present_Src");
+
+        // Get the semaphores that present should wait for
+        m_wait_semaphores.clear();
+        {
+            m_wait_semaphores.emplace_back(m_acquire_semaphore[m_sync_index].get());
+
+            const vector<shared_ptr<RHI_CommandPool>>& cmd_pools = Renderer::GetRhiDevice()->GetCommandPools();
+            for (const shared_ptr<RHI_CommandPool>& cmd_pool : cmd_pools)
+            {
+                if (m_object_id == cmd_pool->GetSwapchainId())
+                {
+                    RHI_Semaphore* semaphore = cmd_pool->GetCurrentCommandList()->GetSemaphoreProccessed();
+
+                    if (semaphore->GetCpuState() == RHI_Sync_State::Submitted)
+                    {
+                        m_wait_semaphores.emplace_back(semaphore);
+                    }
+                }
+            }
+        }
+
+        // Present
+        Renderer::GetRhiDevice()->QueuePresent(m_rhi_resource, &m_image_index, m_wait_semaphores);
+
+        // Acquire next image
+        AcquireNextImage();
+    }
+
+    void RHI_SwapChain::SetLayout(const RHI_Image_Layout& layout, RHI_CommandList* cmd_list)
+    {
+        if (m_layouts[m_image_index] == layout)
+            return;
+
+        m_layouts[m_image_index] = layout;
+    }
+
+    void RHI_SwapChain::SetHdr(const bool enabled)
+    {
+        RHI_Format new_format = enabled ? RHI_Format_R10G10B10A2_Unorm : RHI_Format_R8G8B8A8_Unorm;
+
+        if (new_format != m_format)
+        {
+            m_format = new_format;
+            Resize(m_width, m_height, true);
+            SP_LOG_INFO("HDR has been %s", enabled ? "enabled" : "disabled");
+        }
+    }
+}
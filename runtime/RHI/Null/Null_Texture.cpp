@@ -0,0 +1,164 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ========================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_TextureCube.h"
+#include "../RHI_CommandList.h"
+#include "../../Rendering/Renderer.h"
+#include "../Profiling/Profiler.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    static uint64_t compute_size_in_bytes(RHI_Texture* texture)
+    {
+        uint64_t size = 0;
+
+        for (uint32_t array_index = 0; array_index < texture->GetArrayLength(); array_index++)
+        {
+            for (uint32_t mip_index = 0; mip_index < texture->GetMipCount(); mip_index++)
+            {
+                uint64_t mip_width  = max(texture->GetWidth()  >> mip_index, 1u);
+                uint64_t mip_height = max(texture->GetHeight() >> mip_index, 1u);
+                size += mip_width * mip_height * static_cast<uint64_t>(texture->GetBytesPerPixel());
+            }
+        }
+
+        return size;
+    }
+
+    inline RHI_Image_Layout GetAppropriateLayout(RHI_Texture* texture)
+    {
+        RHI_Image_Layout target_layout = RHI_Image_Layout::Preinitialized;
+
+        if (texture->IsRenderTargetColor())
+        {
+            target_layout = RHI_Image_Layout::Color_Attachment_Optimal;
+        }
+        else if (texture->IsRenderTargetDepthStencil())
+        {
+            target_layout = RHI_Image_Layout::Depth_Stencil_Attachment_Optimal;
+        }
+
+        if (texture->IsUav())
+            target_layout = RHI_Image_Layout::General;
+
+        if (texture->IsSrv())
+            target_layout = RHI_Image_Layout::Shader_Read_Only_Optimal;
+
+        return target_layout;
+    }
+
+    void RHI_Texture::RHI_SetLayout(const RHI_Image_Layout new_layout, RHI_CommandList* cmd_list, const uint32_t mip_start, const uint32_t mip_range)
+    {
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
+    bool RHI_Texture::RHI_CreateResource()
+    {
+        // Create image
+        uint64_t size_in_bytes = compute_size_in_bytes(this);
+        Renderer::GetRhiDevice()->CreateTexture(static_cast<void*>(&size_in_bytes), m_rhi_resource);
+
+        // Account for the upload, the data itself is never read back
+        if (HasData())
+        {
+            null_utility::stats::bytes_uploaded += size_in_bytes;
+        }
+
+        // Transition to target layout
+        RHI_Image_Layout target_layout = GetAppropriateLayout(this);
+        for (uint32_t i = 0; i < m_mip_count; i++)
+        {
+            m_layout[i] = target_layout;
+        }
+
+        // Create image views
+        {
+            // Shader resource views
+            if (IsSrv())
+            {
+                m_rhi_srv = null_utility::handle::create();
+
+                if (HasPerMipViews())
+                {
+                    for (uint32_t i = 0; i < m_mip_count; i++)
+                    {
+                        m_rhi_srv_mips[i] = null_utility::handle::create();
+                    }
+                }
+            }
+
+            // Render target views
+            for (uint32_t i = 0; i < m_array_length; i++)
+            {
+                if (IsRenderTargetColor())
+                {
+                    m_rhi_rtv[i] = null_utility::handle::create();
+                }
+
+                if (IsRenderTargetDepthStencil())
+                {
+                    m_rhi_dsv[i] = null_utility::handle::create();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void RHI_Texture::RHI_DestroyResource(const bool destroy_main, const bool destroy_per_view)
+    {
+        // Views are plain handles, there is nothing to free
+        if (destroy_main)
+        {
+            m_rhi_srv = nullptr;
+            for (uint32_t i = 0; i < rhi_max_render_target_count; i++)
+            {
+                m_rhi_dsv[i] = nullptr;
+                m_rhi_rtv[i] = nullptr;
+            }
+        }
+
+        if (destroy_per_view)
+        {
+            for (uint32_t i = 0; i < m_mip_count; i++)
+            {
+                m_rhi_srv_mips[i] = nullptr;
+            }
+        }
+
+        if (destroy_main)
+        {
+            Renderer::AddToDeletionQueue(RHI_Resource_Type::texture, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==========================
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+#include "../../Display/Display.h"
+#include <atomic>
+//=====================================
+
+// The null backend doesn't talk to a GPU. Every RHI call does the minimum amount of
+// CPU bookkeeping (call counts and byte sizes) so that the rest of the engine can run
+// headless and its CPU cost can be measured on machines without a graphics device.
+
+namespace Spartan::null_utility
+{
+    struct globals
+    {
+        static inline RHI_Device* rhi_device;
+        static inline RHI_Context* rhi_context;
+    };
+
+    // Memory property flags understood by RHI_Device::CreateBuffer()
+    static const uint32_t memory_property_host_visible = 1 << 0;
+
+    // What a buffer or a texture handle points to
+    struct allocation
+    {
+        uint64_t size   = 0;
+        std::byte* data = nullptr; // only host visible buffers have backing memory
+    };
+
+    struct stats
+    {
+        static inline std::atomic<uint64_t> buffer_count         = 0;
+        static inline std::atomic<uint64_t> buffer_bytes         = 0;
+        static inline std::atomic<uint64_t> texture_count        = 0;
+        static inline std::atomic<uint64_t> texture_bytes        = 0;
+        static inline std::atomic<uint64_t> pipeline_count       = 0;
+        static inline std::atomic<uint64_t> descriptor_set_count = 0;
+        static inline std::atomic<uint64_t> queue_submits        = 0;
+        static inline std::atomic<uint64_t> queue_presents       = 0;
+        static inline std::atomic<uint64_t> bytes_uploaded       = 0;
+
+        static uint64_t GetMemoryUsed() { return buffer_bytes + texture_bytes; }
+    };
+
+    namespace handle
+    {
+        // Returns a unique, non-null value which is never dereferenced
+        inline void* create()
+        {
+            static std::atomic<uint64_t> id = 0;
+            return reinterpret_cast<void*>(++id);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_VertexBuffer.h"
+#include "../Rendering/Renderer.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_VertexBuffer::~RHI_VertexBuffer()
+    {
+        if (m_rhi_resource)
+        {
+            Renderer::AddToDeletionQueue(RHI_Resource_Type::buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+    }
+
+    void RHI_VertexBuffer::_create(const void* vertices)
+    {
+        // Destroy previous buffer
+        if (m_rhi_resource)
+        {
+            Renderer::AddToDeletionQueue(RHI_Resource_Type::buffer, m_rhi_resource);
+            m_rhi_resource = nullptr;
+        }
+
+        // Only mappable buffers need backing memory, static ones just account for the upload
+        uint32_t flags = m_is_mappable ? null_utility::memory_property_host_visible : 0;
+        Renderer::GetRhiDevice()->CreateBuffer(m_rhi_resource, m_object_size_gpu, 0, flags, vertices);
+
+        m_mapped_data = Renderer::GetRhiDevice()->GetMappedDataFromBuffer(m_rhi_resource);
+    }
+
+    void* RHI_VertexBuffer::Map()
+    {
+        return m_mapped_data;
+    }
+
+    void RHI_VertexBuffer::Unmap()
+    {
+        // buffer is mapped on creation and unmapped during destruction
+    }
+
+    void RHI_VertexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+        SP_ASSERT_MSG(!m_is_mappable, "Mappable buffers are written through Map()");
+        SP_ASSERT_MSG(offset + size <= m_object_size_gpu, "The range is out of bounds");
+
+        // Static buffers have no backing memory, only the upload is accounted for
+        null_utility::stats::bytes_uploaded += size;
+    }
+}
@@ -84,7 +84,7 @@ namespace Spartan
             !m_discard;                                   // It hasn't been discarded, in which case Submit() early exited.
     }
 
-    void RHI_CommandList::GetDescriptorsFromPipelineState(RHI_PipelineState& pipeline_state, vector<RHI_Descriptor>& descriptors)
+    void RHI_CommandList::GetDescriptorsFromPipelineState(RHI_PipelineState& pipeline_state, pmr::vector<RHI_Descriptor>& descriptors)
     {
         if (!pipeline_state.IsValid())
         {
@@ -102,7 +102,8 @@ namespace Spartan
             SP_ASSERT_MSG(pipeline_state.shader_compute->GetCompilationState() == Shader_Compilation_State::Succeeded, "Shader hasn't compiled");
 
             // Get compute shader descriptors
-            descriptors = pipeline_state.shader_compute->GetDescriptors();
+            const vector<RHI_Descriptor>& descriptors_compute = pipeline_state.shader_compute->GetDescriptors();
+            descriptors.assign(descriptors_compute.begin(), descriptors_compute.end());
             descriptors_acquired = true;
         }
         else if (pipeline_state.IsGraphics())
@@ -110,7 +111,8 @@ namespace Spartan
             SP_ASSERT_MSG(pipeline_state.shader_vertex->GetCompilationState() == Shader_Compilation_State::Succeeded, "Shader hasn't compiled");
 
             // Get vertex shader descriptors
-            descriptors = pipeline_state.shader_vertex->GetDescriptors();
+            const vector<RHI_Descriptor>& descriptors_vertex = pipeline_state.shader_vertex->GetDescriptors();
+            descriptors.assign(descriptors_vertex.begin(), descriptors_vertex.end());
             descriptors_acquired = true;
 
             // If there is a pixel shader, merge it's resources into our map as well
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =================================
 #include <array>
 #include <atomic>
+#include <memory_resource>
 #include "RHI_Definition.h"
 #include "RHI_PipelineState.h"
 #include "RHI_Descriptor.h"
@@ -72,10 +73,19 @@ namespace Spartan
         // Draw
         void Draw(uint32_t vertex_count, uint32_t vertex_start_index = 0);
         void DrawIndexed(uint32_t index_count, uint32_t index_offset = 0, uint32_t vertex_offset = 0);
+        // Draws up to max_draw_count RHI_Indirect_DrawIndexed arguments, the actual count is read from the first uint of count_buffer
+        void DrawIndexedIndirectCount(RHI_StructuredBuffer* argument_buffer, RHI_StructuredBuffer* count_buffer, const uint32_t max_draw_count);
 
         // Dispatch
         void Dispatch(uint32_t x, uint32_t y, uint32_t z = 1, bool async = false);
 
+        // Makes compute shader writes visible to indirect draws and vertex shaders, call outside of a render pass
+        void InsertMemoryBarrierIndirect();
+
+        // Transitions a texture to a layout, or if it's already in it, makes the previous writes visible (e.g. storage writes
+        // followed by storage reads or writes), call outside of a render pass
+        void InsertBarrierTexture(RHI_Texture* texture, const RHI_Image_Layout layout);
+
         // Blit
         void Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips);
 
@@ -117,7 +127,12 @@ namespace Spartan
         // Timestamps
         void BeginTimestamp(void* query);
         void EndTimestamp(void* query);
-        float GetTimestampDuration(void* query_start, void* query_end, const uint32_t pass_index);
+        uint32_t GetTimestampIndex() const { return m_timestamp_index; }
+        uint64_t GetRecording()      const { return m_recording; }
+
+        // Never waits, returns false while the GPU is yet to execute the recording which wrote the timestamps.
+        // Once true, duration_ms holds the result, or a negative value if the results were overwritten before they were read.
+        bool GetTimestampDuration(void* query_start, void* query_end, const uint64_t recording, const uint32_t index_start, const uint32_t index_end, float* duration_ms);
 
         // Timeblocks (Markers + Timestamps)
         void BeginTimeblock(const char* name, const bool gpu_marker = true, const bool gpu_timing = true);
@@ -144,7 +159,7 @@ namespace Spartan
 
         // Descriptors
         void GetDescriptorSetLayoutFromPipelineState(RHI_PipelineState& pipeline_state);
-        void GetDescriptorsFromPipelineState(RHI_PipelineState& pipeline_state, std::vector<RHI_Descriptor>& descriptors);
+        void GetDescriptorsFromPipelineState(RHI_PipelineState& pipeline_state, std::pmr::vector<RHI_Descriptor>& descriptors);
 
         RHI_Pipeline* m_pipeline                         = nullptr;
         std::atomic<bool> m_discard                      = false;
@@ -187,7 +202,10 @@ namespace Spartan
         void* m_query_pool                     = nullptr;
         uint32_t m_timestamp_index             = 0;
         static const uint32_t m_max_timestamps = 512;
-        std::array<uint64_t, m_max_timestamps> m_timestamps;
+        std::array<uint64_t, m_max_timestamps * 2> m_timestamps; // Value and availability pairs, of the recording before the current one
+        uint32_t m_timestamps_count            = 0;
+        uint64_t m_timestamps_recording        = 0;
+        uint64_t m_recording                   = 0; // Incremented by every Begin()
 
         // Variables to minimise state changes
         uint64_t m_vertex_buffer_id = 0;
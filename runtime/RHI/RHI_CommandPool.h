@@ -41,6 +41,7 @@ namespace Spartan
 
         RHI_CommandList* GetCurrentCommandList()       { return m_cmd_lists[m_cmd_list_index].get(); }
         uint32_t GetCommandListIndex()           const { return m_cmd_list_index; }
+        uint32_t GetCommandListCount()           const { return static_cast<uint32_t>(m_cmd_lists.size()); }
         void*& GetResource()                           { return m_rhi_resources[GetPoolIndex()]; }
         uint64_t GetSwapchainId()                const { return m_swap_chain_id; }
 
@@ -87,7 +87,8 @@ namespace Spartan
     {
         D3d11,
         D3d12,
-        Vulkan
+        Vulkan,
+        Null
     };
 
     enum RHI_Present_Mode : uint32_t
@@ -107,6 +108,16 @@ namespace Spartan
         RHI_SwapChain_Allow_Mode_Switch = 1 << 10
     };
 
+    // Arguments of an indexed indirect draw, the layout matches VkDrawIndexedIndirectCommand
+    struct RHI_Indirect_DrawIndexed
+    {
+        uint32_t index_count    = 0;
+        uint32_t instance_count = 0;
+        uint32_t first_index    = 0;
+        int32_t vertex_offset   = 0;
+        uint32_t first_instance = 0;
+    };
+
     enum class RHI_Queue_Type
     {
         Graphics,
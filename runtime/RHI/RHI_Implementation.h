@@ -494,6 +494,12 @@ namespace Spartan
             // Note: Would like to enable VK_KHR_synchronization2, but only 17.3% of the devices out there support it.
         #endif
 
+        #if defined(API_GRAPHICS_NULL)
+            static const RHI_Api_Type api_type = RHI_Api_Type::Null;
+            std::string api_type_str           = "Null";
+            void* device                       = nullptr;
+        #endif
+
         // Validation\profiling\markers and so on
         #ifdef DEBUG
             bool validation    = true;
@@ -568,6 +574,8 @@ namespace Spartan
     #include "D3D12/D3D12_Utility.h"
 #elif defined (API_GRAPHICS_VULKAN)
     #include "Vulkan/Vulkan_Utility.h"
+#elif defined (API_GRAPHICS_NULL)
+    #include "Null/Null_Utility.h"
 #endif
 
 #endif // RUNTIME
@@ -41,6 +41,7 @@ namespace Spartan
         template<typename T>
         void Create(const std::vector<T>& indices)
         {
+            m_is_mappable     = false;
             m_stride          = sizeof(T);
             m_index_count     = static_cast<uint32_t>(indices.size());
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_index_count);
@@ -51,6 +52,7 @@ namespace Spartan
         template<typename T>
         void Create(const T* indices, const uint32_t index_count)
         {
+            m_is_mappable     = false;
             m_stride          = sizeof(T);
             m_index_count     = index_count;
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_index_count);
@@ -61,6 +63,19 @@ namespace Spartan
         template<typename T>
         void CreateDynamic(const uint32_t index_count)
         {
+            m_is_mappable     = true;
+            m_stride          = sizeof(T);
+            m_index_count     = index_count;
+            m_object_size_gpu = static_cast<uint64_t>(m_stride * m_index_count);
+
+            _create(nullptr);
+        }
+
+        // Device local and without data, ranges of it are then filled with Update()
+        template<typename T>
+        void CreateStatic(const uint32_t index_count)
+        {
+            m_is_mappable     = false;
             m_stride          = sizeof(T);
             m_index_count     = index_count;
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_index_count);
@@ -71,6 +86,9 @@ namespace Spartan
         void* Map();
         void Unmap();
 
+        // Uploads to a range of a static buffer, through a staging buffer
+        void Update(const void* data, const uint64_t offset, const uint64_t size);
+
         void* GetRhiResource()   const { return m_rhi_resource; }
         uint32_t GetIndexCount() const { return m_index_count; }
         bool Is16Bit()           const { return sizeof(uint16_t) == m_stride; }
@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/ResourceCache.h"
 #include "../Resource/Import/ImageImporter.h"
 #include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
 #include "compressonator.h"
 //===========================================
 
@@ -156,6 +157,9 @@ namespace Spartan
 
     bool RHI_Texture::LoadFromFile(const string& file_path)
     {
+        SP_MEMORY_TAG(ResourceTexture);
+        Profiler::AddTraceEvent("Resource", "Load " + file_path);
+
         SP_ASSERT_MSG(!file_path.empty(), "A file path is required");
 
         m_data.clear();
@@ -327,6 +331,9 @@ namespace Spartan
             m_mip_count    = m_data[0].GetMipCount();
         }
 
+        // The data changed, so the native file has to be written again (loading resets this, the file is what was loaded)
+        SetDirty(true);
+
         return mip;
     }
 
@@ -423,6 +430,7 @@ namespace Spartan
 
                     // Assign new format
                     m_format = format;
+                    SetDirty(true);
                 }
                 else
                 {
@@ -42,6 +42,7 @@ namespace Spartan
         template<typename T>
         void Create(const std::vector<T>& vertices)
         {
+            m_is_mappable     = false;
             m_stride          = static_cast<uint32_t>(sizeof(T));
             m_vertex_count    = static_cast<uint32_t>(vertices.size());
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_vertex_count);
@@ -52,6 +53,7 @@ namespace Spartan
         template<typename T>
         void Create(const T* vertices, const uint32_t vertex_count)
         {
+            m_is_mappable     = false;
             m_stride          = static_cast<uint32_t>(sizeof(T));
             m_vertex_count    = vertex_count;
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_vertex_count);
@@ -62,6 +64,19 @@ namespace Spartan
         template<typename T>
         void CreateDynamic(const uint32_t vertex_count)
         {
+            m_is_mappable     = true;
+            m_stride          = static_cast<uint32_t>(sizeof(T));
+            m_vertex_count    = vertex_count;
+            m_object_size_gpu = static_cast<uint64_t>(m_stride * m_vertex_count);
+
+            _create(nullptr);
+        }
+
+        // Device local and without data, ranges of it are then filled with Update()
+        template<typename T>
+        void CreateStatic(const uint32_t vertex_count)
+        {
+            m_is_mappable     = false;
             m_stride          = static_cast<uint32_t>(sizeof(T));
             m_vertex_count    = vertex_count;
             m_object_size_gpu = static_cast<uint64_t>(m_stride * m_vertex_count);
@@ -72,6 +87,9 @@ namespace Spartan
         void* Map();
         void Unmap();
 
+        // Uploads to a range of a static buffer, through a staging buffer
+        void Update(const void* data, const uint64_t offset, const uint64_t size);
+
         void* GetRhiResource()    const { return m_rhi_resource; }
         uint32_t GetStride()      const { return m_stride; }
         uint32_t GetVertexCount() const { return m_vertex_count; }
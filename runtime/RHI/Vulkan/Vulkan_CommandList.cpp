@@ -37,6 +37,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_CommandPool.h"
 #include "../../Profiling/Profiler.h"
 #include "../../Rendering/Renderer.h"
+#include "../../Core/FrameAllocator.h"
 //=====================================
 
 //= NAMESPACES ===============
@@ -142,9 +143,11 @@ namespace Spartan
                 {
                     if (m_timestamp_index != 0)
                     {
-                        const uint32_t query_count     = m_timestamp_index * 2;
-                        const size_t stride            = sizeof(uint64_t);
-                        const VkQueryResultFlags flags = VK_QUERY_RESULT_64_BIT;
+                        // The command list is only begun once the GPU is done with it, so this never waits. The results are kept
+                        // (together with their availability) until the next Begin(), which is as long as the profiler has to read them.
+                        const uint32_t query_count     = m_timestamp_index;
+                        const size_t stride            = sizeof(uint64_t) * 2;
+                        const VkQueryResultFlags flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
 
                         vkGetQueryPoolResults(
                             Renderer::GetRhiDevice()->GetRhiContext()->device,  // device
@@ -160,9 +163,13 @@ namespace Spartan
                 }
             }
 
-            m_timestamp_index = 0;
+            m_timestamps_count     = m_timestamp_index;
+            m_timestamps_recording = m_recording;
+            m_timestamp_index      = 0;
         }
 
+        m_recording++;
+
         // Begin command buffer
         VkCommandBufferBeginInfo begin_info = {};
         begin_info.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -234,6 +241,7 @@ namespace Spartan
             // Create a new pipeline
             it = m_pipelines.emplace(make_pair(hash, move(make_shared<RHI_Pipeline>(pso, m_descriptor_layout_current)))).first;
             SP_LOG_INFO("A new pipeline has been created.");
+            Profiler::AddTraceEvent("Pipeline", "Pipeline creation (" + to_string(m_pipelines.size()) + " pipelines)");
         }
 
         m_pipeline = it->second.get();
@@ -547,6 +555,29 @@ namespace Spartan
         Profiler::m_rhi_draw++;
     }
 
+    void RHI_CommandList::DrawIndexedIndirectCount(RHI_StructuredBuffer* argument_buffer, RHI_StructuredBuffer* count_buffer, const uint32_t max_draw_count)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT(argument_buffer != nullptr && count_buffer != nullptr);
+
+        // Ensure correct state before attempting to draw
+        OnDraw();
+
+        // Draw
+        vkCmdDrawIndexedIndirectCount(
+            static_cast<VkCommandBuffer>(m_rhi_resource),               // commandBuffer
+            static_cast<VkBuffer>(argument_buffer->GetRhiResource()),   // buffer
+            argument_buffer->GetOffset(),                               // offset
+            static_cast<VkBuffer>(count_buffer->GetRhiResource()),      // countBuffer
+            count_buffer->GetOffset(),                                  // countBufferOffset
+            max_draw_count,                                             // maxDrawCount
+            static_cast<uint32_t>(sizeof(RHI_Indirect_DrawIndexed))     // stride
+        );
+
+        // Profile
+        Profiler::m_rhi_draw++;
+    }
+
     void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/, bool async /*= false*/)
     {
         SP_ASSERT(m_state == RHI_CommandListState::Recording);
@@ -560,6 +591,47 @@ namespace Spartan
         Profiler::m_rhi_dispatch++;
     }
 
+    void RHI_CommandList::InsertMemoryBarrierIndirect()
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG(!m_is_rendering, "Barriers can't be inserted within a render pass");
+
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(
+            static_cast<VkCommandBuffer>(m_rhi_resource),                                  // commandBuffer
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,                                          // srcStageMask
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,     // dstStageMask
+            0,                                                                             // dependencyFlags
+            1, &barrier,                                                                   // memoryBarriers
+            0, nullptr,                                                                    // bufferMemoryBarriers
+            0, nullptr                                                                     // imageMemoryBarriers
+        );
+    }
+
+    void RHI_CommandList::InsertBarrierTexture(RHI_Texture* texture, const RHI_Image_Layout layout)
+    {
+        SP_ASSERT(m_state == RHI_CommandListState::Recording);
+        SP_ASSERT_MSG(!m_is_rendering, "Barriers can't be inserted within a render pass");
+        SP_ASSERT(texture != nullptr);
+
+        for (uint32_t i = 0; i < texture->GetMipCount(); i++)
+        {
+            if (texture->GetLayout(i) != layout)
+            {
+                texture->SetLayout(layout, this);
+                return;
+            }
+        }
+
+        // Same old and new layout, this only synchronizes the accesses that the layout allows
+        vulkan_utility::image::set_layout(m_rhi_resource, texture, 0, texture->GetMipCount(), texture->GetArrayLength(), layout, layout);
+        Profiler::m_rhi_pipeline_barriers++;
+    }
+
     void RHI_CommandList::Blit(RHI_Texture* source, RHI_Texture* destination, const bool blit_mips)
     {
         // D3D11 baggage: https://docs.microsoft.com/en-us/windows/win32/api/d3d11/nf-d3d11-id3d11devicecontext-copyresource
@@ -894,7 +966,7 @@ namespace Spartan
         if (!Renderer::GetRhiDevice()->GetRhiContext()->gpu_profiling)
             return;
 
-        if (!m_query_pool)
+        if (!m_query_pool || m_timestamp_index >= m_max_timestamps)
             return;
 
         vkCmdWriteTimestamp(static_cast<VkCommandBuffer>(m_rhi_resource), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, static_cast<VkQueryPool>(m_query_pool), m_timestamp_index++);
@@ -908,28 +980,39 @@ namespace Spartan
         if (!Renderer::GetRhiDevice()->GetRhiContext()->gpu_profiling)
             return;
 
+        if (m_timestamp_index >= m_max_timestamps)
+            return;
+
         vkCmdWriteTimestamp(static_cast<VkCommandBuffer>(m_rhi_resource), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, static_cast<VkQueryPool>(m_query_pool), m_timestamp_index++);
     }
 
-    float RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint32_t pass_index)
+    bool RHI_CommandList::GetTimestampDuration(void* query_start, void* query_end, const uint64_t recording, const uint32_t index_start, const uint32_t index_end, float* duration_ms)
     {
-        if (pass_index + 1 >= m_timestamps.size())
+        SP_ASSERT(duration_ms != nullptr);
+
+        // Still recording or in flight, the results are read once the command list is begun again
+        if (recording >= m_recording)
+            return false;
+
+        // Only the results of the previous recording are kept, the ones before that have been overwritten
+        if (recording != m_timestamps_recording || index_start >= index_end || index_end >= m_timestamps_count)
         {
-            SP_LOG_ERROR("Pass index out of timestamp array range");
-            return 0.0f;
+            *duration_ms = -1.0f;
+            return true;
         }
 
-        uint64_t start = m_timestamps[pass_index];
-        uint64_t end   = m_timestamps[pass_index + 1];
-
-        // If end has not been acquired yet (zero), early exit
-        if (end < start)
-            return 0.0f;
+        const uint64_t start = m_timestamps[index_start * 2];
+        const uint64_t end   = m_timestamps[index_end * 2];
+        const bool available = m_timestamps[index_start * 2 + 1] != 0 && m_timestamps[index_end * 2 + 1] != 0;
+        if (!available || end < start)
+        {
+            *duration_ms = -1.0f;
+            return true;
+        }
 
-        uint64_t duration = Math::Helper::Clamp<uint64_t>(end - start, 0, std::numeric_limits<uint64_t>::max());
-        float duration_ms = static_cast<float>(duration * Renderer::GetRhiDevice()->GetTimestampPeriod() * 1e-6f);
+        *duration_ms = static_cast<float>(static_cast<double>(end - start) * Renderer::GetRhiDevice()->GetTimestampPeriod() * 1e-6);
 
-        return duration_ms;
+        return true;
     }
 
     void RHI_CommandList::BeginTimeblock(const char* name, const bool gpu_marker, const bool gpu_timing)
@@ -966,8 +1049,8 @@ namespace Spartan
         // Allowed profiler ?
         if (Renderer::GetRhiDevice()->GetRhiContext()->gpu_profiling)
         {
-            Profiler::TimeBlockEnd(); // cpu
-            Profiler::TimeBlockEnd(); // gpu
+            Profiler::TimeBlockEnd(TimeBlockType::Cpu);
+            Profiler::TimeBlockEnd(TimeBlockType::Gpu);
         }
 
         m_timeblock_active = nullptr;
@@ -1019,7 +1102,7 @@ namespace Spartan
     void RHI_CommandList::GetDescriptorSetLayoutFromPipelineState(RHI_PipelineState& pipeline_state)
     {
         // Get pipeline
-        vector<RHI_Descriptor> descriptors;
+        pmr::vector<RHI_Descriptor> descriptors = frame_vector<RHI_Descriptor>();
         GetDescriptorsFromPipelineState(pipeline_state, descriptors);
 
         // Compute a hash for the descriptors
@@ -1042,7 +1125,7 @@ namespace Spartan
             name        += "-PS:" + (pipeline_state.shader_pixel  ? pipeline_state.shader_pixel->GetName()   : "null");
 
             // Emplace a new descriptor set layout
-            it = m_descriptor_set_layouts.emplace(make_pair(hash, make_shared<RHI_DescriptorSetLayout>(descriptors, name.c_str()))).first;
+            it = m_descriptor_set_layouts.emplace(make_pair(hash, make_shared<RHI_DescriptorSetLayout>(vector<RHI_Descriptor>(descriptors.begin(), descriptors.end()), name.c_str()))).first;
         }
 
         // Get the descriptor set layout we will be using
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_Fence.h"
 #include "../../Core/Window.h"
 #include "../../Profiling/Profiler.h"
+#include "../../Profiling/MemoryTracker.h"
 SP_WARNINGS_OFF
 #define VMA_IMPLEMENTATION
 #include "vk_mem_alloc.h"
@@ -133,6 +134,16 @@ namespace Spartan
         return reinterpret_cast<uint64_t>(resource);
     }
 
+    static void VKAPI_PTR on_device_memory_allocate(VmaAllocator allocator, uint32_t memory_type, VkDeviceMemory memory, VkDeviceSize size, void* user_data)
+    {
+        MemoryTracker::OnGpuAllocate(reinterpret_cast<const void*>(memory), static_cast<uint64_t>(size));
+    }
+
+    static void VKAPI_PTR on_device_memory_free(VmaAllocator allocator, uint32_t memory_type, VkDeviceMemory memory, VkDeviceSize size, void* user_data)
+    {
+        MemoryTracker::OnGpuFree(reinterpret_cast<const void*>(memory), static_cast<uint64_t>(size));
+    }
+
     RHI_Device::RHI_Device(shared_ptr<RHI_Context> rhi_context)
     {
 #ifdef DEBUG
@@ -348,6 +359,21 @@ namespace Spartan
                     SP_ASSERT(features_supported.features.imageCubeArray == VK_TRUE);
                     device_features_to_enable.features.imageCubeArray = VK_TRUE;
 
+                    // GPU driven rendering - multiple indirect draws, with the draw count coming from a buffer
+                    SP_ASSERT(features_supported.features.multiDrawIndirect == VK_TRUE);
+                    device_features_to_enable.features.multiDrawIndirect = VK_TRUE;
+                    SP_ASSERT(features_supported_1_2.drawIndirectCount == VK_TRUE);
+                    device_features_to_enable_1_2.drawIndirectCount = VK_TRUE;
+
+                    // The culling pass passes the object index of every indirect draw as its first instance, which the vertex shader reads back
+                    // through SV_InstanceID (gl_InstanceIndex includes it), without this feature the first instance of indirect draws has to be 0
+                    SP_ASSERT(features_supported.features.drawIndirectFirstInstance == VK_TRUE);
+                    device_features_to_enable.features.drawIndirectFirstInstance = VK_TRUE;
+
+                    // Vertex shaders reading per-object data from storage buffers
+                    SP_ASSERT(features_supported.features.vertexPipelineStoresAndAtomics == VK_TRUE);
+                    device_features_to_enable.features.vertexPipelineStoresAndAtomics = VK_TRUE;
+
                     // Partially bound descriptors
                     SP_ASSERT(features_supported_1_2.descriptorBindingPartiallyBound == VK_TRUE);
                     device_features_to_enable_1_2.descriptorBindingPartiallyBound = VK_TRUE;
@@ -432,11 +458,17 @@ namespace Spartan
 
         // Create memory allocator
         {
+            // Device memory blocks are attributed to the memory tag of the thread which allocates them
+            static VmaDeviceMemoryCallbacks memory_callbacks = {};
+            memory_callbacks.pfnAllocate                     = on_device_memory_allocate;
+            memory_callbacks.pfnFree                         = on_device_memory_free;
+
             VmaAllocatorCreateInfo allocator_info = {};
             allocator_info.physicalDevice         = m_rhi_context->device_physical;
             allocator_info.device                 = m_rhi_context->device;
             allocator_info.instance               = m_rhi_context->instance;
             allocator_info.vulkanApiVersion       = app_info.apiVersion;
+            allocator_info.pDeviceMemoryCallbacks = &memory_callbacks;
 
             SP_ASSERT_MSG(vmaCreateAllocator(&allocator_info, reinterpret_cast<VmaAllocator*>(&m_allocator)) == VK_SUCCESS, "Failed to create memory allocator");
         }
@@ -821,6 +853,7 @@ namespace Spartan
         }
 
         SP_LOG_INFO("Capacity has been set to %d elements", descriptor_set_capacity);
+        Profiler::AddTraceEvent("Descriptors", "Descriptor pool reset (" + to_string(descriptor_set_capacity) + " sets)");
         m_descriptor_set_capacity = descriptor_set_capacity;
 
         Profiler::m_descriptor_set_count    = 0;
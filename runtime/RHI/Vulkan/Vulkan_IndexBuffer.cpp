@@ -52,8 +52,6 @@ namespace Spartan
             m_rhi_resource = nullptr;
         }
 
-        m_is_mappable = indices == nullptr;
-
         if (m_is_mappable)
         {
             // Define memory properties
@@ -67,31 +65,13 @@ namespace Spartan
         }
         else // The reason we use staging is because memory with VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT is not mappable but it's fast, we want that.
         {
-            // Create staging/source buffer and copy the indices to it
-            void* staging_buffer = nullptr;
-            Renderer::GetRhiDevice()->CreateBuffer(staging_buffer, m_object_size_gpu, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, indices);
-
             // Create destination buffer
             Renderer::GetRhiDevice()->CreateBuffer(m_rhi_resource, m_object_size_gpu, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr);
 
-            // Copy staging buffer to destination buffer
+            // Static buffers created without data are filled in later
+            if (indices)
             {
-                // Create command buffer
-                RHI_CommandList* cmd_list = Renderer::GetRhiDevice()->ImmediateBegin(RHI_Queue_Type::Copy);
-
-                VkBuffer* buffer_vk         = reinterpret_cast<VkBuffer*>(&m_rhi_resource);
-                VkBuffer* buffer_staging_vk = reinterpret_cast<VkBuffer*>(&staging_buffer);
-
-                // Copy
-                VkBufferCopy copy_region = {};
-                copy_region.size = m_object_size_gpu;
-                vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), *buffer_staging_vk, *buffer_vk, 1, &copy_region);
-
-                // Flush and free command buffer
-                Renderer::GetRhiDevice()->ImmediateSubmit(cmd_list);
-
-                // Destroy staging buffer
-                Renderer::GetRhiDevice()->DestroyBuffer(staging_buffer);
+                Update(indices, 0, m_object_size_gpu);
             }
         }
 
@@ -108,4 +88,35 @@ namespace Spartan
     {
         // buffer is mapped on creation and unmapped during destruction
     }
+
+    void RHI_IndexBuffer::Update(const void* data, const uint64_t offset, const uint64_t size)
+    {
+        SP_ASSERT_MSG(!m_is_mappable, "Mappable buffers are written through Map()");
+        SP_ASSERT_MSG(offset + size <= m_object_size_gpu, "The range is out of bounds");
+
+        // Create staging/source buffer and copy the data to it
+        void* staging_buffer = nullptr;
+        Renderer::GetRhiDevice()->CreateBuffer(staging_buffer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data);
+
+        // Copy staging buffer to the range of the destination buffer
+        {
+            // Create command buffer
+            RHI_CommandList* cmd_list = Renderer::GetRhiDevice()->ImmediateBegin(RHI_Queue_Type::Copy);
+
+            VkBuffer* buffer_vk         = reinterpret_cast<VkBuffer*>(&m_rhi_resource);
+            VkBuffer* buffer_staging_vk = reinterpret_cast<VkBuffer*>(&staging_buffer);
+
+            // Copy
+            VkBufferCopy copy_region = {};
+            copy_region.dstOffset    = offset;
+            copy_region.size         = size;
+            vkCmdCopyBuffer(static_cast<VkCommandBuffer>(cmd_list->GetRhiResource()), *buffer_staging_vk, *buffer_vk, 1, &copy_region);
+
+            // Flush and free command buffer
+            Renderer::GetRhiDevice()->ImmediateSubmit(cmd_list);
+
+            // Destroy staging buffer
+            Renderer::GetRhiDevice()->DestroyBuffer(staging_buffer);
+        }
+    }
 }
@@ -72,9 +72,9 @@ namespace Spartan
         bool SaveToFile(const std::string& filePath) override;
         //======================================================
 
-        void SetName(const std::string& name)   { m_name = name; }
-        void SetDuration(double duration)       { m_duration = duration; }
-        void SetTicksPerSec(double ticksPerSec) { m_ticksPerSec = ticksPerSec; }
+        void SetName(const std::string& name) override { m_name = name; }
+        void SetDuration(double duration)              { m_duration = duration; }
+        void SetTicksPerSec(double ticksPerSec)        { m_ticksPerSec = ticksPerSec; }
 
     private:
         std::string m_name;
@@ -0,0 +1,226 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ===============
+#include "pch.h"
+#include "Culling.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector4.h"
+#include <bit>
+//==========================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    namespace
+    {
+        static void get_corners(const CullingObject& object, Vector4* corners)
+        {
+            const Vector3& a = object.aabb_min;
+            const Vector3& b = object.aabb_max;
+
+            corners[0] = Vector4(a.x, a.y, a.z, 1.0f);
+            corners[1] = Vector4(b.x, a.y, a.z, 1.0f);
+            corners[2] = Vector4(a.x, b.y, a.z, 1.0f);
+            corners[3] = Vector4(b.x, b.y, a.z, 1.0f);
+            corners[4] = Vector4(a.x, a.y, b.z, 1.0f);
+            corners[5] = Vector4(b.x, a.y, b.z, 1.0f);
+            corners[6] = Vector4(a.x, b.y, b.z, 1.0f);
+            corners[7] = Vector4(b.x, b.y, b.z, 1.0f);
+        }
+    }
+
+    float DepthPyramid::Load(uint32_t mip, uint32_t x, uint32_t y) const
+    {
+        mip = min(mip, static_cast<uint32_t>(mips.size()) - 1);
+
+        const uint32_t mip_width  = max(width  >> mip, 1u);
+        const uint32_t mip_height = max(height >> mip, 1u);
+        x                         = min(x, mip_width - 1);
+        y                         = min(y, mip_height - 1);
+
+        return mips[mip][y * mip_width + x];
+    }
+
+    uint32_t Culling::Cull(
+        const CullingObject* objects,
+        const uint32_t object_count,
+        const Matrix& view_projection,
+        const Matrix& view_projection_previous,
+        const DepthPyramid* depth_pyramid,
+        RHI_Indirect_DrawIndexed* draws_out
+    )
+    {
+        SP_ASSERT(objects != nullptr || object_count == 0);
+        SP_ASSERT(draws_out != nullptr);
+
+        uint32_t draw_count = 0;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            const CullingObject& object = objects[i];
+
+            if (object.index_count == 0 || !IsInFrustum(object, view_projection))
+                continue;
+
+            if (depth_pyramid && depth_pyramid->IsValid() && IsOccluded(object, view_projection_previous, *depth_pyramid))
+                continue;
+
+            // The instance index is how the vertex shader finds the object's transform
+            RHI_Indirect_DrawIndexed& draw = draws_out[draw_count++];
+            draw.index_count               = object.index_count;
+            draw.instance_count            = 1;
+            draw.first_index               = object.index_offset;
+            draw.vertex_offset             = object.vertex_offset;
+            draw.first_instance            = i;
+        }
+
+        return draw_count;
+    }
+
+    bool Culling::IsInFrustum(const CullingObject& object, const Matrix& view_projection)
+    {
+        Vector4 corners[8];
+        get_corners(object, corners);
+
+        // An object is outside if all of its corners are outside of the same clip plane (reverse-z: near is z = w, far is z = 0)
+        uint32_t outside_left = 0, outside_right = 0, outside_bottom = 0, outside_top = 0, outside_near = 0, outside_far = 0;
+        for (const Vector4& corner : corners)
+        {
+            const Vector4 clip = corner * view_projection;
+
+            outside_left   += clip.x < -clip.w ? 1 : 0;
+            outside_right  += clip.x >  clip.w ? 1 : 0;
+            outside_bottom += clip.y < -clip.w ? 1 : 0;
+            outside_top    += clip.y >  clip.w ? 1 : 0;
+            outside_near   += clip.z >  clip.w ? 1 : 0;
+            outside_far    += clip.z <  0.0f   ? 1 : 0;
+        }
+
+        return outside_left != 8 && outside_right != 8 && outside_bottom != 8 && outside_top != 8 && outside_near != 8 && outside_far != 8;
+    }
+
+    bool Culling::IsOccluded(const CullingObject& object, const Matrix& view_projection_previous, const DepthPyramid& depth_pyramid)
+    {
+        Vector4 corners[8];
+        get_corners(object, corners);
+
+        // Screen space rectangle and nearest depth of the object, as seen by the previous frame
+        Vector2 uv_min       = Vector2(1.0f, 1.0f);
+        Vector2 uv_max       = Vector2(0.0f, 0.0f);
+        float depth_nearest  = 0.0f;
+        for (const Vector4& corner : corners)
+        {
+            const Vector4 clip = corner * view_projection_previous;
+
+            // Crossing the near plane, the projection is not reliable, so consider it visible
+            if (clip.w <= 0.0f)
+                return false;
+
+            const Vector3 ndc = Vector3(clip.x, clip.y, clip.z) / clip.w;
+            const Vector2 uv  = Vector2(ndc.x * 0.5f + 0.5f, ndc.y * -0.5f + 0.5f);
+
+            uv_min.x      = min(uv_min.x, uv.x);
+            uv_min.y      = min(uv_min.y, uv.y);
+            uv_max.x      = max(uv_max.x, uv.x);
+            uv_max.y      = max(uv_max.y, uv.y);
+            depth_nearest = max(depth_nearest, ndc.z); // reverse-z
+        }
+
+        uv_min.x = clamp(uv_min.x, 0.0f, 1.0f);
+        uv_min.y = clamp(uv_min.y, 0.0f, 1.0f);
+        uv_max.x = clamp(uv_max.x, 0.0f, 1.0f);
+        uv_max.y = clamp(uv_max.y, 0.0f, 1.0f);
+
+        // Pick the mip where the rectangle covers at most 2x2 texels
+        const float width_pixels  = (uv_max.x - uv_min.x) * static_cast<float>(depth_pyramid.width);
+        const float height_pixels = (uv_max.y - uv_min.y) * static_cast<float>(depth_pyramid.height);
+        const float size          = max(max(width_pixels, height_pixels), 1.0f);
+        const uint32_t mip        = min(static_cast<uint32_t>(ceil(log2(size))), static_cast<uint32_t>(depth_pyramid.mips.size()) - 1);
+
+        // Texels which cover the rectangle, picked from the pixels of the top mip, as texel x of mip n covers pixels [x << n, (x + 1) << n)
+        const uint32_t mip_width  = max(depth_pyramid.width  >> mip, 1u);
+        const uint32_t mip_height = max(depth_pyramid.height >> mip, 1u);
+        const uint32_t x_min      = min(static_cast<uint32_t>(floor(uv_min.x * depth_pyramid.width)),  depth_pyramid.width  - 1);
+        const uint32_t y_min      = min(static_cast<uint32_t>(floor(uv_min.y * depth_pyramid.height)), depth_pyramid.height - 1);
+        const uint32_t x_max      = min(static_cast<uint32_t>(floor(uv_max.x * depth_pyramid.width)),  depth_pyramid.width  - 1);
+        const uint32_t y_max      = min(static_cast<uint32_t>(floor(uv_max.y * depth_pyramid.height)), depth_pyramid.height - 1);
+
+        // A mip is half the size of the one above it, rounded down, so the last row or column of an odd sized mip is not part of
+        // any texel below it, and a side which is down to one texel stops halving. There is no depth to compare against past the
+        // pixels that the mip covers, so consider the object visible.
+        const uint32_t covered_width  = mip_width  << min(mip, static_cast<uint32_t>(bit_width(depth_pyramid.width))  - 1);
+        const uint32_t covered_height = mip_height << min(mip, static_cast<uint32_t>(bit_width(depth_pyramid.height)) - 1);
+        if (x_max >= covered_width || y_max >= covered_height)
+            return false;
+
+        const float depth_farthest = min(
+            min(depth_pyramid.Load(mip, x_min >> mip, y_min >> mip), depth_pyramid.Load(mip, x_max >> mip, y_min >> mip)),
+            min(depth_pyramid.Load(mip, x_min >> mip, y_max >> mip), depth_pyramid.Load(mip, x_max >> mip, y_max >> mip))
+        );
+
+        // Occluded if even the nearest point of the object is behind everything that was rendered there
+        return depth_nearest < depth_farthest;
+    }
+
+    void Culling::BuildDepthPyramid(const float* depth, const uint32_t width, const uint32_t height, DepthPyramid* depth_pyramid)
+    {
+        SP_ASSERT(depth != nullptr && depth_pyramid != nullptr);
+        SP_ASSERT(width != 0 && height != 0);
+
+        depth_pyramid->width  = width;
+        depth_pyramid->height = height;
+        depth_pyramid->mips.clear();
+        depth_pyramid->mips.emplace_back(depth, depth + width * height);
+
+        uint32_t mip_width  = width;
+        uint32_t mip_height = height;
+        while (mip_width > 1 || mip_height > 1)
+        {
+            const vector<float>& source   = depth_pyramid->mips.back();
+            const uint32_t source_width   = mip_width;
+            const uint32_t source_height  = mip_height;
+            mip_width                     = max(mip_width  / 2, 1u);
+            mip_height                    = max(mip_height / 2, 1u);
+
+            vector<float> mip(mip_width * mip_height);
+            for (uint32_t y = 0; y < mip_height; y++)
+            {
+                for (uint32_t x = 0; x < mip_width; x++)
+                {
+                    const uint32_t x0 = min(x * 2, source_width - 1),  x1 = min(x * 2 + 1, source_width - 1);
+                    const uint32_t y0 = min(y * 2, source_height - 1), y1 = min(y * 2 + 1, source_height - 1);
+
+                    mip[y * mip_width + x] = min(
+                        min(source[y0 * source_width + x0], source[y0 * source_width + x1]),
+                        min(source[y1 * source_width + x0], source[y1 * source_width + x1])
+                    );
+                }
+            }
+
+            depth_pyramid->mips.emplace_back(move(mip));
+        }
+    }
+}
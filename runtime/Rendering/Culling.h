@@ -0,0 +1,83 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include "../RHI/RHI_Definition.h"
+#include "../Math/Matrix.h"
+#include "../Math/Vector3.h"
+//=================================
+
+namespace Spartan
+{
+    // Per-object culling input, the layout matches CullingObject in common_texture.hlsl
+    struct CullingObject
+    {
+        Math::Matrix transform  = Math::Matrix::Identity; // also read by the vertex shader of indirect draws
+        Math::Vector3 aabb_min  = Math::Vector3::Zero;    // world space
+        uint32_t index_count    = 0;
+        Math::Vector3 aabb_max  = Math::Vector3::Zero;    // world space
+        uint32_t index_offset   = 0;
+        int32_t vertex_offset   = 0;
+        uint32_t padding[3]     = { 0, 0, 0 };
+    };
+
+    // Reverse-z hierarchical depth, each texel of mip n + 1 holds the farthest (min) depth of the 2x2 texels it covers in mip n.
+    // Like the GPU pyramid, mip sizes are rounded down, so the last row or column of an odd sized mip is not reduced any further.
+    struct DepthPyramid
+    {
+        bool IsValid() const { return !mips.empty(); }
+        float Load(uint32_t mip, uint32_t x, uint32_t y) const;
+
+        uint32_t width  = 0;
+        uint32_t height = 0;
+        std::vector<std::vector<float>> mips;
+    };
+
+    // CPU reference of the GPU culling kernel (culling.hlsl), it has no renderer or RHI dependencies,
+    // so its output can be validated without a device. Both must be kept in sync.
+    class SP_CLASS Culling
+    {
+    public:
+        // Capacity of the GPU culling buffers, objects past this point are culled and drawn by the CPU
+        static constexpr uint32_t object_count_max = 8192;
+
+        // Writes an indirect draw for every visible object into draws_out (compacted) and returns how many were written.
+        // Objects are tested against the frustum of view_projection and, if a depth pyramid is provided,
+        // against the depth of the previous frame (which the pyramid was built with, using view_projection_previous).
+        static uint32_t Cull(
+            const CullingObject* objects,
+            const uint32_t object_count,
+            const Math::Matrix& view_projection,
+            const Math::Matrix& view_projection_previous,
+            const DepthPyramid* depth_pyramid,
+            RHI_Indirect_DrawIndexed* draws_out
+        );
+
+        static bool IsInFrustum(const CullingObject& object, const Math::Matrix& view_projection);
+        static bool IsOccluded(const CullingObject& object, const Math::Matrix& view_projection_previous, const DepthPyramid& depth_pyramid);
+
+        static void BuildDepthPyramid(const float* depth, const uint32_t width, const uint32_t height, DepthPyramid* depth_pyramid);
+    };
+}
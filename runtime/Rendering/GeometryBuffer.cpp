@@ -0,0 +1,305 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ======================
+#include "pch.h"
+#include "GeometryBuffer.h"
+#include "Renderer.h"
+#include "../RHI/RHI_Vertex.h"
+#include "../RHI/RHI_VertexBuffer.h"
+#include "../RHI/RHI_IndexBuffer.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        // First-fit free-list over a range of elements, adjacent free ranges are merged
+        class FreeList
+        {
+        public:
+            void Initialize(const uint32_t capacity)
+            {
+                m_capacity = capacity;
+                m_used     = 0;
+                m_free.clear();
+                m_free[0] = capacity;
+            }
+
+            bool Allocate(const uint32_t count, uint32_t* offset)
+            {
+                for (auto it = m_free.begin(); it != m_free.end(); it++)
+                {
+                    if (it->second < count)
+                        continue;
+
+                    *offset = it->first;
+
+                    // Shrink or remove the free range
+                    const uint32_t remaining = it->second - count;
+                    m_free.erase(it);
+                    if (remaining != 0)
+                    {
+                        m_free[*offset + count] = remaining;
+                    }
+
+                    m_used += count;
+                    return true;
+                }
+
+                return false;
+            }
+
+            void Free(const uint32_t offset, const uint32_t count)
+            {
+                SP_ASSERT(m_used >= count);
+                m_used -= count;
+
+                auto it = m_free.emplace(offset, count).first;
+
+                // Merge with the next range
+                auto it_next = next(it);
+                if (it_next != m_free.end() && it->first + it->second == it_next->first)
+                {
+                    it->second += it_next->second;
+                    m_free.erase(it_next);
+                }
+
+                // Merge with the previous range
+                if (it != m_free.begin())
+                {
+                    auto it_previous = prev(it);
+                    if (it_previous->first + it_previous->second == it->first)
+                    {
+                        it_previous->second += it->second;
+                        m_free.erase(it);
+                    }
+                }
+            }
+
+            uint32_t GetCapacity() const { return m_capacity; }
+            uint32_t GetUsed()     const { return m_used; }
+
+        private:
+            map<uint32_t, uint32_t> m_free; // offset -> count
+            uint32_t m_capacity = 0;
+            uint32_t m_used     = 0;
+        };
+
+        struct Block
+        {
+            shared_ptr<RHI_VertexBuffer> vertex_buffer; // device local
+            shared_ptr<RHI_IndexBuffer> index_buffer;   // device local
+            FreeList vertices;
+            FreeList indices;
+        };
+
+        // About 46 MB of vertices and 12 MB of indices per block, larger meshes get a block of their own size
+        static const uint32_t block_vertex_count = 1 << 20;
+        static const uint32_t block_index_count  = 3 << 20;
+
+        static vector<unique_ptr<Block>> blocks;
+        static vector<pair<uint64_t, GeometryAllocation>> frees_pending; // frame the allocation was freed in, allocation
+        static mutex mutex_blocks;
+        static bool initialized = false;
+
+        static uint32_t create_block(const uint32_t vertex_count, const uint32_t index_count)
+        {
+            unique_ptr<Block> block = make_unique<Block>();
+
+            block->vertex_buffer = make_shared<RHI_VertexBuffer>(false, "geometry_buffer");
+            block->vertex_buffer->CreateStatic<RHI_Vertex_PosTexNorTan>(vertex_count);
+
+            block->index_buffer = make_shared<RHI_IndexBuffer>(false, "geometry_buffer");
+            block->index_buffer->CreateStatic<uint32_t>(index_count);
+
+            block->vertices.Initialize(vertex_count);
+            block->indices.Initialize(index_count);
+
+            blocks.emplace_back(move(block));
+            return static_cast<uint32_t>(blocks.size() - 1);
+        }
+
+        static void release(const GeometryAllocation& allocation)
+        {
+            Block* block = blocks[allocation.block].get();
+
+            block->vertices.Free(allocation.vertex_offset, allocation.vertex_count);
+            block->indices.Free(allocation.index_offset, allocation.index_count);
+        }
+
+        static void release_pending_frees()
+        {
+            // A range can only be re-used once the GPU is done with the frames that could have referenced it
+            const uint64_t frame_num        = Renderer::GetFrameNum();
+            const uint64_t frames_in_flight = static_cast<uint64_t>(Renderer::GetFramesInFlight()) + 1;
+
+            auto it = frees_pending.begin();
+            while (it != frees_pending.end())
+            {
+                if (it->first + frames_in_flight <= frame_num)
+                {
+                    release(it->second);
+                    it = frees_pending.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+    }
+
+    void GeometryBuffer::Initialize()
+    {
+        lock_guard<mutex> lock(mutex_blocks);
+
+        create_block(block_vertex_count, block_index_count);
+        initialized = true;
+    }
+
+    void GeometryBuffer::Shutdown()
+    {
+        lock_guard<mutex> lock(mutex_blocks);
+
+        frees_pending.clear();
+        blocks.clear();
+        initialized = false;
+    }
+
+    GeometryAllocation GeometryBuffer::Allocate(const vector<RHI_Vertex_PosTexNorTan>& vertices, const vector<uint32_t>& indices)
+    {
+        SP_ASSERT_MSG(!vertices.empty(), "There are no vertices");
+        SP_ASSERT_MSG(!indices.empty(),  "There are no indices");
+
+        lock_guard<mutex> lock(mutex_blocks);
+        SP_ASSERT_MSG(initialized, "The geometry buffer hasn't been initialized");
+
+        release_pending_frees();
+
+        GeometryAllocation allocation;
+        allocation.vertex_count = static_cast<uint32_t>(vertices.size());
+        allocation.index_count  = static_cast<uint32_t>(indices.size());
+
+        // Find a block with enough space for both the vertices and the indices
+        bool found = false;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(blocks.size()) && !found; i++)
+        {
+            Block* block = blocks[i].get();
+
+            if (!block->vertices.Allocate(allocation.vertex_count, &allocation.vertex_offset))
+                continue;
+
+            if (!block->indices.Allocate(allocation.index_count, &allocation.index_offset))
+            {
+                block->vertices.Free(allocation.vertex_offset, allocation.vertex_count);
+                continue;
+            }
+
+            allocation.block = i;
+            found            = true;
+        }
+
+        // Grow by adding a block, large enough for this mesh
+        if (!found)
+        {
+            allocation.block = create_block(max(block_vertex_count, allocation.vertex_count), max(block_index_count, allocation.index_count));
+            Block* block     = blocks[allocation.block].get();
+            block->vertices.Allocate(allocation.vertex_count, &allocation.vertex_offset);
+            block->indices.Allocate(allocation.index_count, &allocation.index_offset);
+
+            SP_LOG_INFO("Geometry buffer has grown to %d blocks", static_cast<uint32_t>(blocks.size()));
+        }
+
+        // Upload the geometry to its range of the block, through a staging buffer
+        Block* block = blocks[allocation.block].get();
+        block->vertex_buffer->Update(
+            vertices.data(),
+            static_cast<uint64_t>(allocation.vertex_offset) * sizeof(RHI_Vertex_PosTexNorTan),
+            static_cast<uint64_t>(allocation.vertex_count)  * sizeof(RHI_Vertex_PosTexNorTan)
+        );
+        block->index_buffer->Update(
+            indices.data(),
+            static_cast<uint64_t>(allocation.index_offset) * sizeof(uint32_t),
+            static_cast<uint64_t>(allocation.index_count)  * sizeof(uint32_t)
+        );
+
+        allocation.vertex_buffer = block->vertex_buffer.get();
+        allocation.index_buffer  = block->index_buffer.get();
+
+        return allocation;
+    }
+    void GeometryBuffer::Free(GeometryAllocation& allocation)
+    {
+        if (!allocation.IsValid())
+            return;
+
+        lock_guard<mutex> lock(mutex_blocks);
+
+        // Meshes can outlive the renderer, in which case there is nothing left to free
+        if (initialized)
+        {
+            frees_pending.emplace_back(Renderer::GetFrameNum(), allocation);
+        }
+
+        allocation = GeometryAllocation();
+    }
+
+    uint32_t GeometryBuffer::GetBlockCount()
+    {
+        lock_guard<mutex> lock(mutex_blocks);
+
+        return static_cast<uint32_t>(blocks.size());
+    }
+
+    uint64_t GeometryBuffer::GetCapacity()
+    {
+        lock_guard<mutex> lock(mutex_blocks);
+
+        uint64_t size = 0;
+        for (const unique_ptr<Block>& block : blocks)
+        {
+            size += static_cast<uint64_t>(block->vertices.GetCapacity()) * sizeof(RHI_Vertex_PosTexNorTan);
+            size += static_cast<uint64_t>(block->indices.GetCapacity())  * sizeof(uint32_t);
+        }
+
+        return size;
+    }
+
+    uint64_t GeometryBuffer::GetUsed()
+    {
+        lock_guard<mutex> lock(mutex_blocks);
+
+        uint64_t size = 0;
+        for (const unique_ptr<Block>& block : blocks)
+        {
+            size += static_cast<uint64_t>(block->vertices.GetUsed()) * sizeof(RHI_Vertex_PosTexNorTan);
+            size += static_cast<uint64_t>(block->indices.GetUsed())  * sizeof(uint32_t);
+        }
+
+        return size;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <memory>
+#include "../RHI/RHI_Definition.h"
+#include "../Core/Definitions.h"
+//================================
+
+namespace Spartan
+{
+    // A range of vertices and indices, placed in one of the shared geometry buffers
+    struct GeometryAllocation
+    {
+        bool IsValid() const { return vertex_buffer != nullptr && index_buffer != nullptr; }
+
+        uint32_t block                  = 0;
+        uint32_t vertex_offset          = 0; // in vertices
+        uint32_t vertex_count           = 0;
+        uint32_t index_offset           = 0; // in indices
+        uint32_t index_count            = 0;
+        RHI_VertexBuffer* vertex_buffer = nullptr;
+        RHI_IndexBuffer* index_buffer   = nullptr;
+    };
+
+    // All meshes place their geometry in a few large vertex and index buffers, which are sub-allocated
+    // with a free-list. Draws of different meshes then only differ by offsets, so buffer re-binds are rare.
+    class SP_CLASS GeometryBuffer
+    {
+    public:
+        static void Initialize();
+        static void Shutdown();
+
+        static GeometryAllocation Allocate(const std::vector<RHI_Vertex_PosTexNorTan>& vertices, const std::vector<uint32_t>& indices);
+        static void Free(GeometryAllocation& allocation);
+
+        // Stats
+        static uint32_t GetBlockCount();
+        static uint64_t GetCapacity();
+        static uint64_t GetUsed();
+    };
+}
@@ -177,6 +177,8 @@ namespace Spartan
         {
             SetProperty(MaterialProperty::HeightMultiplier, multiplier);
         }
+
+        SetDirty(true);
     }
 
     void Material::SetTexture(const MaterialTexture type, const std::shared_ptr<RHI_Texture2D> texture)
@@ -261,6 +263,7 @@ namespace Spartan
         }
 
         m_properties[static_cast<uint32_t>(property_type)] = value;
+        SetDirty(true);
     }
 
     void Material::SetColor(const Color& color)
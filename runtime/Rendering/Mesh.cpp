@@ -25,8 +25,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Renderer.h"
 #include "../RHI/RHI_Vertex.h"
 #include "../RHI/RHI_Texture.h"
-#include "../RHI/RHI_VertexBuffer.h"
-#include "../RHI/RHI_IndexBuffer.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../World/Components/Renderable.h"
 #include "../World/Entity.h"
@@ -34,6 +32,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../IO/FileStream.h"
 #include "../Resource/Import/ModelImporter.h"
 #include "../World/Components/Transform.h"
+#include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
 SP_WARNINGS_OFF
 #include "meshoptimizer/meshoptimizer.h"
 SP_WARNINGS_ON
@@ -51,6 +51,11 @@ namespace Spartan
         m_flags = GetDefaultFlags();
     }
 
+    Mesh::~Mesh()
+    {
+        GeometryBuffer::Free(m_geometry_allocation);
+    }
+
     void Mesh::Clear()
     {
         m_indices.clear();
@@ -58,10 +63,14 @@ namespace Spartan
 
         m_vertices.clear();
         m_vertices.shrink_to_fit();
+
+        SetDirty(true);
     }
 
     bool Mesh::LoadFromFile(const string& file_path)
     {
+        SP_MEMORY_TAG(ResourceMesh);
+        Profiler::AddTraceEvent("Resource", "Load " + file_path);
         const Stopwatch timer;
 
         if (file_path.empty() || FileSystem::IsDirectory(file_path))
@@ -111,10 +120,10 @@ namespace Spartan
             m_object_size_cpu = GetMemoryUsage();
 
             // Gpu
-            if (m_vertex_buffer && m_index_buffer)
+            if (m_geometry_allocation.IsValid())
             {
-                m_object_size_gpu = m_vertex_buffer->GetObjectSizeGpu();
-                m_object_size_gpu += m_index_buffer->GetObjectSizeGpu();
+                m_object_size_gpu  = m_geometry_allocation.vertex_count * sizeof(RHI_Vertex_PosTexNorTan);
+                m_object_size_gpu += m_geometry_allocation.index_count  * sizeof(uint32_t);
             }
         }
 
@@ -181,6 +190,7 @@ namespace Spartan
         }
 
         m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+        SetDirty(true);
     }
 
     void Mesh::AddIndices(const vector<uint32_t>& indices, uint32_t* index_offset_out /*= nullptr*/)
@@ -193,6 +203,7 @@ namespace Spartan
         }
 
         m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+        SetDirty(true);
     }
 
     uint32_t Mesh::GetVertexCount() const
@@ -258,13 +269,13 @@ namespace Spartan
 
     void Mesh::CreateGpuBuffers()
     {
-        SP_ASSERT_MSG(!m_indices.empty(), "There are no indices");
-        m_index_buffer = make_shared<RHI_IndexBuffer>(false, "mesh");
-        m_index_buffer->Create(m_indices);
+        // Release the previous range (if any), it will be re-used once the GPU is done with it
+        GeometryBuffer::Free(m_geometry_allocation);
+
+        m_geometry_allocation = GeometryBuffer::Allocate(m_vertices, m_indices);
 
-        SP_ASSERT_MSG(!m_vertices.empty(), "There are no vertices");
-        m_vertex_buffer = make_shared<RHI_VertexBuffer>(false, "mesh");
-        m_vertex_buffer->Create(m_vertices);
+        // The geometry changed, so the native file has to be written again (loading resets this, the file is what was loaded)
+        SetDirty(true);
     }
 
     void Mesh::AddMaterial(shared_ptr<Material>& material, const shared_ptr<Entity>& entity) const
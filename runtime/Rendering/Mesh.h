@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/IResource.h"
 #include "../Math/BoundingBox.h"
 #include "../RHI/RHI_Vertex.h"
+#include "GeometryBuffer.h"
 //================================
 
 namespace Spartan
@@ -43,7 +44,7 @@ namespace Spartan
     {
     public:
         Mesh();
-        ~Mesh() = default;
+        ~Mesh();
 
         // IResource
         bool LoadFromFile(const std::string& file_path) override;
@@ -79,8 +80,10 @@ namespace Spartan
 
         // GPU buffers
         void CreateGpuBuffers();
-        RHI_IndexBuffer* GetIndexBuffer()   { return m_index_buffer.get(); }
-        RHI_VertexBuffer* GetVertexBuffer() { return m_vertex_buffer.get(); }
+        RHI_IndexBuffer* GetIndexBuffer()      { return m_geometry_allocation.index_buffer; }
+        RHI_VertexBuffer* GetVertexBuffer()    { return m_geometry_allocation.vertex_buffer; }
+        uint32_t GetIndexBufferOffset() const  { return m_geometry_allocation.index_offset; }
+        uint32_t GetVertexBufferOffset() const { return m_geometry_allocation.vertex_offset; }
 
         // Root entity
         Entity* GetRootEntity() { return m_root_entity.lock().get(); }
@@ -98,9 +101,8 @@ namespace Spartan
         std::vector<RHI_Vertex_PosTexNorTan> m_vertices;
         std::vector<uint32_t> m_indices;
 
-        // GPU buffers
-        std::shared_ptr<RHI_VertexBuffer> m_vertex_buffer;
-        std::shared_ptr<RHI_IndexBuffer> m_index_buffer;
+        // GPU buffers (a range within the shared geometry buffers)
+        GeometryAllocation m_geometry_allocation;
 
         // AABB
         Math::BoundingBox m_aabb;
@@ -0,0 +1,433 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ====================
+#include "pch.h"
+#include "RenderGraph.h"
+#include "Renderer.h"
+#include "../RHI/RHI_Texture2D.h"
+#include "../RHI/RHI_CommandList.h"
+#include "../Core/FrameAllocator.h"
+//===============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        // How many frames an unused transient texture is kept around before it's released
+        static const uint64_t transient_frames_unused_max = 60;
+
+        static uint32_t to_index(const RendererTexture texture)
+        {
+            return static_cast<uint32_t>(texture);
+        }
+
+        static string get_texture_name(const RendererTexture texture)
+        {
+            if (shared_ptr<RHI_Texture> rt = Renderer::GetRenderTarget(texture))
+                return rt->GetName();
+
+            return "rt_" + to_string(to_index(texture));
+        }
+
+        static uint64_t get_texture_size(const RenderGraphTextureDesc& desc)
+        {
+            const uint64_t bytes_per_pixel = (rhi_format_to_bits_per_channel(desc.format) * rhi_to_format_channel_count(desc.format)) / 8;
+
+            uint64_t size = 0;
+            for (uint32_t mip = 0; mip < desc.mip_count; mip++)
+            {
+                const uint64_t width  = max(desc.width  >> mip, 1u);
+                const uint64_t height = max(desc.height >> mip, 1u);
+                size += width * height * bytes_per_pixel;
+            }
+
+            return size;
+        }
+
+        static uint64_t get_layout_key(const char* pass_name, const RendererTexture texture)
+        {
+            return (hash<string_view>()(pass_name) << 8) ^ static_cast<uint64_t>(texture);
+        }
+
+        static bool get_layout(RHI_Texture* texture, RHI_Image_Layout* layout)
+        {
+            *layout = texture->GetLayout(0);
+            for (uint32_t mip = 1; mip < texture->GetMipCount(); mip++)
+            {
+                if (texture->GetLayout(mip) != *layout)
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    RenderGraph::RenderGraph()
+    {
+        m_aliases.fill(-1);
+    }
+
+    void RenderGraph::SetTransient(const RendererTexture texture, const RenderGraphTextureDesc& desc)
+    {
+        SP_ASSERT(to_index(texture) < texture_count);
+
+        m_transient_descs[to_index(texture)] = make_unique<RenderGraphTextureDesc>(desc);
+    }
+
+    void RenderGraph::Begin()
+    {
+        m_pass_count = 0;
+        m_outputs.clear();
+        m_compiled = false;
+        m_frame++;
+    }
+
+    void RenderGraph::AddPass(const char* name, const RenderGraphTextures& reads, const RenderGraphTextures& writes, function<void(RHI_CommandList*)>&& execute, const bool has_side_effects)
+    {
+        SP_ASSERT_MSG(!m_compiled, "Passes have to be added before the graph is compiled");
+
+        if (m_pass_count == m_passes.size())
+        {
+            m_passes.emplace_back();
+        }
+
+        Pass& pass            = m_passes[m_pass_count++];
+        pass.name             = name;
+        pass.reads.assign(reads.begin(), reads.end());
+        pass.writes.assign(writes.begin(), writes.end());
+        pass.execute          = move(execute);
+        pass.has_side_effects = has_side_effects;
+    }
+
+    void RenderGraph::AddOutput(const RendererTexture texture)
+    {
+        SP_ASSERT_MSG(!m_transient_descs[to_index(texture)], "Transient render targets can't outlive the frame");
+
+        m_outputs.emplace_back(texture);
+    }
+
+    void RenderGraph::Compile()
+    {
+        const int32_t pass_count = static_cast<int32_t>(m_pass_count);
+
+        // Cull passes, walking backwards from the outputs, a pass survives if a later pass (or the frame) consumes what it writes
+        {
+            array<bool, texture_count> needed = {};
+            for (const RendererTexture texture : m_outputs)
+            {
+                needed[to_index(texture)] = true;
+            }
+
+            m_pass_count_culled = 0;
+            for (int32_t i = pass_count - 1; i >= 0; i--)
+            {
+                Pass& pass = m_passes[i];
+
+                bool consumed = pass.has_side_effects;
+                for (const RendererTexture texture : pass.writes)
+                {
+                    consumed = consumed || needed[to_index(texture)];
+                }
+
+                pass.culled = !consumed;
+                if (pass.culled)
+                {
+                    m_pass_count_culled++;
+                    continue;
+                }
+
+                for (const RendererTexture texture : pass.reads)
+                {
+                    needed[to_index(texture)] = true;
+                }
+            }
+        }
+
+        // Derive lifetimes and the points where a texture changes from being written to being read (or vice versa)
+        {
+            enum class Access : uint8_t { None, Read, Write };
+            array<Access, texture_count> access = {};
+
+            m_lifetimes.fill(Lifetime());
+            m_transition_count = 0;
+            for (int32_t i = 0; i < pass_count; i++)
+            {
+                Pass& pass = m_passes[i];
+                pass.transitions.clear();
+
+                if (pass.culled)
+                    continue;
+
+                auto touch = [this, &pass, &access, i](const RendererTexture texture, const Access access_new)
+                {
+                    Lifetime& lifetime = m_lifetimes[to_index(texture)];
+                    lifetime.first     = lifetime.first == -1 ? i : lifetime.first;
+                    lifetime.last      = i;
+
+                    // Write after write still needs a barrier since passes can write through unordered access views
+                    Access& access_current = access[to_index(texture)];
+                    if (access_current != access_new || access_new == Access::Write)
+                    {
+                        pass.transitions.emplace_back(texture);
+                        m_transition_count++;
+                    }
+                    access_current = access_new;
+                };
+
+                for (const RendererTexture texture : pass.reads)
+                {
+                    touch(texture, Access::Read);
+                }
+
+                for (const RendererTexture texture : pass.writes)
+                {
+                    touch(texture, Access::Write);
+                }
+            }
+        }
+
+        // Release transients which have not been used for a while
+        for (auto it = m_pool.begin(); it != m_pool.end();)
+        {
+            it = (it->frame_used + transient_frames_unused_max < m_frame) ? m_pool.erase(it) : it + 1;
+        }
+
+        // Assign transients to pooled textures, in order of first use, re-using a texture once its previous user is done with it
+        {
+            pmr::vector<uint32_t> transients = frame_vector<uint32_t>();
+            for (uint32_t i = 0; i < texture_count; i++)
+            {
+                m_aliases[i] = -1;
+
+                if (m_transient_descs[i] && m_lifetimes[i].first != -1)
+                {
+                    transients.emplace_back(i);
+                }
+            }
+
+            sort(transients.begin(), transients.end(), [this](const uint32_t a, const uint32_t b)
+            {
+                return m_lifetimes[a].first < m_lifetimes[b].first;
+            });
+
+            for (PooledTexture& pooled : m_pool)
+            {
+                pooled.busy_until = -1;
+            }
+
+            for (const uint32_t index : transients)
+            {
+                const RenderGraphTextureDesc& desc = *m_transient_descs[index];
+                const Lifetime& lifetime           = m_lifetimes[index];
+
+                int32_t pool_index = -1;
+                for (uint32_t i = 0; i < static_cast<uint32_t>(m_pool.size()); i++)
+                {
+                    if (m_pool[i].busy_until < lifetime.first && m_pool[i].desc == desc)
+                    {
+                        pool_index = static_cast<int32_t>(i);
+                        break;
+                    }
+                }
+
+                if (pool_index == -1)
+                {
+                    PooledTexture& pooled = m_pool.emplace_back();
+                    pooled.desc           = desc;
+                    pooled.texture        = make_shared<RHI_Texture2D>(desc.width, desc.height, desc.mip_count, desc.format, desc.flags, desc.name.c_str());
+                    pool_index            = static_cast<int32_t>(m_pool.size()) - 1;
+                }
+
+                m_pool[pool_index].busy_until = lifetime.last;
+                m_pool[pool_index].frame_used = m_frame;
+                m_aliases[index]              = pool_index;
+            }
+
+            // Transients which no pass uses this frame (e.g. the effect is disabled) let go of the texture they were bound to last,
+            // so that only the pool keeps it alive, and once the pool evicts it, it reaches the deletion queue
+            for (uint32_t i = 0; i < texture_count; i++)
+            {
+                if (m_transient_descs[i] && m_aliases[i] == -1)
+                {
+                    Renderer::GetRenderTargets()[i] = nullptr;
+                }
+            }
+        }
+
+        m_compiled = true;
+    }
+
+    void RenderGraph::Execute(RHI_CommandList* cmd_list)
+    {
+        SP_ASSERT_MSG(m_compiled, "The graph has to be compiled before it's executed");
+
+        m_barrier_count         = 0;
+        m_barrier_count_skipped = 0;
+        for (int32_t i = 0; i < static_cast<int32_t>(m_pass_count); i++)
+        {
+            Pass& pass = m_passes[i];
+            if (pass.culled)
+                continue;
+
+            // Bind the transients which come to life in this pass
+            for (uint32_t texture = 0; texture < texture_count; texture++)
+            {
+                if (m_aliases[texture] != -1 && m_lifetimes[texture].first == i)
+                {
+                    Renderer::GetRenderTargets()[texture] = m_pool[m_aliases[texture]].texture;
+                }
+            }
+
+            // Issue the transitions up front, in the layout the pass left the texture in the last time it ran (the first time
+            // around the pass transitions its textures lazily, as it binds them). A transition is redundant when the texture is
+            // already in that layout, unless it's a storage layout, where the writes still have to be made visible.
+            for (const RendererTexture texture : pass.transitions)
+            {
+                auto it = m_layouts.find(get_layout_key(pass.name, texture));
+                RHI_Texture* rt = Renderer::GetRenderTarget(texture).get();
+                if (it == m_layouts.end() || !rt)
+                    continue;
+
+                RHI_Image_Layout layout_current = RHI_Image_Layout::Undefined;
+                if (get_layout(rt, &layout_current) && layout_current == it->second && it->second != RHI_Image_Layout::General)
+                {
+                    m_barrier_count_skipped++;
+                    continue;
+                }
+
+                cmd_list->InsertBarrierTexture(rt, it->second);
+                m_barrier_count++;
+            }
+
+            pass.execute(cmd_list);
+
+            // Learn the layouts the pass leaves its textures in
+            for (const RendererTexture texture : pass.transitions)
+            {
+                RHI_Image_Layout layout = RHI_Image_Layout::Undefined;
+                RHI_Texture* rt         = Renderer::GetRenderTarget(texture).get();
+                if (rt && get_layout(rt, &layout) && layout != RHI_Image_Layout::Undefined)
+                {
+                    m_layouts[get_layout_key(pass.name, texture)] = layout;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::ReleaseTransients()
+    {
+        m_pool.clear();
+        m_aliases.fill(-1);
+        m_layouts.clear();
+
+        for (uint32_t texture = 0; texture < texture_count; texture++)
+        {
+            if (m_transient_descs[texture])
+            {
+                Renderer::GetRenderTargets()[texture] = nullptr;
+            }
+        }
+    }
+
+    uint64_t RenderGraph::GetTransientMemory() const
+    {
+        uint64_t size = 0;
+        for (const PooledTexture& pooled : m_pool)
+        {
+            size += get_texture_size(pooled.desc);
+        }
+
+        return size;
+    }
+
+    string RenderGraph::GetSchedule() const
+    {
+        stringstream ss;
+
+        ss << "Render graph, frame " << m_frame << ": " << m_pass_count << " passes (" << m_pass_count_culled << " culled), ";
+        ss << m_transition_count << " transitions (" << m_barrier_count << " barriers issued, " << m_barrier_count_skipped << " redundant), " << m_pool.size() << " transient textures (" << GetTransientMemory() / (1024 * 1024) << " MB)\n";
+
+        auto write_textures = [&ss](const char* label, const vector<RendererTexture>& textures)
+        {
+            if (textures.empty())
+                return;
+
+            ss << "        " << label << ":";
+            for (const RendererTexture texture : textures)
+            {
+                ss << " " << get_texture_name(texture);
+            }
+            ss << "\n";
+        };
+
+        ss << "\nPasses\n";
+        for (uint32_t i = 0; i < m_pass_count; i++)
+        {
+            const Pass& pass = m_passes[i];
+
+            ss << "    " << i << ": " << pass.name << (pass.culled ? " (culled)" : "") << (pass.has_side_effects ? " (side effects)" : "") << "\n";
+            write_textures("reads",       pass.reads);
+            write_textures("writes",      pass.writes);
+            write_textures("transitions", pass.transitions);
+        }
+
+        ss << "\nTransients\n";
+        for (uint32_t i = 0; i < texture_count; i++)
+        {
+            if (!m_transient_descs[i])
+                continue;
+
+            const RenderGraphTextureDesc& desc = *m_transient_descs[i];
+            ss << "    " << desc.name << " " << desc.width << "x" << desc.height << " mips " << desc.mip_count << " " << rhi_format_to_string(desc.format);
+            if (m_aliases[i] == -1)
+            {
+                ss << ": unused\n";
+            }
+            else
+            {
+                ss << ": texture " << m_aliases[i] << ", passes " << m_lifetimes[i].first << " to " << m_lifetimes[i].last << "\n";
+            }
+        }
+
+        return ss.str();
+    }
+
+    bool RenderGraph::SaveSchedule(const string& file_path) const
+    {
+        ofstream fout(file_path, ofstream::out);
+        if (!fout.is_open())
+        {
+            SP_LOG_ERROR("Failed to open \"%s\" for writing", file_path.c_str());
+            return false;
+        }
+
+        fout << GetSchedule();
+        fout.close();
+
+        return true;
+    }
+}
@@ -0,0 +1,173 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ====================
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include "Renderer_Definitions.h"
+#include "../RHI/RHI_Definition.h"
+//===============================
+
+namespace Spartan
+{
+    // Description of a render target which is owned by the graph instead of the renderer
+    struct RenderGraphTextureDesc
+    {
+        bool operator==(const RenderGraphTextureDesc& rhs) const
+        {
+            return width == rhs.width && height == rhs.height && mip_count == rhs.mip_count && format == rhs.format && flags == rhs.flags;
+        }
+
+        uint32_t width      = 0;
+        uint32_t height     = 0;
+        uint32_t mip_count  = 1;
+        RHI_Format format   = RHI_Format_Undefined;
+        uint32_t flags      = 0;
+        std::string name;
+    };
+
+    // The render targets which a pass reads or writes. They are copied into inline storage, so that braced lists and
+    // containers can be passed without allocating, and without pointing into a braced list which only lives until the end of the call.
+    class RenderGraphTextures
+    {
+    public:
+        static constexpr uint32_t capacity = 16;
+
+        RenderGraphTextures(std::initializer_list<RendererTexture> textures) { Assign(textures.begin(), textures.size()); }
+
+        template<typename Container>
+        RenderGraphTextures(const Container& textures) { Assign(textures.data(), textures.size()); }
+
+        const RendererTexture* begin() const { return m_textures.data(); }
+        const RendererTexture* end()   const { return m_textures.data() + m_count; }
+
+    private:
+        void Assign(const RendererTexture* textures, const size_t count)
+        {
+            SP_ASSERT_MSG(count <= capacity, "Too many textures for a single pass");
+
+            m_count = static_cast<uint32_t>(count);
+            std::copy(textures, textures + m_count, m_textures.begin());
+        }
+
+        std::array<RendererTexture, capacity> m_textures;
+        uint32_t m_count = 0;
+    };
+
+    // A per-frame schedule of passes which declare the render targets they read and write.
+    // Compiling the graph culls passes whose writes are never consumed, derives the lifetime of every
+    // transient render target and lets transients with identical descriptions and disjoint lifetimes
+    // share the same texture. Transients which are not used by any surviving pass are never allocated.
+    // Executing it issues the barriers of every pass before the pass runs, in the layouts the pass used
+    // them in the last time it ran, and skips the ones which the texture's current state makes redundant.
+    class SP_CLASS RenderGraph
+    {
+    public:
+        RenderGraph();
+        ~RenderGraph() = default;
+
+        // Render targets registered here are allocated (and aliased) by the graph, the rest are imported from the renderer.
+        // Registration persists across frames and is expected to be refreshed whenever the resolution changes.
+        void SetTransient(const RendererTexture texture, const RenderGraphTextureDesc& desc);
+
+        // Declaration - has to happen in execution order, every frame
+        void Begin();
+        void AddPass(
+            const char* name,
+            const RenderGraphTextures& reads,
+            const RenderGraphTextures& writes,
+            std::function<void(RHI_CommandList*)>&& execute,
+            const bool has_side_effects = false
+        );
+        void AddOutput(const RendererTexture texture); // anything that outlives the frame (presented, history, etc)
+
+        // Compilation and execution
+        void Compile();
+        void Execute(RHI_CommandList* cmd_list);
+
+        // Frees all the transient textures, they will be re-allocated on demand
+        void ReleaseTransients();
+
+        // Inspection
+        std::string GetSchedule() const;
+        bool SaveSchedule(const std::string& file_path) const;
+        uint32_t GetPassCount() const           { return m_pass_count; }
+        uint32_t GetPassCountCulled() const     { return m_pass_count_culled; }
+        uint32_t GetTransitionCount() const     { return m_transition_count; }
+        uint32_t GetBarrierCount() const        { return m_barrier_count; }
+        uint32_t GetBarrierCountSkipped() const { return m_barrier_count_skipped; }
+        uint32_t GetTransientCount() const      { return static_cast<uint32_t>(m_pool.size()); }
+        uint64_t GetTransientMemory() const;
+
+    private:
+        static constexpr uint32_t texture_count = static_cast<uint32_t>(RendererTexture::outline) + 1;
+
+        // Rebuilt every frame into the same slots, so the vectors keep their capacity. They are read until the
+        // next Begin() (schedule, stats), which is past the end of the frame, so they can't use the frame allocator.
+        struct Pass
+        {
+            const char* name = nullptr;
+            std::vector<RendererTexture> reads;
+            std::vector<RendererTexture> writes;
+            std::function<void(RHI_CommandList*)> execute;
+            std::vector<RendererTexture> transitions; // textures whose access changes going into this pass
+            bool has_side_effects = false;
+            bool culled           = false;
+        };
+
+        struct Lifetime
+        {
+            int32_t first = -1;
+            int32_t last  = -1;
+        };
+
+        struct PooledTexture
+        {
+            RenderGraphTextureDesc desc;
+            std::shared_ptr<RHI_Texture> texture;
+            int32_t busy_until     = -1; // last pass index using it in the current frame
+            uint64_t frame_used    = 0;
+        };
+
+        std::vector<Pass> m_passes; // the first m_pass_count are this frame's
+        uint32_t m_pass_count            = 0;
+        std::vector<RendererTexture> m_outputs;
+        std::vector<PooledTexture> m_pool;
+        std::array<std::unique_ptr<RenderGraphTextureDesc>, texture_count> m_transient_descs;
+        std::array<Lifetime, texture_count> m_lifetimes;
+        std::array<int32_t, texture_count> m_aliases; // pool index of every transient, this frame
+        std::unordered_map<uint64_t, RHI_Image_Layout> m_layouts; // the layout a pass left a texture in, keyed by pass name and texture
+        uint32_t m_pass_count_culled     = 0;
+        uint32_t m_transition_count      = 0;
+        uint32_t m_barrier_count         = 0;
+        uint32_t m_barrier_count_skipped = 0;
+        uint64_t m_frame             = 0;
+        bool m_compiled              = false;
+    };
+}
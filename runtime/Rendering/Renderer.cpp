@@ -40,6 +40,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Material.h"
 #include "Renderer_ConstantBuffers.h"
 #include "../RHI/RHI_SwapChain.h"
+#include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
+#include "GeometryBuffer.h"
+#include "RenderGraph.h"
+#include "../World/World.h"
+#include "../Core/EventBus.h"
 //==============================================
 
 //= NAMESPACES ===============
@@ -53,6 +59,8 @@ namespace Spartan
 {
     //= BUFFERS =============================================
     extern shared_ptr<RHI_StructuredBuffer> m_sb_spd_counter;
+    extern shared_ptr<RHI_StructuredBuffer> m_sb_culling_objects;
+    extern shared_ptr<RHI_StructuredBuffer> m_sb_draw_count;
     
     extern Cb_Frame m_cb_frame_cpu;
     extern shared_ptr<RHI_ConstantBuffer> m_cb_frame_gpu;
@@ -78,8 +86,9 @@ namespace Spartan
     extern shared_ptr<RHI_Texture> m_tex_gizmo_light_spot;
     
     // Misc
-    extern array<shared_ptr<RHI_Texture>, 26> m_render_targets;
-    extern array<shared_ptr<RHI_Shader>, 47> m_shaders;
+    extern array<shared_ptr<RHI_Texture>, 27> m_render_targets;
+    extern array<shared_ptr<RHI_Shader>, 50> m_shaders;
+    extern RenderGraph m_render_graph;
     extern bool m_ffx_fsr2_reset;
     
     // Resolution & Viewport
@@ -98,7 +107,7 @@ namespace Spartan
     Math::Vector2 m_jitter_offset = Math::Vector2::Zero;
     float m_near_plane            = 0.0f;
     float m_far_plane             = 1.0f;
-    uint64_t m_frame_num          = 0;
+    atomic<uint64_t> m_frame_num  = 0; // read by any thread releasing a resource
     bool m_is_odd_frame           = false;
     array<Material*, m_max_material_instances> m_material_instances;
     
@@ -106,7 +115,7 @@ namespace Spartan
     const uint32_t m_resolution_shadow_min = 128;
     
     // Resource management
-    unordered_map<RHI_Resource_Type, vector<void*>> m_deletion_queue;
+    map<uint64_t, unordered_map<RHI_Resource_Type, vector<void*>>> m_deletion_queue; // keyed by the frame the resources were released in
     vector<weak_ptr<RHI_Texture>> m_textures_mip_generation;
     
     // States
@@ -130,6 +139,101 @@ namespace Spartan
     unordered_map<RendererEntityType, vector<shared_ptr<Entity>>> m_renderables;
     shared_ptr<Camera> m_camera;
     Environment* m_environment = nullptr;
+
+    // Incremental registration, where each entity sits in the buckets so it can be removed without a search
+    static const uint32_t renderable_slot_invalid    = numeric_limits<uint32_t>::max();
+    static const uint32_t renderer_entity_type_count = static_cast<uint32_t>(RendererEntityType::reflection_probe) + 1;
+    struct RenderableSlots
+    {
+        RenderableSlots() { index.fill(renderable_slot_invalid); }
+        array<uint32_t, renderer_entity_type_count> index;
+    };
+    static unordered_map<Entity*, RenderableSlots> m_renderable_slots;
+    static vector<shared_ptr<Entity>> m_renderables_changed;
+    static vector<shared_ptr<Entity>> m_renderables_removed;
+
+    static void renderable_bucket_add(const RendererEntityType type, const shared_ptr<Entity>& entity)
+    {
+        vector<shared_ptr<Entity>>& bucket = m_renderables[type];
+        m_renderable_slots[entity.get()].index[static_cast<uint32_t>(type)] = static_cast<uint32_t>(bucket.size());
+        bucket.emplace_back(entity);
+    }
+
+    static void renderable_add(const shared_ptr<Entity>& entity)
+    {
+        if (Renderable* renderable = entity->GetComponent<Renderable>())
+        {
+            bool is_transparent = false;
+            bool is_visible     = true;
+
+            if (const Material* material = renderable->GetMaterial())
+            {
+                is_transparent = material->GetProperty(MaterialProperty::ColorA) < 1.0f;
+                is_visible     = material->GetProperty(MaterialProperty::ColorA) != 0.0f;
+            }
+
+            if (is_visible)
+            {
+                renderable_bucket_add(is_transparent ? RendererEntityType::geometry_transparent : RendererEntityType::geometry_opaque, entity);
+            }
+        }
+
+        if (entity->GetComponent<Light>())
+        {
+            renderable_bucket_add(RendererEntityType::light, entity);
+        }
+
+        if (Camera* camera = entity->GetComponent<Camera>())
+        {
+            renderable_bucket_add(RendererEntityType::camera, entity);
+            m_camera = camera->GetPtrShared<Camera>();
+        }
+
+        if (entity->GetComponent<ReflectionProbe>())
+        {
+            renderable_bucket_add(RendererEntityType::reflection_probe, entity);
+        }
+    }
+
+    // Swap and pop out of every bucket the entity is in, O(1) per bucket
+    static void renderable_remove(Entity* entity)
+    {
+        auto it = m_renderable_slots.find(entity);
+        if (it == m_renderable_slots.end())
+            return;
+
+        for (uint32_t type = 0; type < renderer_entity_type_count; type++)
+        {
+            const uint32_t index = it->second.index[type];
+            if (index == renderable_slot_invalid)
+                continue;
+
+            vector<shared_ptr<Entity>>& bucket = m_renderables[static_cast<RendererEntityType>(type)];
+            if (index != bucket.size() - 1)
+            {
+                bucket[index] = move(bucket.back());
+                m_renderable_slots.find(bucket[index].get())->second.index[type] = index;
+            }
+            bucket.pop_back();
+        }
+
+        if (m_camera && m_camera->GetEntity() == entity)
+        {
+            m_camera = nullptr;
+        }
+
+        m_renderable_slots.erase(it);
+    }
+
+    // Sorting moves entities around, so their slots have to be updated
+    static void renderable_slots_update(const RendererEntityType type)
+    {
+        const vector<shared_ptr<Entity>>& bucket = m_renderables[type];
+        for (uint32_t i = 0; i < static_cast<uint32_t>(bucket.size()); i++)
+        {
+            m_renderable_slots[bucket[i].get()].index[static_cast<uint32_t>(type)] = i;
+        }
+    }
     
     // Sync objects
     thread::id m_render_thread_id;
@@ -170,9 +274,11 @@ namespace Spartan
         //SetOption(RendererOption::VolumetricFog,       1.0f); // Disable by default because it's not that great, I need to do it with a voxelised approach.
 
         // Subscribe to events.
-        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolved,             SP_EVENT_HANDLER_VARIANT_STATIC(OnAddRenderables));
         SP_SUBSCRIBE_TO_EVENT(EventType::WorldClear,                SP_EVENT_HANDLER_STATIC(OnClear));
         SP_SUBSCRIBE_TO_EVENT(EventType::WindowOnFullScreenToggled, SP_EVENT_HANDLER_STATIC(OnFullScreenToggled));
+        EventChannel<WorldResolvedEvent>::Subscribe(OnAddRenderables);
+        EventChannel<WorldEntitiesChangedEvent>::Subscribe(OnEntitiesChanged);
+        EventChannel<WorldEntitiesRemovedEvent>::Subscribe(OnEntitiesRemoved);
 
         // Get thread id.
         m_render_thread_id = this_thread::get_id();
@@ -214,6 +320,9 @@ namespace Spartan
         m_cmd_pool = m_rhi_device->AllocateCommandPool("renderer", m_swap_chain->GetObjectId());
         m_cmd_pool->AllocateCommandLists(RHI_Queue_Type::Graphics, 2, 2);
 
+        // Create the buffers that all mesh geometry lives in
+        GeometryBuffer::Initialize();
+
         // Set the output and viewport resolution to the display resolution.
         // If the editor is running, it will set the viewport resolution to whatever the viewport.
         
@@ -239,12 +348,14 @@ namespace Spartan
         SP_FIRE_EVENT(EventType::RendererOnShutdown);
 
         // Deconstructor will add them it to the deletion queue
+        m_render_graph.ReleaseTransients();
         m_render_targets.fill(nullptr);
         m_shaders.fill(nullptr);
         m_environment_texture = nullptr;
+        GeometryBuffer::Shutdown();
 
         // Delete all remaining RHI resources
-        ParseDeletionQueue();
+        ParseDeletionQueue(true);
 
         // Log to file as the renderer is no more
         Log::SetLogToFile(true);
@@ -255,6 +366,8 @@ namespace Spartan
 
     void Renderer::Tick()
     {
+        SP_MEMORY_TAG(Renderer);
+
         // After the first frame has completed, we can be sure that the renderer is working.
         if (m_frame_num == 1)
         {
@@ -293,6 +406,9 @@ namespace Spartan
         m_cmd_current = m_cmd_pool->GetCurrentCommandList();
         m_cmd_current->Begin();
 
+        // Release resources which the GPU is guaranteed to be done with
+        ParseDeletionQueue();
+
         if (reset)
         {
             // Reset dynamic buffer indices
@@ -301,6 +417,8 @@ namespace Spartan
             m_cb_light_gpu->ResetOffset();
             m_cb_material_gpu->ResetOffset();
             m_sb_spd_counter->ResetOffset();
+            m_sb_culling_objects->ResetOffset();
+            m_sb_draw_count->ResetOffset();
 
             // Perform operations which might modify, create or destroy resources
             OnResourceSafe(m_cmd_current);
@@ -401,8 +519,8 @@ namespace Spartan
         m_cmd_current->Submit();
 
         // Update frame tracking
-        m_frame_num++;
-        m_is_odd_frame = (m_frame_num % 2) == 1;
+        const uint64_t frame_num = ++m_frame_num;
+        m_is_odd_frame           = (frame_num % 2) == 1;
     }
     
     const RHI_Viewport& Renderer::GetViewport()
@@ -577,7 +695,7 @@ namespace Spartan
         cmd_list->SetConstantBuffer(RendererBindingsCb::material, RHI_Shader_Pixel, m_cb_material_gpu);
     }
 
-    void Renderer::OnAddRenderables(const Variant& renderables)
+    void Renderer::OnAddRenderables(const WorldResolvedEvent& event)
     {
         // note: m_renderables is a vector of shared pointers.
         // this ensures that if any entities are deallocated by the world.
@@ -587,8 +705,7 @@ namespace Spartan
 
         m_renderables_world.clear();
 
-        vector<shared_ptr<Entity>> entities = renderables.Get<vector<shared_ptr<Entity>>>();
-        for (shared_ptr<Entity> entity : entities)
+        for (const shared_ptr<Entity>& entity : event.entities)
         {
             SP_ASSERT_MSG(entity != nullptr, "Entity is null");
 
@@ -598,14 +715,48 @@ namespace Spartan
             }
         }
 
+        // Whatever changed before this is part of it
+        m_renderables_changed.clear();
+        m_renderables_removed.clear();
+
         m_add_new_entities = true;
     }
 
+    void Renderer::OnEntitiesChanged(const WorldEntitiesChangedEvent& event)
+    {
+        lock_guard lock(m_mutex_entity_addition);
+        m_renderables_changed.insert(m_renderables_changed.end(), event.entities.begin(), event.entities.end());
+    }
+
+    void Renderer::OnEntitiesRemoved(const WorldEntitiesRemovedEvent& event)
+    {
+        // Entities can change and be removed before the renderer gets to them (it only patches when resources are safe),
+        // drop them from the changes, or they would be added back after they are removed and outlive the world
+        vector<Entity*> removed;
+        removed.reserve(event.entities.size());
+        for (const shared_ptr<Entity>& entity : event.entities)
+        {
+            removed.emplace_back(entity.get());
+        }
+        sort(removed.begin(), removed.end());
+
+        lock_guard lock(m_mutex_entity_addition);
+        m_renderables_changed.erase(remove_if(m_renderables_changed.begin(), m_renderables_changed.end(),
+            [&removed](const shared_ptr<Entity>& entity) { return binary_search(removed.begin(), removed.end(), entity.get()); }),
+            m_renderables_changed.end());
+        m_renderables_removed.insert(m_renderables_removed.end(), event.entities.begin(), event.entities.end());
+    }
+
     void Renderer::OnClear()
     {
         // Flush to remove references to entity resources that will be deallocated
         Flush();
         m_renderables.clear();
+        m_renderable_slots.clear();
+
+        lock_guard lock(m_mutex_entity_addition);
+        m_renderables_changed.clear();
+        m_renderables_removed.clear();
     }
 
     void Renderer::OnFullScreenToggled()
@@ -629,57 +780,52 @@ namespace Spartan
 
     void Renderer::OnResourceSafe(RHI_CommandList* cmd_list)
     {
-        ParseDeletionQueue();
-
         // Acquire renderables
-        if (m_add_new_entities)
         {
-            // Clear previous state
-            m_renderables.clear();
-            m_camera = nullptr;
+            lock_guard lock(m_mutex_entity_addition);
 
-            for (shared_ptr<Entity> entity : m_renderables_world)
+            // Rebuild everything
+            if (m_add_new_entities)
             {
-                if (Renderable* renderable = entity->GetComponent<Renderable>())
+                // Clear previous state
+                m_renderables.clear();
+                m_renderable_slots.clear();
+                m_camera = nullptr;
+
+                for (const shared_ptr<Entity>& entity : m_renderables_world)
                 {
-                    bool is_transparent = false;
-                    bool is_visible     = true;
+                    renderable_add(entity);
+                }
 
-                    if (const Material* material = renderable->GetMaterial())
-                    {
-                        is_transparent = material->GetProperty(MaterialProperty::ColorA) < 1.0f;
-                        is_visible     = material->GetProperty(MaterialProperty::ColorA) != 0.0f;
-                    }
+                // Sort them by distance
+                SortRenderables(&m_renderables[RendererEntityType::geometry_opaque]);
+                SortRenderables(&m_renderables[RendererEntityType::geometry_transparent]);
+                renderable_slots_update(RendererEntityType::geometry_opaque);
+                renderable_slots_update(RendererEntityType::geometry_transparent);
 
-                    if (is_visible)
-                    {
-                        m_renderables[is_transparent ? RendererEntityType::geometry_transparent : RendererEntityType::geometry_opaque].emplace_back(entity);
-                    }
-                }
+                m_renderables_world.clear();
+                m_add_new_entities = false;
+            }
 
-                if (Light* light = entity->GetComponent<Light>())
-                {
-                    m_renderables[RendererEntityType::light].emplace_back(entity);
-                }
+            // Patch in what changed since, the cost is proportional to the changes, not to the world
+            // (entities which are patched in are not sorted, that only happens on a full rebuild)
+            for (const shared_ptr<Entity>& entity : m_renderables_removed)
+            {
+                renderable_remove(entity.get());
+            }
 
-                if (Camera* camera = entity->GetComponent<Camera>())
-                {
-                    m_renderables[RendererEntityType::camera].emplace_back(entity);
-                    m_camera = camera->GetPtrShared<Camera>();
-                }
+            for (const shared_ptr<Entity>& entity : m_renderables_changed)
+            {
+                renderable_remove(entity.get());
 
-                if (ReflectionProbe* reflection_probe = entity->GetComponent<ReflectionProbe>())
+                if (entity->IsActiveRecursively())
                 {
-                    m_renderables[RendererEntityType::reflection_probe].emplace_back(entity);
+                    renderable_add(entity);
                 }
             }
 
-            // Sort them by distance
-            SortRenderables(&m_renderables[RendererEntityType::geometry_opaque]);
-            SortRenderables(&m_renderables[RendererEntityType::geometry_transparent]);
-
-            m_renderables_world.clear();
-            m_add_new_entities = false;
+            m_renderables_removed.clear();
+            m_renderables_changed.clear();
         }
 
         // Handle environment texture assignment requests
@@ -727,20 +873,67 @@ namespace Spartan
         }
     }
 
-    void Renderer::ParseDeletionQueue()
+    void Renderer::ParseDeletionQueue(const bool flush /*= false*/)
     {
         lock_guard<mutex> guard(m_mutex_deletion_queue);
 
-        if (!m_deletion_queue.empty())
-        {
-            uint32_t resource_count = static_cast<uint32_t>(m_deletion_queue.size());
+        if (m_deletion_queue.empty())
+            return;
 
+        // When flushing, wait for the GPU so that everything can be released
+        if (flush)
+        {
             m_rhi_device->QueueWaitAll();
-            m_rhi_device->ParseDeletionQueue(m_deletion_queue);
-            m_deletion_queue.clear();
+        }
+
+        // A resource released in frame N can still be referenced by the command lists recorded up to frame N.
+        // A command pool waits for a command list before it re-uses it, so once all command lists have cycled
+        // through, frame N is complete. The extra frame covers other pools (e.g. the editor's) submitting after ours.
+        const uint64_t frames_in_flight = static_cast<uint64_t>(GetFramesInFlight()) + 1;
 
-            SP_LOG_INFO("Released %d RHI resource(s)", resource_count);
+        uint32_t resource_count = 0;
+        for (auto it = m_deletion_queue.begin(); it != m_deletion_queue.end();)
+        {
+            // Frames are ordered, so the rest are still in flight
+            if (!flush && it->first + frames_in_flight > m_frame_num)
+                break;
+
+            m_rhi_device->ParseDeletionQueue(it->second);
+
+            for (const auto& resources : it->second)
+            {
+                resource_count += static_cast<uint32_t>(resources.second.size());
+            }
+
+            it = m_deletion_queue.erase(it);
         }
+
+        // Profile
+        if (resource_count != 0)
+        {
+            Profiler::AddTraceEvent("Deletion queue", (flush ? "Flushed " : "Released ") + to_string(resource_count) + " resources");
+        }
+        Profiler::m_rhi_resources_released += resource_count;
+        Profiler::m_rhi_resources_pending   = 0;
+        for (const auto& it : m_deletion_queue)
+        {
+            for (const auto& resources : it.second)
+            {
+                Profiler::m_rhi_resources_pending += static_cast<uint32_t>(resources.second.size());
+            }
+        }
+    }
+
+    uint32_t Renderer::GetFramesInFlight()
+    {
+        uint32_t frames_in_flight = 1;
+
+        for (const shared_ptr<RHI_CommandPool>& cmd_pool : m_rhi_device->GetCommandPools())
+        {
+            frames_in_flight = max(frames_in_flight, cmd_pool->GetCommandListCount());
+        }
+
+        return frames_in_flight;
     }
 
     void Renderer::SortRenderables(vector<shared_ptr<Entity>>* renderables)
@@ -1010,6 +1203,6 @@ namespace Spartan
     void Renderer::AddToDeletionQueue(const RHI_Resource_Type resource_type, void* resource)
     {
         lock_guard<mutex> guard(m_mutex_deletion_queue);
-        m_deletion_queue[resource_type].emplace_back(resource);
+        m_deletion_queue[m_frame_num][resource_type].emplace_back(resource);
     }
 }
@@ -42,6 +42,10 @@ namespace Spartan
     class Variant;
     class Grid;
     class Environment;
+    class RenderGraph;
+    struct WorldResolvedEvent;
+    struct WorldEntitiesChangedEvent;
+    struct WorldEntitiesRemovedEvent;
     //====================
 
     namespace Math
@@ -84,6 +88,7 @@ namespace Spartan
         static void SetGlobalShaderResources(RHI_CommandList* cmd_list);
         static void RequestTextureMipGeneration(std::shared_ptr<RHI_Texture> texture);
         static uint64_t GetFrameNum();
+        static uint32_t GetFramesInFlight();
         static RHI_Api_Type GetRhiApiType();
 
         //= RESOLUTION/SIZE =============================================================================
@@ -120,10 +125,11 @@ namespace Spartan
         //= RESOURCES =====================================================================================
         // Render targets
         static std::shared_ptr<RHI_Texture> GetRenderTarget(const RendererTexture rt_enum);
-        static std::array<std::shared_ptr<RHI_Texture>, 26>& GetRenderTargets();
+        static std::array<std::shared_ptr<RHI_Texture>, 27>& GetRenderTargets();
+        static RenderGraph& GetRenderGraph();
 
         // Shaders
-        static std::array<std::shared_ptr<RHI_Shader>, 47>& GetShaders();
+        static std::array<std::shared_ptr<RHI_Shader>, 50>& GetShaders();
 
         // Misc
         static RHI_Texture* GetFrameTexture();
@@ -157,11 +163,13 @@ namespace Spartan
         static void Pass_Main(RHI_CommandList* cmd_list);
         static void Pass_ShadowMaps(RHI_CommandList* cmd_list, const bool is_transparent_pass);
         static void Pass_ReflectionProbes(RHI_CommandList* cmd_list);
+        static void Pass_Culling(RHI_CommandList* cmd_list);
         static void Pass_Depth_Prepass(RHI_CommandList* cmd_list);
+        static void Pass_DepthPyramid(RHI_CommandList* cmd_list);
         static void Pass_GBuffer(RHI_CommandList* cmd_list, const bool is_transparent_pass);
         static void Pass_Ssao(RHI_CommandList* cmd_list);
         static void Pass_Ssr(RHI_CommandList* cmd_list, RHI_Texture* tex_in);
-        static void Pass_PostProcess(RHI_CommandList* cmd_list);
+        static void Pass_PostProcess();
         static void Pass_ToneMappingGammaCorrection(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_Fxaa(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
         static void Pass_FilmGrain(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
@@ -184,11 +192,13 @@ namespace Spartan
         static void Pass_Light_ImageBased(RHI_CommandList* cmd_list, RHI_Texture* tex_out, const bool is_transparent_pass);
         // AMD FidelityFX
         static void Pass_Ffx_Cas(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
-        static void Pass_Ffx_Spd(RHI_CommandList* cmd_list, RHI_Texture* tex);
+        static void Pass_Ffx_Spd(RHI_CommandList* cmd_list, RHI_Texture* tex, const bool depth_min = false);
         static void Pass_Ffx_Fsr2(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out);
 
         // Event handlers
-        static void OnAddRenderables(const Variant& renderables);
+        static void OnAddRenderables(const WorldResolvedEvent& event);
+        static void OnEntitiesChanged(const WorldEntitiesChangedEvent& event);
+        static void OnEntitiesRemoved(const WorldEntitiesRemovedEvent& event);
         static void OnClear();
         static void OnFullScreenToggled();
 
@@ -196,7 +206,7 @@ namespace Spartan
         static void SortRenderables(std::vector<std::shared_ptr<Entity>>* renderables);
         static bool IsCallingFromOtherThread();
         static void OnResourceSafe(RHI_CommandList* cmd_list);
-        static void ParseDeletionQueue();
+        static void ParseDeletionQueue(const bool flush = false);
 
         // Lines
         static void Lines_PreMain();
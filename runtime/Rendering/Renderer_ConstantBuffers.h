@@ -138,7 +138,8 @@ namespace Spartan
 
         bool mat_single_texture_rougness_metalness = false;
         float radius                               = 0.0f;
-        Math::Vector2 padding                      = Math::Vector2::Zero;
+        uint32_t object_count                      = 0;
+        float padding                              = 0.0f;
 
         Math::Vector4 mat_color = Math::Vector4::Zero;
 
@@ -184,6 +185,7 @@ namespace Spartan
                 work_group_count                      == rhs.work_group_count                      &&
                 reflection_proble_available           == rhs.reflection_proble_available           &&
                 radius                                == rhs.radius                                &&
+                object_count                          == rhs.object_count                          &&
                 extents                               == rhs.extents                               &&
                 mat_textures                          == rhs.mat_textures                          &&
                 mat_single_texture_rougness_metalness == rhs.mat_single_texture_rougness_metalness &&
@@ -154,8 +154,11 @@ namespace Spartan
         tex            = 0,
         tex2           = 1,
         tex3           = 2,
-        atomic_counter = 3,
-        tex_array      = 4
+        atomic_counter  = 3,
+        tex_array       = 4,
+        culling_objects = 16,
+        draws           = 17,
+        draw_count      = 18
     };
 
     enum class RendererShader : uint8_t
@@ -163,6 +166,7 @@ namespace Spartan
         gbuffer_v,
         gbuffer_p,
         depth_prepass_v,
+        depth_prepass_indirect_v,
         depth_prepass_p,
         depth_light_V,
         depth_light_p,
@@ -206,7 +210,9 @@ namespace Spartan
         reflection_probe_v,
         reflection_probe_p,
         ffx_cas_c,
-        ffx_spd_c
+        ffx_spd_c,
+        ffx_spd_depth_min_c,
+        culling_c
     };
     
     enum class RendererTexture : uint8_t
@@ -217,6 +223,7 @@ namespace Spartan
         gbuffer_material,
         gbuffer_velocity,
         gbuffer_depth,
+        depth_pyramid,
         brdf_specular_lut,
         light_diffuse,
         light_diffuse_transparent,
@@ -40,7 +40,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_FSR2.h"
 #include "../RHI/RHI_StructuredBuffer.h"
 #include "Renderer_ConstantBuffers.h"
+#include "Culling.h"
+#include "RenderGraph.h"
 #include "../RHI/RHI_SwapChain.h"
+#include "../Core/FrameAllocator.h"
 //==============================================
 
 //= NAMESPACES ===============
@@ -86,6 +89,9 @@ namespace Spartan
 
     //= BUFFERS =============================================
     extern shared_ptr<RHI_StructuredBuffer> m_sb_spd_counter;
+    extern shared_ptr<RHI_StructuredBuffer> m_sb_culling_objects;
+    extern shared_ptr<RHI_StructuredBuffer> m_sb_draws;
+    extern shared_ptr<RHI_StructuredBuffer> m_sb_draw_count;
 
     extern Cb_Frame m_cb_frame_cpu;
     extern shared_ptr<RHI_ConstantBuffer> m_cb_frame_gpu;
@@ -136,11 +142,34 @@ namespace Spartan
     extern unique_ptr<Grid> m_gizmo_grid;
     extern RHI_CommandList* m_cmd_current;
     extern bool m_brdf_specular_lut_rendered;
+    extern RenderGraph m_render_graph;
 
     // Misc
     const float m_thread_group_count = 8.0f;
     bool m_ffx_fsr2_reset            = false;
 
+    // GPU driven rendering, objects which are culled on the GPU and drawn with a single indirect draw
+    vector<CullingObject> m_culling_objects;
+    uint32_t m_culling_object_count           = 0;
+    RHI_VertexBuffer* m_culling_vertex_buffer = nullptr;
+    RHI_IndexBuffer* m_culling_index_buffer   = nullptr;
+    uint64_t m_depth_pyramid_id               = 0; // id of the depth pyramid which holds the depth of the previous frame
+
+    static bool is_gpu_driven_supported()
+    {
+        return Renderer::GetRhiApiType() == RHI_Api_Type::Vulkan || Renderer::GetRhiApiType() == RHI_Api_Type::Null;
+    }
+
+    static bool is_gpu_culling_candidate(Material* material)
+    {
+        // Alpha tested materials need their textures in the depth prepass, so they are drawn by the CPU
+        if (material->HasTexture(MaterialTexture::AlphaMask))
+            return false;
+
+        RHI_Texture* texture_color = material->GetTexture(MaterialTexture::Color);
+        return !texture_color || !texture_color->IsTransparent();
+    }
+
     void Renderer::SetGlobalShaderResources(RHI_CommandList* cmd_list)
     {
         // Constant buffers
@@ -171,102 +200,199 @@ namespace Spartan
 
         SP_PROFILE_FUNCTION();
 
-        // Acquire render targets
-        RHI_Texture* rt1       = render_target(RendererTexture::frame_render).get();
-        RHI_Texture* rt2       = render_target(RendererTexture::frame_render_2).get();
-        RHI_Texture* rt_output = render_target(RendererTexture::frame_output).get();
-
         // Update frame constant buffer
         Update_Cb_Frame(cmd_list);
 
+        // Declare this frame's passes, along with the render targets they read and write.
+        // The graph culls the passes whose output nobody consumes and allocates the transient render targets.
+        m_render_graph.Begin();
+        m_render_graph.AddOutput(RendererTexture::frame_output);   // presented
+        m_render_graph.AddOutput(RendererTexture::depth_pyramid);  // occlusion culling, next frame
+        m_render_graph.AddOutput(RendererTexture::light_diffuse);  // ssao gi, next frame
+
         if (shared_ptr<Camera> camera = GetCamera())
         { 
             // If there are no entities, clear to the camera's color
             if (GetEntities()[RendererEntityType::geometry_opaque].empty() && GetEntities()[RendererEntityType::geometry_transparent].empty() && GetEntities()[RendererEntityType::light].empty())
             {
-                GetCmdList()->ClearRenderTarget(rt_output, 0, 0, false, camera->GetClearColor());
+                const Color clear_color = camera->GetClearColor();
+                m_render_graph.AddPass("clear", {}, { RendererTexture::frame_output }, [clear_color](RHI_CommandList* cmd_list)
+                {
+                    cmd_list->ClearRenderTarget(render_target(RendererTexture::frame_output).get(), 0, 0, false, clear_color);
+                });
             }
             else // Render frame
             {
                 // Generate brdf specular lut
                 if (!m_brdf_specular_lut_rendered)
                 {
-                    Pass_BrdfSpecularLut(cmd_list);
-                    m_brdf_specular_lut_rendered = true;
+                    m_render_graph.AddPass("brdf_specular_lut", {}, { RendererTexture::brdf_specular_lut }, [](RHI_CommandList* cmd_list)
+                    {
+                        Pass_BrdfSpecularLut(cmd_list);
+                        m_brdf_specular_lut_rendered = true;
+                    });
                 }
 
                 // Determine if a transparent pass is required
                 const bool do_transparent_pass = !GetEntities()[RendererEntityType::geometry_transparent].empty();
 
-                // Shadow maps
+                // Shadow maps and probes write to textures owned by the lights and probes, so the graph can't track them
                 {
-                    Pass_ShadowMaps(cmd_list, false);
+                    const bool has_side_effects = true;
+
+                    m_render_graph.AddPass("shadow_maps_depth", {}, {}, [](RHI_CommandList* cmd_list) { Pass_ShadowMaps(cmd_list, false); }, has_side_effects);
                     if (do_transparent_pass)
                     {
-                        Pass_ShadowMaps(cmd_list, true);
+                        m_render_graph.AddPass("shadow_maps_color", {}, {}, [](RHI_CommandList* cmd_list) { Pass_ShadowMaps(cmd_list, true); }, has_side_effects);
                     }
+
+                    m_render_graph.AddPass("reflection_probes", {}, {}, [](RHI_CommandList* cmd_list) { Pass_ReflectionProbes(cmd_list); }, has_side_effects);
+
+                    // Writes the indirect draw buffers which the depth prepass consumes
+                    m_render_graph.AddPass("culling", {}, {}, [](RHI_CommandList* cmd_list) { Pass_Culling(cmd_list); }, has_side_effects);
                 }
 
-                Pass_ReflectionProbes(cmd_list);
+                // The SSR texture is only sampled when SSR is enabled, so the SSR pass is culled otherwise
+                pmr::vector<RendererTexture> reads_image_based = frame_vector<RendererTexture>();
+                reads_image_based.assign({ RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_material, RendererTexture::gbuffer_depth, RendererTexture::ssao, RendererTexture::brdf_specular_lut });
+                if (GetOption<bool>(RendererOption::ScreenSpaceReflections))
+                {
+                    reads_image_based.emplace_back(RendererTexture::ssr);
+                }
 
                 // Opaque
                 {
-                    bool is_transparent_pass = false;
-
-                    Pass_Depth_Prepass(cmd_list);
-                    Pass_GBuffer(cmd_list, is_transparent_pass);
-                    Pass_Ssao(cmd_list);
-                    Pass_Ssr(cmd_list, rt1);
-                    Pass_Light(cmd_list, is_transparent_pass); // compute diffuse and specular buffers
-                    Pass_Light_Composition(cmd_list, rt1, is_transparent_pass); // compose diffuse, specular, ssao, volumetric etc.
-                    Pass_Light_ImageBased(cmd_list, rt1, is_transparent_pass); // apply IBL and SSR
+                    m_render_graph.AddPass("depth_prepass",
+                        {},
+                        { RendererTexture::gbuffer_depth },
+                        [](RHI_CommandList* cmd_list) { Pass_Depth_Prepass(cmd_list); }
+                    );
+
+                    m_render_graph.AddPass("g_buffer",
+                        { RendererTexture::gbuffer_depth },
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_material, RendererTexture::gbuffer_velocity, RendererTexture::gbuffer_depth, RendererTexture::fsr2_mask_transparency },
+                        [](RHI_CommandList* cmd_list) { Pass_GBuffer(cmd_list, false); }
+                    );
+
+                    m_render_graph.AddPass("depth_pyramid",
+                        { RendererTexture::gbuffer_depth },
+                        { RendererTexture::depth_pyramid },
+                        [](RHI_CommandList* cmd_list) { Pass_DepthPyramid(cmd_list); }
+                    );
+
+                    m_render_graph.AddPass("ssao",
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_depth, RendererTexture::light_diffuse },
+                        { RendererTexture::ssao, RendererTexture::ssao_gi, RendererTexture::blur },
+                        [](RHI_CommandList* cmd_list) { Pass_Ssao(cmd_list); }
+                    );
+
+                    m_render_graph.AddPass("ssr",
+                        { RendererTexture::frame_render, RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_depth, RendererTexture::gbuffer_material, RendererTexture::gbuffer_velocity },
+                        { RendererTexture::ssr, RendererTexture::blur },
+                        [](RHI_CommandList* cmd_list) { Pass_Ssr(cmd_list, render_target(RendererTexture::frame_render).get()); }
+                    );
+
+                    // Compute diffuse and specular buffers
+                    m_render_graph.AddPass("light",
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_material, RendererTexture::gbuffer_depth, RendererTexture::ssao, RendererTexture::ssao_gi },
+                        { RendererTexture::light_diffuse, RendererTexture::light_specular, RendererTexture::light_volumetric },
+                        [](RHI_CommandList* cmd_list) { Pass_Light(cmd_list, false); }
+                    );
+
+                    // Compose diffuse, specular, ssao, volumetric etc.
+                    m_render_graph.AddPass("light_composition",
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_material, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_depth, RendererTexture::light_diffuse, RendererTexture::light_specular, RendererTexture::light_volumetric, RendererTexture::ssao },
+                        { RendererTexture::frame_render },
+                        [](RHI_CommandList* cmd_list) { Pass_Light_Composition(cmd_list, render_target(RendererTexture::frame_render).get(), false); }
+                    );
+
+                    // Apply IBL and SSR
+                    m_render_graph.AddPass("light_image_based",
+                        reads_image_based,
+                        { RendererTexture::frame_render },
+                        [](RHI_CommandList* cmd_list) { Pass_Light_ImageBased(cmd_list, render_target(RendererTexture::frame_render).get(), false); }
+                    );
                 }
 
                 // Transparent
                 if (do_transparent_pass)
                 {
-                    // Blit the frame so that refraction can sample from it
-                    cmd_list->Blit(rt1, rt2, true);
-
-                    // Generate frame mips so that the reflections can simulate roughness
-                    Pass_Ffx_Spd(cmd_list, rt2);
+                    m_render_graph.AddPass("refraction",
+                        { RendererTexture::frame_render },
+                        { RendererTexture::frame_render_2, RendererTexture::blur },
+                        [](RHI_CommandList* cmd_list)
+                        {
+                            RHI_Texture* rt1 = render_target(RendererTexture::frame_render).get();
+                            RHI_Texture* rt2 = render_target(RendererTexture::frame_render_2).get();
 
-                    // Blur the smaller mips to reduce blockiness/flickering
-                    for (uint32_t i = 1; i < rt2->GetMipCount(); i++)
-                    {
-                        const bool depth_aware   = false;
-                        const float radius       = 5.0f;
-                        const float sigma        = 2.0f;
-                        const float pixel_stride = 1.0;
-                        Pass_Blur_Gaussian(cmd_list, rt2, depth_aware, radius, sigma, pixel_stride, i);
-                    }
+                            // Blit the frame so that refraction can sample from it
+                            cmd_list->Blit(rt1, rt2, true);
 
-                    bool is_transparent_pass = true;
+                            // Generate frame mips so that the reflections can simulate roughness
+                            Pass_Ffx_Spd(cmd_list, rt2);
 
-                    Pass_GBuffer(cmd_list, is_transparent_pass);
-                    Pass_Light(cmd_list, is_transparent_pass);
-                    Pass_Light_Composition(cmd_list, rt1, is_transparent_pass);
-                    Pass_Light_ImageBased(cmd_list, rt1, is_transparent_pass);
+                            // Blur the smaller mips to reduce blockiness/flickering
+                            for (uint32_t i = 1; i < rt2->GetMipCount(); i++)
+                            {
+                                const bool depth_aware   = false;
+                                const float radius       = 5.0f;
+                                const float sigma        = 2.0f;
+                                const float pixel_stride = 1.0;
+                                Pass_Blur_Gaussian(cmd_list, rt2, depth_aware, radius, sigma, pixel_stride, i);
+                            }
+                        }
+                    );
+
+                    m_render_graph.AddPass("g_buffer_transparent",
+                        { RendererTexture::gbuffer_depth },
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_material, RendererTexture::gbuffer_velocity, RendererTexture::gbuffer_depth, RendererTexture::fsr2_mask_transparency },
+                        [](RHI_CommandList* cmd_list) { Pass_GBuffer(cmd_list, true); }
+                    );
+
+                    m_render_graph.AddPass("light_transparent",
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_material, RendererTexture::gbuffer_depth, RendererTexture::ssao, RendererTexture::ssao_gi },
+                        { RendererTexture::light_diffuse_transparent, RendererTexture::light_specular_transparent, RendererTexture::light_volumetric },
+                        [](RHI_CommandList* cmd_list) { Pass_Light(cmd_list, true); }
+                    );
+
+                    m_render_graph.AddPass("light_composition_transparent",
+                        { RendererTexture::gbuffer_albedo, RendererTexture::gbuffer_material, RendererTexture::gbuffer_normal, RendererTexture::gbuffer_depth, RendererTexture::light_diffuse_transparent, RendererTexture::light_specular_transparent, RendererTexture::light_volumetric, RendererTexture::frame_render_2, RendererTexture::ssao },
+                        { RendererTexture::frame_render },
+                        [](RHI_CommandList* cmd_list) { Pass_Light_Composition(cmd_list, render_target(RendererTexture::frame_render).get(), true); }
+                    );
+
+                    m_render_graph.AddPass("light_image_based_transparent",
+                        reads_image_based,
+                        { RendererTexture::frame_render },
+                        [](RHI_CommandList* cmd_list) { Pass_Light_ImageBased(cmd_list, render_target(RendererTexture::frame_render).get(), true); }
+                    );
                 }
 
-                Pass_PostProcess(cmd_list);
+                Pass_PostProcess();
             }
 
             // Editor related stuff - Passes that render on top of each other
-            Pass_DebugMeshes(cmd_list, rt_output);
-            Pass_Icons(cmd_list, rt_output);
-            Pass_PeformanceMetrics(cmd_list, rt_output);
+            m_render_graph.AddPass("debug_meshes",       { RendererTexture::gbuffer_depth }, { RendererTexture::frame_output }, [](RHI_CommandList* cmd_list) { Pass_DebugMeshes(cmd_list, render_target(RendererTexture::frame_output).get()); });
+            m_render_graph.AddPass("icons",              {},                                 { RendererTexture::frame_output }, [](RHI_CommandList* cmd_list) { Pass_Icons(cmd_list, render_target(RendererTexture::frame_output).get()); });
+            m_render_graph.AddPass("performance_metrics", {},                                { RendererTexture::frame_output }, [](RHI_CommandList* cmd_list) { Pass_PeformanceMetrics(cmd_list, render_target(RendererTexture::frame_output).get()); });
         }
         else
         {
             // If there is no camera, clear to black and and render the performance metrics
-            GetCmdList()->ClearRenderTarget(rt_output, 0, 0, false, Color::standard_black);
-            Pass_PeformanceMetrics(cmd_list, rt_output);
+            m_render_graph.AddPass("clear", {}, { RendererTexture::frame_output }, [](RHI_CommandList* cmd_list)
+            {
+                RHI_Texture* rt_output = render_target(RendererTexture::frame_output).get();
+                cmd_list->ClearRenderTarget(rt_output, 0, 0, false, Color::standard_black);
+                Pass_PeformanceMetrics(cmd_list, rt_output);
+            });
         }
 
+        m_render_graph.Compile();
+        m_render_graph.Execute(cmd_list);
+
         // No further rendering is done on this render target, which is the final output.
         // However, ImGui will display it within the viewport, so the appropriate layout has to be set.
-        rt_output->SetLayout(RHI_Image_Layout::Shader_Read_Only_Optimal, cmd_list);
+        render_target(RendererTexture::frame_output)->SetLayout(RHI_Image_Layout::Shader_Read_Only_Optimal, cmd_list);
     }
 
     void Renderer::Pass_ShadowMaps(RHI_CommandList* cmd_list, const bool is_transparent_pass)
@@ -422,7 +548,7 @@ namespace Spartan
                     m_cb_uber_cpu.transform = entity->GetTransform()->GetMatrix() * view_projection;
                     Update_Cb_Uber(cmd_list);
 
-                    cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+                    cmd_list->DrawIndexed(renderable->GetIndexCount(), mesh->GetIndexBufferOffset() + renderable->GetIndexOffset(), mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
                 }
 
                 if (render_pass_active)
@@ -558,7 +684,7 @@ namespace Spartan
                                 // Update light buffer
                                 Update_Cb_Light(cmd_list, light, RHI_Shader_Pixel);
 
-                                cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+                                cmd_list->DrawIndexed(renderable->GetIndexCount(), mesh->GetIndexBufferOffset() + renderable->GetIndexOffset(), mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
                             }
                         }
                     }
@@ -570,6 +696,113 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
+    void Renderer::Pass_Culling(RHI_CommandList* cmd_list)
+    {
+        m_culling_object_count  = 0;
+        m_culling_vertex_buffer = nullptr;
+        m_culling_index_buffer  = nullptr;
+
+        // The depth prepass is what consumes the indirect draws
+        if (!GetOption<bool>(RendererOption::DepthPrepass) || !is_gpu_driven_supported())
+            return;
+
+        // Acquire shaders
+        RHI_Shader* shader_c = shader(RendererShader::culling_c).get();
+        RHI_Shader* shader_v = shader(RendererShader::depth_prepass_indirect_v).get();
+        if (!shader_c->IsCompiled() || !shader_v->IsCompiled())
+            return;
+
+        // Gather objects, in the order that the depth prepass iterates them
+        m_culling_objects.resize(Culling::object_count_max);
+        for (shared_ptr<Entity> entity : m_renderables[RendererEntityType::geometry_opaque])
+        {
+            Renderable* renderable = entity->GetRenderable();
+            if (!renderable)
+                continue;
+
+            Material* material = renderable->GetMaterial();
+            if (!material)
+                continue;
+
+            Mesh* mesh = renderable->GetMesh();
+            if (!mesh || !mesh->GetVertexBuffer() || !mesh->GetIndexBuffer())
+                continue;
+
+            Transform* transform = entity->GetTransform();
+            if (!transform)
+                continue;
+
+            if (!is_gpu_culling_candidate(material))
+                continue;
+
+            // A single indirect draw can only use one vertex and index buffer
+            if (!m_culling_vertex_buffer)
+            {
+                m_culling_vertex_buffer = mesh->GetVertexBuffer();
+                m_culling_index_buffer  = mesh->GetIndexBuffer();
+            }
+
+            if (mesh->GetVertexBuffer() != m_culling_vertex_buffer)
+                continue;
+
+            if (m_culling_object_count == Culling::object_count_max)
+                break;
+
+            const BoundingBox& aabb     = renderable->GetAabb();
+            CullingObject& object       = m_culling_objects[m_culling_object_count++];
+            object.transform            = transform->GetMatrix();
+            object.aabb_min             = aabb.GetMin();
+            object.aabb_max             = aabb.GetMax();
+            object.index_count          = renderable->GetIndexCount();
+            object.index_offset         = mesh->GetIndexBufferOffset() + renderable->GetIndexOffset();
+            object.vertex_offset        = static_cast<int32_t>(mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
+        }
+
+        if (m_culling_object_count == 0)
+            return;
+
+        cmd_list->BeginTimeblock("culling");
+
+        // Occlusion culling uses the depth pyramid of the previous frame, if there is one
+        RHI_Texture* tex_depth_pyramid = render_target(RendererTexture::depth_pyramid).get();
+        const bool occlusion_culling   = m_depth_pyramid_id == tex_depth_pyramid->GetObjectId();
+
+        // Define pipeline state
+        static RHI_PipelineState pso;
+        pso.shader_compute = shader_c;
+
+        // Set pipeline state
+        cmd_list->SetPipelineState(pso);
+
+        // Set uber buffer
+        m_cb_uber_cpu.object_count  = m_culling_object_count;
+        m_cb_uber_cpu.resolution_in = Vector2(static_cast<float>(tex_depth_pyramid->GetWidth()), static_cast<float>(tex_depth_pyramid->GetHeight()));
+        m_cb_uber_cpu.mip_count     = occlusion_culling ? tex_depth_pyramid->GetMipCount() : 0;
+        Update_Cb_Uber(cmd_list);
+
+        // Update buffers
+        uint32_t draw_count = 0;
+        m_sb_draw_count->Update(&draw_count);
+        m_sb_culling_objects->Update(m_culling_objects.data());
+        cmd_list->SetStructuredBuffer(RendererBindingsUav::culling_objects, m_sb_culling_objects);
+        cmd_list->SetStructuredBuffer(RendererBindingsUav::draws,           m_sb_draws);
+        cmd_list->SetStructuredBuffer(RendererBindingsUav::draw_count,      m_sb_draw_count);
+
+        // Set textures
+        if (occlusion_culling)
+        {
+            cmd_list->SetTexture(RendererBindingsSrv::tex, tex_depth_pyramid);
+        }
+
+        // Render
+        cmd_list->Dispatch(static_cast<uint32_t>(Math::Helper::Ceil(static_cast<float>(m_culling_object_count) / 64.0f)), 1);
+
+        // The draws are consumed by the depth prepass
+        cmd_list->InsertMemoryBarrierIndirect();
+
+        cmd_list->EndTimeblock();
+    }
+
     void Renderer::Pass_Depth_Prepass(RHI_CommandList* cmd_list)
     {
         if (!GetOption<bool>(RendererOption::DepthPrepass))
@@ -586,6 +819,31 @@ namespace Spartan
         RHI_Texture* tex_depth = render_target(RendererTexture::gbuffer_depth).get();
         const vector<shared_ptr<Entity>> entities = m_renderables[RendererEntityType::geometry_opaque];
 
+        // Draw the objects which were culled on the GPU, with a single indirect draw
+        if (m_culling_object_count != 0)
+        {
+            static RHI_PipelineState pso_indirect;
+            pso_indirect.shader_vertex               = shader(RendererShader::depth_prepass_indirect_v).get();
+            pso_indirect.shader_pixel                = nullptr; // no alpha testing
+            pso_indirect.rasterizer_state            = m_rasterizer_cull_back_solid.get();
+            pso_indirect.blend_state                 = m_blend_disabled.get();
+            pso_indirect.depth_stencil_state         = m_depth_stencil_rw_off.get();
+            pso_indirect.render_target_depth_texture = tex_depth;
+            pso_indirect.clear_depth                 = 0.0f; // reverse-z
+            pso_indirect.viewport                    = tex_depth->GetViewport();
+            pso_indirect.primitive_topology          = RHI_PrimitiveTopology_Mode::TriangleList;
+            cmd_list->SetPipelineState(pso_indirect);
+
+            cmd_list->BeginRenderPass();
+            {
+                cmd_list->SetBufferIndex(m_culling_index_buffer);
+                cmd_list->SetBufferVertex(m_culling_vertex_buffer);
+                cmd_list->SetStructuredBuffer(RendererBindingsUav::culling_objects, m_sb_culling_objects);
+                cmd_list->DrawIndexedIndirectCount(m_sb_draws.get(), m_sb_draw_count.get(), m_culling_object_count);
+            }
+            cmd_list->EndRenderPass();
+        }
+
         // Define pipeline state
         static RHI_PipelineState pso;
         pso.shader_vertex               = shader_v;
@@ -594,7 +852,7 @@ namespace Spartan
         pso.blend_state                 = m_blend_disabled.get();
         pso.depth_stencil_state         = m_depth_stencil_rw_off.get();
         pso.render_target_depth_texture = tex_depth;
-        pso.clear_depth                 = 0.0f; // reverse-z
+        pso.clear_depth                 = m_culling_object_count != 0 ? rhi_depth_load : 0.0f; // reverse-z
         pso.viewport                    = tex_depth->GetViewport();
         pso.primitive_topology          = RHI_PrimitiveTopology_Mode::TriangleList;
 
@@ -606,6 +864,9 @@ namespace Spartan
         { 
             // Variables that help reduce state changes
             uint64_t currently_bound_geometry = 0;
+
+            // Objects which were already drawn indirectly, they come first and in the same order
+            uint32_t gpu_culled_count = 0;
             
             // Draw opaque
             for (shared_ptr<Entity> entity : entities)
@@ -630,6 +891,13 @@ namespace Spartan
                 if (!transform)
                     continue;
 
+                // Skip objects that were culled and drawn on the GPU
+                if (gpu_culled_count < m_culling_object_count && mesh->GetVertexBuffer() == m_culling_vertex_buffer && is_gpu_culling_candidate(material))
+                {
+                    gpu_culled_count++;
+                    continue;
+                }
+
                 // Skip objects outside of the view frustum
                 if (!GetCamera()->IsInViewFrustum(renderable))
                     continue;
@@ -653,7 +921,7 @@ namespace Spartan
                 Update_Cb_Uber(cmd_list);
             
                 // Draw
-                cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+                cmd_list->DrawIndexed(renderable->GetIndexCount(), mesh->GetIndexBufferOffset() + renderable->GetIndexOffset(), mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
             }
 
             cmd_list->EndRenderPass();
@@ -692,7 +960,9 @@ namespace Spartan
         pso.shader_pixel                    = shader_p;
         pso.blend_state                     = m_blend_disabled.get();
         pso.rasterizer_state                = wireframe ? m_rasterizer_cull_back_wireframe.get() : m_rasterizer_cull_back_solid.get();
-        pso.depth_stencil_state             = is_transparent_pass ? m_depth_stencil_rw_w.get() : (depth_prepass ? m_depth_stencil_r_off.get() : m_depth_stencil_rw_off.get());
+        // Objects occluded in the previous frame are missing from the depth prepass, so depth is written when GPU culling is active
+        const bool depth_complete           = depth_prepass && m_culling_object_count == 0;
+        pso.depth_stencil_state             = is_transparent_pass ? m_depth_stencil_rw_w.get() : (depth_complete ? m_depth_stencil_r_off.get() : m_depth_stencil_rw_off.get());
         pso.render_target_color_textures[0] = tex_albedo;
         pso.clear_color[0]                  = is_transparent_pass ? rhi_color_load : Color::standard_transparent;
         pso.render_target_color_textures[1] = tex_normal;
@@ -815,7 +1085,7 @@ namespace Spartan
                 }
 
                 // Render
-                cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+                cmd_list->DrawIndexed(renderable->GetIndexCount(), mesh->GetIndexBufferOffset() + renderable->GetIndexOffset(), mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
                 Profiler::m_renderer_meshes_rendered++;
             }
 
@@ -971,6 +1241,26 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
+    void Renderer::Pass_DepthPyramid(RHI_CommandList* cmd_list)
+    {
+        // Only needed for occlusion culling
+        if (!GetOption<bool>(RendererOption::DepthPrepass) || !is_gpu_driven_supported())
+            return;
+
+        RHI_Texture* tex_depth         = render_target(RendererTexture::gbuffer_depth).get();
+        RHI_Texture* tex_depth_pyramid = render_target(RendererTexture::depth_pyramid).get();
+
+        cmd_list->BeginTimeblock("depth_pyramid");
+
+        // Copy the depth into the top mip and reduce it into the rest of the mips
+        Pass_Copy(cmd_list, tex_depth, tex_depth_pyramid, false);
+        Pass_Ffx_Spd(cmd_list, tex_depth_pyramid, true);
+
+        m_depth_pyramid_id = tex_depth_pyramid->GetObjectId();
+
+        cmd_list->EndTimeblock();
+    }
+
     void Renderer::Pass_Ssao(RHI_CommandList* cmd_list)
     {
         if (!GetOption<bool>(RendererOption::Ssao))
@@ -1363,26 +1653,29 @@ namespace Spartan
         cmd_list->EndMarker();
     }
 
-    void Renderer::Pass_PostProcess(RHI_CommandList* cmd_list)
+    void Renderer::Pass_PostProcess()
     {
         // IN:  Frame_Render, which is and HDR render resolution render target (with a second texture so passes can alternate between them)
         // OUT: Frame_Output, which is and LDR output resolution render target (with a second texture so passes can alternate between them)
 
-        // Acquire render targets (as references so that swapping the pointers around works)
-        RHI_Texture* rt_frame_render         = render_target(RendererTexture::frame_render).get();   // render res
-        RHI_Texture* rt_frame_render_scratch = render_target(RendererTexture::frame_render_2).get(); // render res
-        RHI_Texture* rt_frame_output         = render_target(RendererTexture::frame_output).get();   // output res
-        RHI_Texture* rt_frame_output_scratch = render_target(RendererTexture::frame_output_2).get(); // output res
-
         // A bunch of macros which allows us to keep track of which texture is an input/output for each pass.
         bool swap_render = true;
-        #define get_render_in  swap_render ? rt_frame_render_scratch : rt_frame_render
-        #define get_render_out swap_render ? rt_frame_render : rt_frame_render_scratch
+        #define get_render_in  swap_render ? RendererTexture::frame_render_2 : RendererTexture::frame_render
+        #define get_render_out swap_render ? RendererTexture::frame_render : RendererTexture::frame_render_2
         bool swap_output = true;
-        #define get_output_in  swap_output ? rt_frame_output_scratch : rt_frame_output
-        #define get_output_out swap_output ? rt_frame_output : rt_frame_output_scratch
- 
-        cmd_list->BeginMarker("post_proccess");
+        #define get_output_in  swap_output ? RendererTexture::frame_output_2 : RendererTexture::frame_output
+        #define get_output_out swap_output ? RendererTexture::frame_output : RendererTexture::frame_output_2
+
+        // Declares a pass which reads from one frame texture and writes to the other
+        #define add_pass_in_out(name, pass, in, out)                                                                              \
+        {                                                                                                                         \
+            const RendererTexture tex_in  = in;                                                                                   \
+            const RendererTexture tex_out = out;                                                                                  \
+            m_render_graph.AddPass(name, { tex_in }, { tex_out }, [tex_in, tex_out](RHI_CommandList* cmd_list)                    \
+            {                                                                                                                     \
+                pass(cmd_list, render_target(tex_in).get(), render_target(tex_out).get());                                        \
+            });                                                                                                                   \
+        }
 
         // RENDER RESOLUTION
         {
@@ -1390,12 +1683,31 @@ namespace Spartan
             if (GetOption<bool>(RendererOption::DepthOfField))
             {
                 swap_render = !swap_render;
-                Pass_DepthOfField(cmd_list, get_render_in, get_render_out);
+                const RendererTexture tex_in  = get_render_in;
+                const RendererTexture tex_out = get_render_out;
+                m_render_graph.AddPass("depth_of_field",
+                    { tex_in, RendererTexture::gbuffer_depth },
+                    { tex_out, RendererTexture::dof_half, RendererTexture::dof_half_2 },
+                    [tex_in, tex_out](RHI_CommandList* cmd_list) { Pass_DepthOfField(cmd_list, render_target(tex_in).get(), render_target(tex_out).get()); }
+                );
             }
 
             // Line rendering (world grid, vectors, debugging etc)
-            Pass_Lines(cmd_list, get_render_out);
-            Pass_Outline(cmd_list, get_render_out);
+            const RendererTexture tex_out = get_render_out;
+            m_render_graph.AddPass("lines",
+                { tex_out, RendererTexture::gbuffer_depth },
+                { tex_out, RendererTexture::fsr2_mask_reactive },
+                [tex_out](RHI_CommandList* cmd_list) { Pass_Lines(cmd_list, render_target(tex_out).get()); }
+            );
+
+            if (GetOption<bool>(RendererOption::Debug_SelectionOutline))
+            {
+                m_render_graph.AddPass("outline",
+                    { tex_out, RendererTexture::gbuffer_depth },
+                    { tex_out, RendererTexture::outline, RendererTexture::blur },
+                    [tex_out](RHI_CommandList* cmd_list) { Pass_Outline(cmd_list, render_target(tex_out).get()); }
+                );
+            }
         }
 
         // Determine antialiasing modes
@@ -1412,15 +1724,28 @@ namespace Spartan
             if (upsampling_mode == UpsamplingMode::FSR2 || taa_enabled)
             {
                 swap_render = !swap_render;
-                Pass_Ffx_Fsr2(cmd_list, get_render_in, rt_frame_output);
+                const RendererTexture tex_in = get_render_in;
+                m_render_graph.AddPass("ffx_fsr2",
+                    { tex_in, RendererTexture::gbuffer_depth, RendererTexture::gbuffer_velocity, RendererTexture::fsr2_mask_reactive, RendererTexture::fsr2_mask_transparency },
+                    { RendererTexture::frame_output },
+                    [tex_in](RHI_CommandList* cmd_list) { Pass_Ffx_Fsr2(cmd_list, render_target(tex_in).get(), render_target(RendererTexture::frame_output).get()); }
+                );
             }
             // Linear
             else if (upsampling_mode == UpsamplingMode::Linear)
             {
                 // D3D11 baggage, can't blit to a texture with a different resolution or mip count
                 swap_render = !swap_render;
-                bool bilinear = m_resolution_output != m_resolution_render;
-                Pass_Copy(cmd_list, get_render_in, rt_frame_output, bilinear);
+                const RendererTexture tex_in = get_render_in;
+                m_render_graph.AddPass("upsample_linear",
+                    { tex_in },
+                    { RendererTexture::frame_output },
+                    [tex_in](RHI_CommandList* cmd_list)
+                    {
+                        bool bilinear = m_resolution_output != m_resolution_render;
+                        Pass_Copy(cmd_list, render_target(tex_in).get(), render_target(RendererTexture::frame_output).get(), bilinear);
+                    }
+                );
             }
         }
 
@@ -1430,19 +1755,31 @@ namespace Spartan
             if (GetOption<bool>(RendererOption::MotionBlur))
             {
                 swap_output = !swap_output;
-                Pass_MotionBlur(cmd_list, get_output_in, get_output_out);
+                const RendererTexture tex_in  = get_output_in;
+                const RendererTexture tex_out = get_output_out;
+                m_render_graph.AddPass("motion_blur",
+                    { tex_in, RendererTexture::gbuffer_depth, RendererTexture::gbuffer_velocity },
+                    { tex_out },
+                    [tex_in, tex_out](RHI_CommandList* cmd_list) { Pass_MotionBlur(cmd_list, render_target(tex_in).get(), render_target(tex_out).get()); }
+                );
             }
 
             // Bloom
             if (GetOption<bool>(RendererOption::Bloom))
             {
                 swap_output = !swap_output;
-                Pass_Bloom(cmd_list, get_output_in, get_output_out);
+                const RendererTexture tex_in  = get_output_in;
+                const RendererTexture tex_out = get_output_out;
+                m_render_graph.AddPass("bloom",
+                    { tex_in },
+                    { tex_out, RendererTexture::bloom },
+                    [tex_in, tex_out](RHI_CommandList* cmd_list) { Pass_Bloom(cmd_list, render_target(tex_in).get(), render_target(tex_out).get()); }
+                );
             }
 
             // Tone-Mapping & Gamma Correction
             swap_output = !swap_output;
-            Pass_ToneMappingGammaCorrection(cmd_list, get_output_in, get_output_out);
+            add_pass_in_out("tone_mapping_gamma_correction", Pass_ToneMappingGammaCorrection, get_output_in, get_output_out);
 
             // Sharpening
             if (GetOption<bool>(RendererOption::Sharpness))
@@ -1451,7 +1788,7 @@ namespace Spartan
                 if (upsampling_mode != UpsamplingMode::FSR2)
                 {
                     swap_output = !swap_output;
-                    Pass_Ffx_Cas(cmd_list, get_output_in, get_output_out);
+                    add_pass_in_out("ffx_cas", Pass_Ffx_Cas, get_output_in, get_output_out);
                 }
             }
 
@@ -1459,38 +1796,41 @@ namespace Spartan
             if (GetOption<bool>(RendererOption::Debanding))
             {
                 swap_output = !swap_output;
-                Pass_Debanding(cmd_list, get_output_in, get_output_out);
+                add_pass_in_out("debanding", Pass_Debanding, get_output_in, get_output_out);
             }
 
             // FXAA
             if (fxaa_enabled)
             {
                 swap_output = !swap_output;
-                Pass_Fxaa(cmd_list, get_output_in, get_output_out);
+                add_pass_in_out("fxaa", Pass_Fxaa, get_output_in, get_output_out);
             }
 
             // Chromatic aberration
             if (GetOption<bool>(RendererOption::ChromaticAberration))
             {
                 swap_output = !swap_output;
-                Pass_ChromaticAberration(cmd_list, get_output_in, get_output_out);
+                add_pass_in_out("chromatic_aberration", Pass_ChromaticAberration, get_output_in, get_output_out);
             }
 
             // Film grain
             if (GetOption<bool>(RendererOption::FilmGrain))
             {
                 swap_output = !swap_output;
-                Pass_FilmGrain(cmd_list, get_output_in, get_output_out);
+                add_pass_in_out("film_grain", Pass_FilmGrain, get_output_in, get_output_out);
             }
         }
 
         // If the last written texture is not the output one, then make sure it is.
         if (!swap_output)
         {
-            cmd_list->Blit(rt_frame_output_scratch, rt_frame_output, false);
+            m_render_graph.AddPass("blit_output", { RendererTexture::frame_output_2 }, { RendererTexture::frame_output }, [](RHI_CommandList* cmd_list)
+            {
+                cmd_list->Blit(render_target(RendererTexture::frame_output_2).get(), render_target(RendererTexture::frame_output).get(), false);
+            });
         }
 
-        cmd_list->EndMarker();
+        #undef add_pass_in_out
     }
 
     void Renderer::Pass_Bloom(RHI_CommandList* cmd_list, RHI_Texture* tex_in, RHI_Texture* tex_out)
@@ -1923,7 +2263,7 @@ namespace Spartan
         cmd_list->EndTimeblock();
     }
 
-    void Renderer::Pass_Ffx_Spd(RHI_CommandList* cmd_list, RHI_Texture* tex)
+    void Renderer::Pass_Ffx_Spd(RHI_CommandList* cmd_list, RHI_Texture* tex, const bool depth_min /*= false*/)
     {
         // AMD FidelityFX Single Pass Downsampler.
         // Provides an RDNA™-optimized solution for generating up to 12 MIP levels of a texture.
@@ -1939,7 +2279,7 @@ namespace Spartan
         SP_ASSERT(output_mip_count <= 12); // As per documentation (page 22)
 
         // Acquire shader
-        RHI_Shader* shader_c = shader(RendererShader::ffx_spd_c).get();
+        RHI_Shader* shader_c = shader(depth_min ? RendererShader::ffx_spd_depth_min_c : RendererShader::ffx_spd_c).get();
         if (!shader_c->IsCompiled())
             return;
 
@@ -2209,7 +2549,7 @@ namespace Spartan
 
                                     cmd_list->SetBufferVertex(mesh->GetVertexBuffer());
                                     cmd_list->SetBufferIndex(mesh->GetIndexBuffer());
-                                    cmd_list->DrawIndexed(renderable->GetIndexCount(), renderable->GetIndexOffset(), renderable->GetVertexOffset());
+                                    cmd_list->DrawIndexed(renderable->GetIndexCount(), mesh->GetIndexBufferOffset() + renderable->GetIndexOffset(), mesh->GetVertexBufferOffset() + renderable->GetVertexOffset());
                                     cmd_list->EndRenderPass();
                                 }
                             }
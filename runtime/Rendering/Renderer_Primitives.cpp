@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Entity.h"
 #include "../World/Components/Renderable.h"
 #include "../RHI/RHI_Vertex.h"
+#include "../Core/FrameAllocator.h"
 //=========================================
 
 //= NAMESPACES ===============
@@ -125,8 +126,7 @@ namespace Spartan
         // Need at least 4 segments
         segment_count = Helper::Max<uint32_t>(segment_count, 4);
 
-        vector<Vector3> points;
-        points.reserve(segment_count + 1);
+        pmr::vector<Vector3> points = frame_vector<Vector3>();
         points.resize(segment_count + 1);
 
         // Compute points on circle
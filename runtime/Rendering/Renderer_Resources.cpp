@@ -25,6 +25,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Geometry.h"
 #include "Grid.h"
 #include "Font/Font.h"
+#include "Culling.h"
+#include "RenderGraph.h"
 #include "../Resource/ResourceCache.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_Texture2DArray.h"
@@ -81,6 +83,9 @@ namespace Spartan
 
     //= BUFFERS ======================================
     shared_ptr<RHI_StructuredBuffer> m_sb_spd_counter;
+    shared_ptr<RHI_StructuredBuffer> m_sb_culling_objects;
+    shared_ptr<RHI_StructuredBuffer> m_sb_draws;
+    shared_ptr<RHI_StructuredBuffer> m_sb_draw_count;
 
     Cb_Frame m_cb_frame_cpu;
     shared_ptr<RHI_ConstantBuffer> m_cb_frame_gpu;
@@ -113,8 +118,9 @@ namespace Spartan
     shared_ptr<RHI_Texture> m_tex_gizmo_light_spot;
 
     // Misc
-    array<shared_ptr<RHI_Texture>, 26> m_render_targets;
-    array<shared_ptr<RHI_Shader>, 47> m_shaders;
+    array<shared_ptr<RHI_Texture>, 27> m_render_targets;
+    array<shared_ptr<RHI_Shader>, 50> m_shaders;
+    RenderGraph m_render_graph;
     unique_ptr<Font> m_font;
     unique_ptr<Grid> m_gizmo_grid;
 
@@ -140,6 +146,11 @@ namespace Spartan
     {
         const uint32_t offset_count = 32;
         m_sb_spd_counter = make_shared<RHI_StructuredBuffer>(static_cast<uint32_t>(sizeof(uint32_t)), offset_count, "spd_counter");
+
+        // GPU driven rendering - the objects are updated once per frame, the draws are only written by the GPU
+        m_sb_culling_objects = make_shared<RHI_StructuredBuffer>(static_cast<uint32_t>(sizeof(CullingObject) * Culling::object_count_max), 4, "culling_objects");
+        m_sb_draws           = make_shared<RHI_StructuredBuffer>(static_cast<uint32_t>(sizeof(RHI_Indirect_DrawIndexed) * Culling::object_count_max), 1, "draws");
+        m_sb_draw_count      = make_shared<RHI_StructuredBuffer>(static_cast<uint32_t>(sizeof(uint32_t)), offset_count, "draw_count");
     }
 
     void Renderer::CreateDepthStencilStates()
@@ -242,30 +253,30 @@ namespace Spartan
             render_target(RendererTexture::gbuffer_velocity) = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R16G16_Float,       RHI_Texture_RenderTarget | RHI_Texture_Srv,                                     "rt_gbuffer_velocity");
             render_target(RendererTexture::gbuffer_depth)    = make_shared<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_D32_Float,          RHI_Texture_RenderTarget | RHI_Texture_Srv | RHI_Texture_RenderTarget_ReadOnly, "rt_gbuffer_depth");
 
+            // Depth pyramid - Mips hold the farthest depth of the mip above, used for occlusion culling
+            render_target(RendererTexture::depth_pyramid) = make_shared<RHI_Texture2D>(width_render, height_render, mip_count, RHI_Format_R32_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_PerMipViews, "rt_depth_pyramid");
+
             // Light
-            render_target(RendererTexture::light_diffuse)              = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_diffuse");
-            render_target(RendererTexture::light_diffuse_transparent)  = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_diffuse_transparent");
-            render_target(RendererTexture::light_specular)             = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_specular");
-            render_target(RendererTexture::light_specular_transparent) = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_specular_transparent");
-            render_target(RendererTexture::light_volumetric)           = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_volumetric");
+            render_target(RendererTexture::light_diffuse)    = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_diffuse");
+            render_target(RendererTexture::light_volumetric) = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_volumetric");
 
             // SSR - Mips are used to emulate roughness for surfaces which require it
             render_target(RendererTexture::ssr) = make_shared<RHI_Texture2D>(width_render, height_render, mip_count, RHI_Format_R16G16B16A16_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_PerMipViews, "rt_ssr");
 
-            // SSAO
-            render_target(RendererTexture::ssao)    = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R16G16B16A16_Snorm, RHI_Texture_Uav | RHI_Texture_Srv, "rt_ssao");
-            render_target(RendererTexture::ssao_gi) = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R16G16B16A16_Snorm, RHI_Texture_Uav | RHI_Texture_Srv, "rt_ssao_gi");
-
-            // Dof
-            render_target(RendererTexture::dof_half)   = make_unique<RHI_Texture2D>(width_render / 2, height_render / 2, 1, RHI_Format_R16G16B16A16_Float, RHI_Texture_Uav | RHI_Texture_Srv, "rt_dof_half");
-            render_target(RendererTexture::dof_half_2) = make_unique<RHI_Texture2D>(width_render / 2, height_render / 2, 1, RHI_Format_R16G16B16A16_Float, RHI_Texture_Uav | RHI_Texture_Srv, "rt_dof_half_2");
 
             // FSR 2 masks
             render_target(RendererTexture::fsr2_mask_reactive)     = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R8_Unorm, RHI_Texture_RenderTarget | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_fsr2_reactive_mask");
             render_target(RendererTexture::fsr2_mask_transparency) = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R8_Unorm, RHI_Texture_RenderTarget | RHI_Texture_Srv, "rt_fsr2_transparency_mask");
 
-            // Selection outline
-            render_target(RendererTexture::outline) = make_unique<RHI_Texture2D>(width_render, height_render, 1, RHI_Format_R8G8B8A8_Unorm, RHI_Texture_RenderTarget | RHI_Texture_Srv | RHI_Texture_Uav, "rt_outline");
+            // Transient - Only live within a frame, so they are allocated by the render graph, which can alias them or skip them entirely
+            m_render_graph.SetTransient(RendererTexture::light_specular,             { width_render,     height_render,     1, RHI_Format_R11G11B10_Float,     RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_specular" });
+            m_render_graph.SetTransient(RendererTexture::light_diffuse_transparent,  { width_render,     height_render,     1, RHI_Format_R11G11B10_Float,     RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_diffuse_transparent" });
+            m_render_graph.SetTransient(RendererTexture::light_specular_transparent, { width_render,     height_render,     1, RHI_Format_R11G11B10_Float,     RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_light_specular_transparent" });
+            m_render_graph.SetTransient(RendererTexture::ssao,                       { width_render,     height_render,     1, RHI_Format_R16G16B16A16_Snorm,  RHI_Texture_Uav | RHI_Texture_Srv,                           "rt_ssao" });
+            m_render_graph.SetTransient(RendererTexture::ssao_gi,                    { width_render,     height_render,     1, RHI_Format_R16G16B16A16_Snorm,  RHI_Texture_Uav | RHI_Texture_Srv,                           "rt_ssao_gi" });
+            m_render_graph.SetTransient(RendererTexture::dof_half,                   { width_render / 2, height_render / 2, 1, RHI_Format_R16G16B16A16_Float,  RHI_Texture_Uav | RHI_Texture_Srv,                           "rt_dof_half" });
+            m_render_graph.SetTransient(RendererTexture::dof_half_2,                 { width_render / 2, height_render / 2, 1, RHI_Format_R16G16B16A16_Float,  RHI_Texture_Uav | RHI_Texture_Srv,                           "rt_dof_half_2" });
+            m_render_graph.SetTransient(RendererTexture::outline,                    { width_render,     height_render,     1, RHI_Format_R8G8B8A8_Unorm,      RHI_Texture_RenderTarget | RHI_Texture_Srv | RHI_Texture_Uav, "rt_outline" });
         }
 
         // Output resolution
@@ -276,7 +287,7 @@ namespace Spartan
             render_target(RendererTexture::frame_output_2) = make_unique<RHI_Texture2D>(width_output, height_output, 1, RHI_Format_R16G16B16A16_Float, RHI_Texture_RenderTarget | RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_ClearOrBlit, "rt_frame_output_2");
 
             // Bloom
-            render_target(RendererTexture::bloom) = make_shared<RHI_Texture2D>(width_output, height_output, mip_count, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_PerMipViews, "rt_bloom");
+            m_render_graph.SetTransient(RendererTexture::bloom, { width_output, height_output, mip_count, RHI_Format_R11G11B10_Float, RHI_Texture_Uav | RHI_Texture_Srv | RHI_Texture_PerMipViews, "rt_bloom" });
         }
 
         // Fixed resolution
@@ -293,7 +304,13 @@ namespace Spartan
             bool is_output_larger = width_output > width_render && height_output > height_render;
             uint32_t width        = is_output_larger ? width_output : width_render;
             uint32_t height       = is_output_larger ? height_output : height_render;
-            render_target(RendererTexture::blur) = make_unique<RHI_Texture2D>(width, height, 1, RHI_Format_R16G16B16A16_Float, RHI_Texture_Uav | RHI_Texture_Srv, "rt_blur");
+            m_render_graph.SetTransient(RendererTexture::blur, { width, height, 1, RHI_Format_R16G16B16A16_Float, RHI_Texture_Uav | RHI_Texture_Srv, "rt_blur" });
+        }
+
+        // Transients with the previous descriptions are of no use anymore
+        if (create_render || create_output || create_dynamic)
+        {
+            m_render_graph.ReleaseTransients();
         }
 
         RHI_FSR2::OnResolutionChange(GetResolutionRender(), GetResolutionOutput());
@@ -328,10 +345,18 @@ namespace Spartan
             shader(RendererShader::depth_prepass_v) = make_shared<RHI_Shader>();
             shader(RendererShader::depth_prepass_v)->Compile(RHI_Shader_Vertex, shader_dir + "depth_prepass.hlsl", async, RHI_Vertex_Type::PosUvNorTan);
 
+            shader(RendererShader::depth_prepass_indirect_v) = make_shared<RHI_Shader>();
+            shader(RendererShader::depth_prepass_indirect_v)->AddDefine("INDIRECT");
+            shader(RendererShader::depth_prepass_indirect_v)->Compile(RHI_Shader_Vertex, shader_dir + "depth_prepass.hlsl", async, RHI_Vertex_Type::PosUvNorTan);
+
             shader(RendererShader::depth_prepass_p) = make_shared<RHI_Shader>();
             shader(RendererShader::depth_prepass_p)->Compile(RHI_Shader_Pixel, shader_dir + "depth_prepass.hlsl", async);
         }
 
+        // Culling
+        shader(RendererShader::culling_c) = make_shared<RHI_Shader>();
+        shader(RendererShader::culling_c)->Compile(RHI_Shader_Compute, shader_dir + "culling.hlsl", async);
+
         // Depth light
         {
             shader(RendererShader::depth_light_V) = make_shared<RHI_Shader>();
@@ -499,6 +524,11 @@ namespace Spartan
             shader(RendererShader::ffx_spd_c) = make_shared<RHI_Shader>();
             shader(RendererShader::ffx_spd_c)->Compile(RHI_Shader_Compute, shader_dir + "amd_fidelity_fx\\spd.hlsl", false);
 
+            // AMD FidelityFX SPD - Min reduction, for the depth pyramid
+            shader(RendererShader::ffx_spd_depth_min_c) = make_shared<RHI_Shader>();
+            shader(RendererShader::ffx_spd_depth_min_c)->AddDefine("DEPTH_MIN");
+            shader(RendererShader::ffx_spd_depth_min_c)->Compile(RHI_Shader_Compute, shader_dir + "amd_fidelity_fx\\spd.hlsl", false);
+
             // BRDF - Specular Lut
             shader(RendererShader::brdf_specular_lut_c) = make_shared<RHI_Shader>();
             shader(RendererShader::brdf_specular_lut_c)->Compile(RHI_Shader_Compute, shader_dir + "brdf_specular_lut.hlsl", false); }
@@ -592,12 +622,17 @@ namespace Spartan
         return m_render_targets[static_cast<uint8_t>(rt_enum)];
     }
 
-    array<shared_ptr<RHI_Texture>, 26>& Renderer::GetRenderTargets()
+    array<shared_ptr<RHI_Texture>, 27>& Renderer::GetRenderTargets()
     {
         return m_render_targets;
     }
 
-    array<shared_ptr<RHI_Shader>, 47>& Renderer::GetShaders()
+    RenderGraph& Renderer::GetRenderGraph()
+    {
+        return m_render_graph;
+    }
+
+    array<shared_ptr<RHI_Shader>, 50>& Renderer::GetShaders()
     {
         return m_shaders;
     }
@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Rendering/Font/Font.h"
 #include "../Rendering/Animation.h"
 #include "../Rendering/Mesh.h"
+#include "../World/Prefab.h"
 //====================================
 
 //= NAMESPACES ==========
@@ -60,3 +61,4 @@ INSTANTIATE_TO_RESOURCE_TYPE(Material,              ResourceType::Material)
 INSTANTIATE_TO_RESOURCE_TYPE(Animation,             ResourceType::Animation)
 INSTANTIATE_TO_RESOURCE_TYPE(Font,                  ResourceType::Font)
 INSTANTIATE_TO_RESOURCE_TYPE(Mesh,                  ResourceType::Mesh)
+INSTANTIATE_TO_RESOURCE_TYPE(Prefab,                ResourceType::Prefab)
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <memory>
 #include "../Core/FileSystem.h"
 #include "../Core/Object.h"
+#include "../Core/Handle.h"
 #include "../Logging/Log.h"
 //=============================
 
@@ -43,6 +44,7 @@ namespace Spartan
         Animation,
         Font,
         Shader,
+        Prefab,
         Unknown,
     };
 
@@ -54,7 +56,7 @@ namespace Spartan
 
         void SetResourceFilePath(const std::string& path)
         {
-            const bool is_native_file = FileSystem::IsEngineMaterialFile(path) || FileSystem::IsEngineModelFile(path);
+            const bool is_native_file = FileSystem::IsEngineMaterialFile(path) || FileSystem::IsEngineModelFile(path) || FileSystem::IsEnginePrefabFile(path);
 
             // If this is an native engine file, don't do a file check as no actual foreign material exists (it was created on the fly)
             if (!is_native_file)
@@ -111,6 +113,14 @@ namespace Spartan
         // Misc
         bool IsReadyForUse() const { return m_is_ready_for_use; }
 
+        // Compact reference, assigned by the resource cache while the resource is cached
+        Handle<IResource> GetHandle() const            { return m_handle; }
+        void SetHandle(const Handle<IResource> handle) { m_handle = handle; }
+
+        // Dirty, the resource differs from what's in its native file and has to be saved again
+        bool IsDirty() const            { return m_is_dirty; }
+        void SetDirty(const bool dirty) { m_is_dirty = dirty; }
+
         // IO
         virtual bool SaveToFile(const std::string& file_path) { return true; }
         virtual bool LoadFromFile(const std::string& file_path) { return true; }
@@ -122,6 +132,8 @@ namespace Spartan
     protected:
         ResourceType m_resource_type         = ResourceType::Unknown;
         std::atomic<bool> m_is_ready_for_use = false;
+        std::atomic<bool> m_is_dirty         = true;
+        Handle<IResource> m_handle;
         uint32_t m_flags                     = 0;
 
     private:
@@ -26,12 +26,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Import/ModelImporter.h"
 #include "Import/FontImporter.h"
 #include "../World/World.h"
+#include "../Core/ThreadPool.h"
 #include "../IO/FileStream.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_Texture2DArray.h"
 #include "../RHI/RHI_TextureCube.h"
 #include "../Audio/AudioClip.h"
 #include "../Rendering/Mesh.h"
+#include "../World/Prefab.h"
 //====================================
 
 //= NAMESPACES ================
@@ -46,6 +48,7 @@ namespace Spartan
     static std::string m_project_directory;
 
     std::vector<std::shared_ptr<IResource>> ResourceCache::m_resources;
+    HandlePool<IResource> ResourceCache::m_handles;
     std::mutex ResourceCache::m_mutex;
     std::shared_ptr<ModelImporter> ResourceCache::m_importer_model;
     std::shared_ptr<ImageImporter> ResourceCache::m_importer_image;
@@ -81,17 +84,21 @@ namespace Spartan
         SP_ASSERT(!resource_name.empty());
 
         lock_guard<mutex> guard(m_mutex);
+        return Find(resource_name, resource_type) != nullptr;
+    }
 
+    shared_ptr<IResource>* ResourceCache::Find(const string& resource_name, const ResourceType resource_type)
+    {
         for (shared_ptr<IResource>& resource : m_resources)
         {
             if (resource->GetResourceType() != resource_type)
                 continue;
 
             if (resource_name == resource->GetResourceName())
-                return true;
+                return &resource;
         }
 
-        return false;
+        return nullptr;
     }
 
     bool ResourceCache::IsCached(const uint64_t resource_id)
@@ -186,29 +193,63 @@ namespace Spartan
             return;
         }
 
-        const uint32_t resource_count = GetResourceCount();
+        // List the resources which have a native file, and out of those, the ones which have to be saved again
+        vector<IResource*> resources_listed;
+        vector<IResource*> resources_to_save;
+        {
+            lock_guard<mutex> guard(m_mutex);
+
+            for (shared_ptr<IResource>& resource : m_resources)
+            {
+                if (!resource->HasFilePathNative())
+                    continue;
+
+                resources_listed.emplace_back(resource.get());
+
+                if (resource->IsDirty() || !FileSystem::Exists(resource->GetResourceFilePathNative()))
+                {
+                    resources_to_save.emplace_back(resource.get());
+                }
+            }
+        }
 
         // Start progress report
-        ProgressTracker::GetProgress(ProgressType::Resource).Start(resource_count, "Loading resources...");
+        ProgressTracker::GetProgress(ProgressType::Resource).Start(static_cast<uint32_t>(resources_to_save.size()), "Saving resources...");
 
         // Save resource count
-        file->Write(resource_count);
+        file->Write(static_cast<uint32_t>(resources_listed.size()));
 
-        // Save all the currently used resources to disk
-        for (shared_ptr<IResource>& resource : m_resources)
+        // Save file paths and types
+        for (IResource* resource : resources_listed)
+        {
+            file->Write(resource->GetResourceFilePathNative());
+            file->Write(static_cast<uint32_t>(resource->GetResourceType()));
+        }
+
+        // Save the resources (each to a dedicated file), they are independent so they can be saved in parallel
+        auto save = [&resources_to_save](uint32_t work_index_start, uint32_t work_index_end)
         {
-            if (!resource->HasFilePathNative())
+            for (uint32_t i = work_index_start; i < work_index_end; i++)
             {
-                // Save file path
-                file->Write(resource->GetResourceFilePathNative());
-                // Save type
-                file->Write(static_cast<uint32_t>(resource->GetResourceType()));
-                // Save resource (to a dedicated file)
-                resource->SaveToFile(resource->GetResourceFilePathNative());
+                IResource* resource = resources_to_save[i];
+                if (resource->SaveToFile(resource->GetResourceFilePathNative()))
+                {
+                    resource->SetDirty(false);
+                }
+
+                ProgressTracker::GetProgress(ProgressType::Resource).JobDone();
             }
+        };
 
-            // Update progress
-            ProgressTracker::GetProgress(ProgressType::Resource).JobDone();
+        const uint32_t save_count   = static_cast<uint32_t>(resources_to_save.size());
+        const uint32_t thread_count = ThreadPool::GetIdleThreadCount();
+        if (save_count > 1 && thread_count > 0 && save_count >= thread_count)
+        {
+            ThreadPool::ParallelLoop(save, save_count);
+        }
+        else
+        {
+            save(0, save_count);
         }
     }
 
@@ -254,6 +295,9 @@ namespace Spartan
             case ResourceType::Audio:
                 Load<AudioClip>(file_path);
                 break;
+            case ResourceType::Prefab:
+                Load<Prefab>(file_path);
+                break;
             }
         }
 
@@ -263,6 +307,7 @@ namespace Spartan
     {
         uint32_t resource_count = static_cast<uint32_t>(m_resources.size());
 
+        m_handles.Clear();
         m_resources.clear();
 
         SP_LOG_INFO("%d resources have been cleared", resource_count);
@@ -59,10 +59,17 @@ namespace Spartan
         // Get by type
         static std::vector<std::shared_ptr<IResource>> GetByType(ResourceType type = ResourceType::Unknown);
 
+        // Get by handle, lock free and O(1), null if the resource is no longer cached
+        static IResource* GetByHandle(const Handle<IResource> handle) { return m_handles.Get(handle); }
+        template <class T>
+        static T* GetByHandle(const Handle<IResource> handle) { return static_cast<T*>(GetByHandle(handle)); }
+
         // Get by path
         template <class T>
         static std::shared_ptr<T> GetByPath(const std::string& path)
         {
+            std::lock_guard<std::mutex> guard(m_mutex);
+
             for (std::shared_ptr<IResource>& resource : m_resources)
             {
                 if (path == resource->GetResourceFilePathNative())
@@ -94,16 +101,16 @@ namespace Spartan
                 return nullptr;
             }
 
-            // Ensure that this resource is not already cached
-            if (IsCached(resource->GetResourceName(), resource->GetResourceType()))
-                return GetByName<T>(resource->GetResourceName());
-
+            // Look up and insert under the same lock, so that threads caching the same resource can't both insert it
             std::lock_guard<std::mutex> guard(m_mutex);
+            if (std::shared_ptr<IResource>* cached = Find(resource->GetResourceName(), resource->GetResourceType()))
+                return std::static_pointer_cast<T>(*cached);
 
             // In order to guarantee deserialization, we save it now
             resource->SaveToFile(resource->GetResourceFilePathNative());
 
             // Cache it
+            resource->SetHandle(m_handles.Add(resource.get()));
             return std::static_pointer_cast<T>(m_resources.emplace_back(resource));
         }
 
@@ -119,8 +126,11 @@ namespace Spartan
 
             // Check if the resource is already loaded
             const std::string name = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
-            if (IsCached(name, IResource::TypeToEnum<T>()))
-                return GetByName<T>(name);
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                if (std::shared_ptr<IResource>* cached = Find(name, IResource::TypeToEnum<T>()))
+                    return std::static_pointer_cast<T>(*cached);
+            }
 
             // Create new resource
             std::shared_ptr<T> resource = std::make_shared<T>();
@@ -140,6 +150,9 @@ namespace Spartan
                 return nullptr;
             }
 
+            // A resource which was loaded from its native file matches it, an imported one still has to be saved
+            resource->SetDirty(!FileSystem::IsEngineFile(file_path));
+
             // Returned cached reference which is guaranteed to be around after deserialization
             return Cache<T>(resource);
         }
@@ -150,16 +163,21 @@ namespace Spartan
             if (!resource)
                 return;
 
-            if (!IsCached(resource->GetResourceName(), resource->GetResourceType()))
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (!Find(resource->GetResourceName(), resource->GetResourceType()))
                 return;
 
+            m_handles.Remove(resource->GetHandle());
+            resource->SetHandle(Handle<IResource>());
+
+            const uint64_t id = resource->GetObjectId();
             m_resources.erase
             (
                 std::remove_if
                 (
                     m_resources.begin(),
                     m_resources.end(),
-                    [](std::shared_ptr<IResource> resource) { return dynamic_cast<Object*>(resource.get())->GetObjectId() == resource->GetObjectId(); }
+                    [id](std::shared_ptr<IResource>& cached) { return cached->GetObjectId() == id; }
                 ),
                 m_resources.end()
             );
@@ -188,12 +206,16 @@ namespace Spartan
         static bool IsCached(const uint64_t resource_id);
         static bool IsCached(const std::string& resource_name, const ResourceType resource_type);
 
+        // Returns the cached resource with the given name and type, or null, m_mutex has to be held
+        static std::shared_ptr<IResource>* Find(const std::string& resource_name, const ResourceType resource_type);
+
         // Event handlers
         static void SaveResourcesToFiles();
         static void LoadResourcesFromFiles();
 
         // Cache
         static std::vector<std::shared_ptr<IResource>> m_resources;
+        static HandlePool<IResource> m_handles;
         static std::mutex m_mutex;
 
         // Importers
@@ -0,0 +1,301 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =============
+#include "pch.h"
+#include "ComponentStore.h"
+#include "Entity.h"
+//========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        static recursive_mutex m_mutex;
+        static thread_local bool m_deferred = false;
+        static uint32_t m_iteration_depth   = 0; // guarded by m_mutex, which iterations hold
+        static vector<Entity*> m_slot_entities;  // indexed by entity slot
+        static vector<uint32_t> m_slots_free;
+        static vector<shared_ptr<IComponent>> m_released; // removed during a tick, released once it ends
+        static bool m_ticking = false;
+
+        // A dense array is sorted again once this fraction of it has been shuffled by removals
+        static const uint32_t sort_threshold_divisor = 8;
+
+        static const uint32_t type_count = static_cast<uint32_t>(ComponentType::Undefined) + 1;
+    }
+
+    void ComponentStore::Add(IComponent* component)
+    {
+        SP_ASSERT(component != nullptr);
+        SP_ASSERT(component->GetType() != ComponentType::Undefined);
+
+        if (m_deferred)
+            return;
+
+        lock_guard lock(m_mutex);
+
+        if (component->m_store_index != IComponent::store_index_invalid)
+            return;
+
+        // Entities get a slot with their first component
+        Entity* entity = component->GetEntity();
+        if (entity->m_store_slot == index_invalid)
+        {
+            if (!m_slots_free.empty())
+            {
+                entity->m_store_slot = m_slots_free.back();
+                m_slots_free.pop_back();
+                m_slot_entities[entity->m_store_slot] = entity;
+            }
+            else
+            {
+                entity->m_store_slot = static_cast<uint32_t>(m_slot_entities.size());
+                m_slot_entities.emplace_back(entity);
+            }
+        }
+
+        const uint32_t slot = entity->m_store_slot;
+        Set& set            = GetSet(component->GetType());
+        if (slot >= set.sparse.size())
+        {
+            set.sparse.resize(max(static_cast<size_t>(slot) + 1, set.sparse.size() * 2), index_invalid);
+        }
+
+        component->m_store_index = static_cast<uint32_t>(set.components.size());
+        set.sparse[slot]         = component->m_store_index;
+        set.components.emplace_back(component);
+        set.slots.emplace_back(slot);
+    }
+
+    void ComponentStore::Remove(IComponent* component)
+    {
+        SP_ASSERT(component != nullptr);
+
+        lock_guard lock(m_mutex);
+
+        const uint32_t index = component->m_store_index;
+        if (index == IComponent::store_index_invalid)
+            return;
+
+        Set& set = GetSet(component->GetType());
+        SP_ASSERT(index < set.components.size() && set.components[index] == component);
+
+        set.sparse[set.slots[index]] = index_invalid;
+        component->m_store_index     = IComponent::store_index_invalid;
+
+        // While iterating, only null it out, moving the last component into its slot would make the iteration skip it
+        if (m_iteration_depth > 0)
+        {
+            set.components[index] = nullptr;
+            set.removed_deferred++;
+            return;
+        }
+
+        // Move the last component into the slot of the removed one
+        const uint32_t index_last = static_cast<uint32_t>(set.components.size()) - 1;
+        if (index != index_last)
+        {
+            IComponent* last             = set.components[index_last];
+            set.components[index]        = last;
+            set.slots[index]             = set.slots[index_last];
+            set.sparse[set.slots[index]] = index;
+            last->m_store_index          = index;
+            set.removed_unsorted++;
+        }
+        set.components.pop_back();
+        set.slots.pop_back();
+    }
+
+    void ComponentStore::RemoveAll(Entity* entity)
+    {
+        SP_ASSERT(entity != nullptr);
+
+        lock_guard lock(m_mutex);
+
+        for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+        {
+            if (component)
+            {
+                Remove(component.get());
+            }
+        }
+
+        // Give the slot back, it was cleared from every sparse array by the removals above
+        if (entity->m_store_slot != index_invalid)
+        {
+            m_slot_entities[entity->m_store_slot] = nullptr;
+            m_slots_free.emplace_back(entity->m_store_slot);
+            entity->m_store_slot = index_invalid;
+        }
+    }
+
+    void ComponentStore::SetDeferred(const bool deferred)
+    {
+        m_deferred = deferred;
+    }
+
+    void ComponentStore::SetTicking(const bool ticking)
+    {
+        vector<shared_ptr<IComponent>> released;
+        {
+            lock_guard lock(m_mutex);
+            m_ticking = ticking;
+            released.swap(m_released);
+        }
+
+        // Destroyed outside of the lock, components remove themselves from the store when destroyed
+        released.clear();
+    }
+
+    void ComponentStore::Release(shared_ptr<IComponent>& component)
+    {
+        lock_guard lock(m_mutex);
+
+        if (m_ticking && component)
+        {
+            m_released.emplace_back(move(component));
+        }
+        component = nullptr;
+    }
+
+    void ComponentStore::Clear()
+    {
+        lock_guard lock(m_mutex);
+        SP_ASSERT_MSG(m_iteration_depth == 0, "The store can't be cleared while it's being iterated");
+
+        for (uint32_t type = 0; type < type_count; type++)
+        {
+            Set& set = GetSet(static_cast<ComponentType>(type));
+            for (IComponent* component : set.components)
+            {
+                component->m_store_index = IComponent::store_index_invalid;
+            }
+
+            set = Set();
+        }
+
+        for (Entity* entity : m_slot_entities)
+        {
+            if (entity)
+            {
+                entity->m_store_slot = index_invalid;
+            }
+        }
+        m_slot_entities.clear();
+        m_slots_free.clear();
+    }
+
+    void ComponentStore::Sort()
+    {
+        lock_guard lock(m_mutex);
+        SP_ASSERT_MSG(m_iteration_depth == 0, "The store can't be sorted while it's being iterated");
+
+        for (uint32_t type = 0; type < type_count; type++)
+        {
+            Set& set = GetSet(static_cast<ComponentType>(type));
+            if (set.removed_unsorted > 0 && set.removed_unsorted >= set.components.size() / sort_threshold_divisor)
+            {
+                SortSet(set);
+            }
+        }
+    }
+
+    const vector<IComponent*>& ComponentStore::Get(const ComponentType type)
+    {
+        return GetSet(type).components;
+    }
+
+    recursive_mutex& ComponentStore::GetMutex()
+    {
+        return m_mutex;
+    }
+
+    ComponentStore::Iteration::Iteration()
+    {
+        m_iteration_depth++;
+    }
+
+    ComponentStore::Iteration::~Iteration()
+    {
+        m_iteration_depth--;
+        if (m_iteration_depth != 0)
+            return;
+
+        for (uint32_t type = 0; type < type_count; type++)
+        {
+            Set& set = GetSet(static_cast<ComponentType>(type));
+            if (set.removed_deferred > 0)
+            {
+                Compact(set);
+            }
+        }
+    }
+
+    ComponentStore::Set& ComponentStore::GetSet(const ComponentType type)
+    {
+        static array<Set, type_count> sets;
+        return sets[static_cast<uint32_t>(type)];
+    }
+
+    void ComponentStore::Compact(Set& set)
+    {
+        // Drop the nulls, keeping the order of the rest
+        uint32_t index_write = 0;
+        for (uint32_t index_read = 0; index_read < static_cast<uint32_t>(set.components.size()); index_read++)
+        {
+            IComponent* component = set.components[index_read];
+            if (!component)
+                continue;
+
+            set.components[index_write]        = component;
+            set.slots[index_write]             = set.slots[index_read];
+            set.sparse[set.slots[index_write]] = index_write;
+            component->m_store_index           = index_write;
+            index_write++;
+        }
+
+        set.components.resize(index_write);
+        set.slots.resize(index_write);
+        set.removed_deferred = 0;
+    }
+
+    void ComponentStore::SortSet(Set& set)
+    {
+        sort(set.components.begin(), set.components.end(), less<IComponent*>());
+
+        for (uint32_t index = 0; index < static_cast<uint32_t>(set.components.size()); index++)
+        {
+            IComponent* component    = set.components[index];
+            const uint32_t slot      = component->GetEntity()->m_store_slot;
+            set.slots[index]         = slot;
+            set.sparse[slot]         = index;
+            component->m_store_index = index;
+        }
+
+        set.removed_unsorted = 0;
+    }
+}
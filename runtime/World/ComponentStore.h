@@ -0,0 +1,146 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =========================
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <utility>
+#include "Components/IComponent.h"
+//====================================
+
+namespace Spartan
+{
+    // A sparse set per component type. Every type keeps a dense array of its live components, along with the slot of
+    // the entity each one belongs to, and a sparse array which maps entity slots to dense indices. Systems iterate a type
+    // without visiting every entity (and every empty component slot), and queries over several types find the rest of the
+    // components through the sparse arrays instead of going through the entities. Each component knows its index in the
+    // dense array, so adding and removing is O(1) (swap and pop). While the store is being iterated, removed components
+    // are only nulled out and the arrays are compacted once the iteration is over, so an iteration never skips or revisits
+    // a component. Ownership stays with the entity, the components themselves are allocated from per-type pools.
+    class SP_CLASS ComponentStore
+    {
+    public:
+        static void Add(IComponent* component);
+        static void Remove(IComponent* component);
+        static void RemoveAll(Entity* entity);
+        static void Clear();
+
+        // While deferred, components added on the calling thread are not tracked until Add() is called for them again,
+        // this way entities can be built in the background without ticking while they are half constructed
+        static void SetDeferred(bool deferred);
+
+        // While the world's systems tick, they iterate a snapshot of the dense arrays, so components which get removed
+        // in the meantime are kept alive (but no longer tracked) until the tick is over
+        static void SetTicking(bool ticking);
+        static void Release(std::shared_ptr<IComponent>& component);
+        static bool IsTracked(const IComponent* component) { return component->m_store_index != IComponent::store_index_invalid; }
+
+        // Orders the dense arrays which removals have shuffled by address, so that iterating them walks the
+        // pools of the components front to back, can't be called while iterating
+        static void Sort();
+
+        // Dense array of all the components of a type, the order changes as components get removed. While an
+        // iteration is in progress, components which were removed during it are null.
+        static const std::vector<IComponent*>& Get(const ComponentType type);
+
+        template <class T>
+        static const std::vector<IComponent*>& Get() { return Get(IComponent::TypeToEnum<T>()); }
+
+        // Calls function(T0*, T1*, ...) for every entity that has all of the given components. The dense array of the
+        // rarest type is iterated and the rest are looked up in the sparse arrays. The function can add and remove
+        // components (added components of the iterated type are visited as well, removed ones are not).
+        template <class... Ts, class Function>
+        static void Each(Function&& function)
+        {
+            static_assert(sizeof...(Ts) > 0, "At least one component type is required");
+
+            std::lock_guard<std::recursive_mutex> lock(GetMutex());
+            const Iteration iteration;
+
+            const Set* sets[] = { &GetSet(IComponent::TypeToEnum<Ts>())... };
+            const Set* rarest = sets[0];
+            for (const Set* set : sets)
+            {
+                rarest = set->components.size() < rarest->components.size() ? set : rarest;
+            }
+
+            // Indexed, so that the function can add components (the array can grow)
+            IComponent* components[sizeof...(Ts)];
+            for (uint32_t i = 0; i < static_cast<uint32_t>(rarest->components.size()); i++)
+            {
+                if (!rarest->components[i])
+                    continue;
+
+                const uint32_t slot = rarest->slots[i];
+                bool complete       = true;
+                for (uint32_t type = 0; type < sizeof...(Ts) && complete; type++)
+                {
+                    components[type] = sets[type]->Find(slot);
+                    complete         = components[type] != nullptr;
+                }
+
+                if (complete)
+                {
+                    [&function, &components]<size_t... Is>(std::index_sequence<Is...>)
+                    {
+                        function(static_cast<Ts*>(components[Is])...);
+                    }(std::index_sequence_for<Ts...>());
+                }
+            }
+        }
+
+        // Held while iterating, adding and removing, it's recursive so iteration callbacks can add and remove components
+        static std::recursive_mutex& GetMutex();
+
+    private:
+        static constexpr uint32_t index_invalid = 0xFFFFFFFF;
+
+        struct Set
+        {
+            IComponent* Find(const uint32_t slot) const
+            {
+                const uint32_t index = slot < sparse.size() ? sparse[slot] : index_invalid;
+                return index != index_invalid ? components[index] : nullptr;
+            }
+
+            std::vector<IComponent*> components; // dense
+            std::vector<uint32_t> slots;         // dense, the slot of the entity of every component
+            std::vector<uint32_t> sparse;        // indexed by entity slot, the index of the entity's component in the dense arrays
+            uint32_t removed_deferred = 0;       // nulled out during an iteration, compacted when it ends
+            uint32_t removed_unsorted = 0;       // swapped and popped since the last sort
+        };
+
+        // Removals are deferred while at least one of these is alive
+        struct Iteration
+        {
+            Iteration();
+            ~Iteration();
+        };
+
+        static Set& GetSet(const ComponentType type);
+        static void Compact(Set& set);
+        static void SortSet(Set& set);
+    };
+}
@@ -29,8 +29,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Input/Input.h"
 #include "../../IO/FileStream.h"
 #include "../../Rendering/Renderer.h"
+#include "../../Rendering/Mesh.h"
 #include "../../Display/Display.h"
 #include "../RHI/RHI_Vertex.h"
+#include "../../Core/FrameAllocator.h"
 #include "Window.h"
 //===================================
 
@@ -182,32 +184,27 @@ namespace Spartan
         m_ray = ComputePickingRay();
 
         // Traces ray against all AABBs in the world
-        vector<RayHit> hits;
+        pmr::vector<RayHit> hits = frame_vector<RayHit>();
         {
-            const auto& entities = World::GetAllEntities();
-            for (const auto& entity : entities)
+            World::Each<Renderable>([this, &hits](Renderable* renderable)
             {
-                // Make sure there entity has a renderable
-                if (!entity->GetComponent<Renderable>())
-                    continue;
-
                 // Get object oriented bounding box
-                const BoundingBox& aabb = entity->GetComponent<Renderable>()->GetAabb();
+                const BoundingBox& aabb = renderable->GetAabb();
 
                 // Compute hit distance
                 float distance = m_ray.HitDistance(aabb);
 
                 // Don't store hit data if there was no hit
                 if (distance == Helper::INFINITY_)
-                    continue;
+                    return;
 
                 hits.emplace_back(
-                    entity,                                             // Entity
+                    renderable->GetEntity()->GetPtrShared(),            // Entity
                     m_ray.GetStart() + m_ray.GetDirection() * distance, // Position
                     distance,                                           // Distance
                     distance == 0.0f                                    // Inside
                 );
-            }
+            });
 
             // Sort by distance (ascending)
             std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.m_distance < b.m_distance; });
@@ -231,26 +228,36 @@ namespace Spartan
         float distance_min = numeric_limits<float>::max();
         for (RayHit& hit : hits)
         {
-            // Get entity geometry
-            Renderable* renderable = hit.m_entity->GetRenderable();
-            vector<uint32_t> indicies;
-            vector<RHI_Vertex_PosTexNorTan> vertices;
-            renderable->GetGeometry(&indicies, &vertices);
-            if (indicies.empty()|| vertices.empty())
+            // Get entity geometry, it's read in place since copying it would mean allocating as much memory as the mesh takes
+            Renderable* renderable       = hit.m_entity->GetRenderable();
+            Mesh* mesh                   = renderable->GetMesh();
+            const uint32_t index_offset  = renderable->GetIndexOffset();
+            const uint32_t index_count   = renderable->GetIndexCount();
+            const uint32_t vertex_offset = renderable->GetVertexOffset();
+            const uint32_t vertex_count  = renderable->GetVertexCount();
+            if (!mesh || index_count == 0 || vertex_count == 0 || index_offset + index_count > mesh->GetIndices().size() || vertex_offset + vertex_count > mesh->GetVertices().size())
             {
-                SP_LOG_ERROR("Failed to get geometry of entity %s, skipping intersection test.");
+                SP_LOG_ERROR("Failed to get geometry of entity %s, skipping intersection test.", hit.m_entity->GetName().c_str());
                 continue;
             }
+            const uint32_t* indices                 = mesh->GetIndices().data() + index_offset;
+            const RHI_Vertex_PosTexNorTan* vertices = mesh->GetVertices().data() + vertex_offset;
 
             // Compute matrix which can transform vertices to view space
             Matrix vertex_transform = hit.m_entity->GetTransform()->GetMatrix();
 
+            auto position = [indices, vertices](const uint32_t index)
+            {
+                const float* pos = vertices[indices[index]].pos;
+                return Vector3(pos[0], pos[1], pos[2]);
+            };
+
             // Go through each face
-            for (uint32_t i = 0; i < indicies.size(); i += 3)
+            for (uint32_t i = 0; i < index_count; i += 3)
             {
-                Vector3 p1_world = Vector3(vertices[indicies[i]].pos) * vertex_transform;
-                Vector3 p2_world = Vector3(vertices[indicies[i + 1]].pos) * vertex_transform;
-                Vector3 p3_world = Vector3(vertices[indicies[i + 2]].pos) * vertex_transform;
+                Vector3 p1_world = position(i) * vertex_transform;
+                Vector3 p2_world = position(i + 1) * vertex_transform;
+                Vector3 p3_world = position(i + 2) * vertex_transform;
 
                 float distance = m_ray.HitDistance(p1_world, p2_world, p3_world);
                 
@@ -217,6 +217,7 @@ namespace Spartan
     {
         RigidBody_SetShape(nullptr);
         delete m_shape;
+        m_shape = nullptr;
     }
 
     void Collider::RigidBody_SetShape(btCollisionShape* shape) const
@@ -52,6 +52,7 @@ namespace Spartan
         m_errorReduction          = 0.0f;
         m_constraintForceMixing   = 0.0f;
         m_constraintType          = ConstraintType_Point;
+        m_bodyOtherId             = 0;
 
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_errorReduction, float);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_constraintForceMixing, float);
@@ -93,6 +94,12 @@ namespace Spartan
     {
         if (m_deferredConstruction)
         {
+            // The other body might have been deserialized after this one (world blocks load in parallel)
+            if (m_bodyOther.expired() && m_bodyOtherId != 0)
+            {
+                m_bodyOther = World::GetEntityById(m_bodyOtherId);
+            }
+
             Construct();
         }
     }
@@ -117,8 +124,8 @@ namespace Spartan
         stream->Read(&m_highLimit);
         stream->Read(&m_lowLimit);
 
-        const auto body_other_id = stream->ReadAs<uint32_t>();
-        m_bodyOther = World::GetEntityById(body_other_id);
+        m_bodyOtherId = stream->ReadAs<uint32_t>();
+        m_bodyOther   = World::GetEntityById(m_bodyOtherId);
 
         Construct();
     }
@@ -179,7 +186,8 @@ namespace Spartan
             return;
         }
 
-        m_bodyOther = body_other;
+        m_bodyOther   = body_other;
+        m_bodyOtherId = body_other.lock()->GetObjectId();
         Construct();
     }
 
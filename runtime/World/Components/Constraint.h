@@ -106,6 +106,7 @@ namespace Spartan
         Math::Vector2 m_lowLimit;
 
         std::weak_ptr<Entity> m_bodyOther;
+        uint64_t m_bodyOtherId;
         Math::Vector3 m_positionOther;
         Math::Quaternion m_rotationOther;
     
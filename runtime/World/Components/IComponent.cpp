@@ -36,6 +36,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Terrain.h"
 #include "ReflectionProbe.h"
 #include "../Entity.h"
+#include "../ComponentStore.h"
 //==========================
 
 //= NAMESPACES =====
@@ -51,6 +52,11 @@ namespace Spartan
         m_enabled   = true;
     }
 
+    IComponent::~IComponent()
+    {
+        ComponentStore::Remove(this);
+    }
+
     template <typename T>
     inline constexpr ComponentType IComponent::TypeToEnum() { return ComponentType::Undefined; }
 
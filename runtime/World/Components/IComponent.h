@@ -64,7 +64,7 @@ namespace Spartan
     {
     public:
         IComponent(Entity* entity, uint64_t id = 0, Transform* transform = nullptr);
-        virtual ~IComponent() = default;
+        virtual ~IComponent();
 
         // Runs when the component gets added
         virtual void OnInitialize() {}
@@ -145,7 +145,12 @@ namespace Spartan
         Transform* m_transform = nullptr;
 
     private:
+        friend class ComponentStore;
+        static constexpr uint32_t store_index_invalid = 0xFFFFFFFF;
+
         // The attributes of the component
         std::vector<Attribute> m_attributes;
+        // The index of the component in the dense array of its type
+        uint32_t m_store_index = store_index_invalid;
     };
 }
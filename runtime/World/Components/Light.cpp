@@ -31,6 +31,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../RHI/RHI_Texture2D.h"
 #include "../../RHI/RHI_TextureCube.h"
 #include "../../RHI/RHI_Texture2DArray.h"
+#include "../../Core/FrameAllocator.h"
 //=======================================
 
 //= NAMESPACES ===============
@@ -185,7 +186,7 @@ namespace Spartan
             CreateShadowMap();
         }
 
-        World::Resolve();
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, m_entity);
     }
 
     void Light::SetColor(const float temperature)
@@ -359,7 +360,8 @@ namespace Spartan
         const float max_z        = clip_near + clip_range;
         const float range        = max_z - min_z;
         const float ratio        = max_z / min_z;
-        vector<float> splits(m_cascade_count);
+        pmr::vector<float> splits = frame_vector<float>();
+        splits.resize(m_cascade_count);
         for (uint32_t i = 0; i < m_cascade_count; i++)
         {
             const float p       = (i + 1) / static_cast<float>(m_cascade_count);
@@ -38,9 +38,24 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-    inline void build(const DefaultGeometry type, Renderable* renderable)
-    {    
-        Mesh* mesh = new Mesh();
+    namespace
+    {
+        const shared_ptr<const RenderableGeometry> geometry_empty = make_shared<const RenderableGeometry>();
+
+        // Default geometry is built once and shared by every renderable which uses it
+        mutex default_geometry_mutex;
+        array<weak_ptr<const RenderableGeometry>, 6> default_geometries;
+    }
+
+    static shared_ptr<const RenderableGeometry> build(const DefaultGeometry type)
+    {
+        lock_guard lock(default_geometry_mutex);
+
+        weak_ptr<const RenderableGeometry>& cached = default_geometries[static_cast<uint32_t>(type)];
+        if (shared_ptr<const RenderableGeometry> geometry = cached.lock())
+            return geometry;
+
+        shared_ptr<Mesh> mesh = make_shared<Mesh>();
         vector<RHI_Vertex_PosTexNorTan> vertices;
         vector<uint32_t> indices;
 
@@ -74,7 +89,7 @@ namespace Spartan
         }
 
         if (vertices.empty() || indices.empty())
-            return;
+            return nullptr;
 
         mesh->AddIndices(indices);
         mesh->AddVertices(vertices);
@@ -82,42 +97,39 @@ namespace Spartan
         mesh->ComputeNormalizedScale();
         mesh->CreateGpuBuffers();
 
-        renderable->SetGeometry(
-            "Default_Geometry",
-            0,
-            static_cast<uint32_t>(indices.size()),
-            0,
-            static_cast<uint32_t>(vertices.size()),
-            BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size())),
-            mesh
-        );
+        shared_ptr<RenderableGeometry> geometry = make_shared<RenderableGeometry>();
+        geometry->name         = "Default_Geometry";
+        geometry->index_count  = static_cast<uint32_t>(indices.size());
+        geometry->vertex_count = static_cast<uint32_t>(vertices.size());
+        geometry->type         = type;
+        geometry->mesh         = mesh.get();
+        geometry->mesh_owned   = move(mesh);
+        geometry->bounding_box = BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
+
+        cached = geometry;
+        return geometry;
     }
 
     Renderable::Renderable(Entity* entity, uint64_t id /*= 0*/) : IComponent(entity, id)
     {
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_material_default,        bool);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_material,                Material*);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_cast_shadows,            bool);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry_index_offset,   uint32_t);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry_index_count,    uint32_t);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry_vertex_offset,  uint32_t);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry_vertex_count,   uint32_t);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry_name,           string);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_mesh,                    Mesh*);
-        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_bounding_box,            BoundingBox);
-        SP_REGISTER_ATTRIBUTE_GET_SET(DefaultGeometry, SetGeometry,  DefaultGeometry);
+        m_geometry = geometry_empty;
+
+        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_material_default, bool);
+        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_material,         Material*);
+        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_cast_shadows,     bool);
+        SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_geometry,         shared_ptr<const RenderableGeometry>); // copies share the geometry
     }
 
     void Renderable::Serialize(FileStream* stream)
     {
         // Mesh
-        stream->Write(static_cast<uint32_t>(m_geometry_type));
-        stream->Write(m_geometry_index_offset);
-        stream->Write(m_geometry_index_count);
-        stream->Write(m_geometry_vertex_offset);
-        stream->Write(m_geometry_vertex_count);
-        stream->Write(m_bounding_box);
-        stream->Write(m_mesh ? m_mesh->GetResourceName() : "");
+        stream->Write(static_cast<uint32_t>(m_geometry->type));
+        stream->Write(m_geometry->index_offset);
+        stream->Write(m_geometry->index_count);
+        stream->Write(m_geometry->vertex_offset);
+        stream->Write(m_geometry->vertex_count);
+        stream->Write(m_geometry->bounding_box);
+        stream->Write(m_geometry->mesh ? m_geometry->mesh->GetResourceName() : "");
 
         // Material
         stream->Write(m_cast_shadows);
@@ -131,20 +143,26 @@ namespace Spartan
     void Renderable::Deserialize(FileStream* stream)
     {
         // Geometry
-        m_geometry_type          = static_cast<DefaultGeometry>(stream->ReadAs<uint32_t>());
-        m_geometry_index_offset  = stream->ReadAs<uint32_t>();
-        m_geometry_index_count   = stream->ReadAs<uint32_t>();
-        m_geometry_vertex_offset = stream->ReadAs<uint32_t>();
-        m_geometry_vertex_count  = stream->ReadAs<uint32_t>();
-        stream->Read(&m_bounding_box);
+        shared_ptr<RenderableGeometry> geometry = make_shared<RenderableGeometry>(*m_geometry);
+        geometry->type          = static_cast<DefaultGeometry>(stream->ReadAs<uint32_t>());
+        geometry->index_offset  = stream->ReadAs<uint32_t>();
+        geometry->index_count   = stream->ReadAs<uint32_t>();
+        geometry->vertex_offset = stream->ReadAs<uint32_t>();
+        geometry->vertex_count  = stream->ReadAs<uint32_t>();
+        stream->Read(&geometry->bounding_box);
         string model_name;
         stream->Read(&model_name);
-        m_mesh = ResourceCache::GetByName<Mesh>(model_name).get();
+        geometry->mesh = ResourceCache::GetByName<Mesh>(model_name).get();
+        geometry->mesh_owned.reset();
 
         // If it was a default mesh, we have to reconstruct it
-        if (m_geometry_type != DefaultGeometry::Undefined)
+        if (geometry->type != DefaultGeometry::Undefined)
         {
-            SetGeometry(m_geometry_type);
+            SetGeometry(geometry->type);
+        }
+        else
+        {
+            m_geometry = move(geometry);
         }
 
         // Material
@@ -164,31 +182,44 @@ namespace Spartan
 
     void Renderable::SetGeometry(const string& name, const uint32_t index_offset, const uint32_t index_count, const uint32_t vertex_offset, const uint32_t vertex_count, const BoundingBox& bounding_box, Mesh* mesh)
     {
-        // Terrible way to delete previous geometry in case it's a default one
-        if (m_geometry_name == "Default_Geometry")
-        {
-            delete m_mesh;
-        }
-
-        m_geometry_name          = name;
-        m_geometry_index_offset  = index_offset;
-        m_geometry_index_count   = index_count;
-        m_geometry_vertex_offset = vertex_offset;
-        m_geometry_vertex_count  = vertex_count;
-        m_bounding_box           = bounding_box;
-        m_mesh                   = mesh;
+        shared_ptr<RenderableGeometry> geometry = make_shared<RenderableGeometry>();
+        geometry->name          = name;
+        geometry->index_offset  = index_offset;
+        geometry->index_count   = index_count;
+        geometry->vertex_offset = vertex_offset;
+        geometry->vertex_count  = vertex_count;
+        geometry->mesh          = mesh;
+        geometry->bounding_box  = bounding_box;
+
+        m_geometry = move(geometry);
     }
 
     void Renderable::SetGeometry(const DefaultGeometry type)
     {
-        m_geometry_type = type;
+        if (type == DefaultGeometry::Undefined)
+        {
+            // Keep drawing the same thing, but don't treat it as default geometry anymore
+            if (m_geometry->type != DefaultGeometry::Undefined)
+            {
+                shared_ptr<RenderableGeometry> geometry = make_shared<RenderableGeometry>(*m_geometry);
+                geometry->type = type;
+                m_geometry     = move(geometry);
+            }
 
-        if (type != DefaultGeometry::Undefined)
+            return;
+        }
+
+        if (shared_ptr<const RenderableGeometry> geometry = build(type))
         {
-            build(type, this);
+            m_geometry = move(geometry);
         }
     }
 
+    void Renderable::SetGeometry(const shared_ptr<const RenderableGeometry>& geometry)
+    {
+        m_geometry = geometry ? geometry : geometry_empty;
+    }
+
     void Renderable::Clear()
     {
         SetGeometry("Cleared", 0, 0, 0, 0, BoundingBox(), nullptr);
@@ -196,8 +227,8 @@ namespace Spartan
 
     void Renderable::GetGeometry(vector<uint32_t>* indices, vector<RHI_Vertex_PosTexNorTan>* vertices) const
     {
-        SP_ASSERT_MSG(m_mesh != nullptr, "Invalid mesh");
-        m_mesh->GetGeometry(m_geometry_index_offset, m_geometry_index_count, m_geometry_vertex_offset, m_geometry_vertex_count, indices, vertices);
+        SP_ASSERT_MSG(m_geometry->mesh != nullptr, "Invalid mesh");
+        m_geometry->mesh->GetGeometry(m_geometry->index_offset, m_geometry->index_count, m_geometry->vertex_offset, m_geometry->vertex_count, indices, vertices);
     }
 
     const BoundingBox& Renderable::GetAabb()
@@ -205,7 +236,7 @@ namespace Spartan
         // Updated if dirty
         if (m_last_transform != GetTransform()->GetMatrix() || !m_aabb.Defined())
         {
-            m_aabb = m_bounding_box.Transform(GetTransform()->GetMatrix());
+            m_aabb = m_geometry->bounding_box.Transform(GetTransform()->GetMatrix());
             m_last_transform = GetTransform()->GetMatrix();
         }
 
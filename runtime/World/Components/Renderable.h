@@ -30,7 +30,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-    class Mesh;
     class Mesh;
     class Light;
     class Material;
@@ -49,6 +48,21 @@ namespace Spartan
         Cone
     };
 
+    // The part of a mesh which a renderable draws. It never changes once created, so any number of
+    // renderables (e.g. the instances of a prefab) can share it, setting new geometry replaces it.
+    struct RenderableGeometry
+    {
+        std::string name;
+        uint32_t index_offset  = 0;
+        uint32_t index_count   = 0;
+        uint32_t vertex_offset = 0;
+        uint32_t vertex_count  = 0;
+        DefaultGeometry type   = DefaultGeometry::Undefined;
+        Mesh* mesh             = nullptr;
+        std::shared_ptr<Mesh> mesh_owned; // Default geometry isn't cached, so it owns its mesh
+        Math::BoundingBox bounding_box;
+    };
+
     class SP_CLASS Renderable : public IComponent
     {
     public:
@@ -74,15 +88,19 @@ namespace Spartan
         // Get geometry
         void GetGeometry(std::vector<uint32_t>* indices, std::vector<RHI_Vertex_PosTexNorTan>* vertices) const;
 
+        // Shares the geometry of another renderable
+        void SetGeometry(const std::shared_ptr<const RenderableGeometry>& geometry);
+
         // Properties
-        uint32_t GetIndexOffset()                 const { return m_geometry_index_offset; }
-        uint32_t GetIndexCount()                  const { return m_geometry_index_count; }
-        uint32_t GetVertexOffset()                const { return m_geometry_vertex_offset; }
-        uint32_t GetVertexCount()                 const { return m_geometry_vertex_count; }
-        DefaultGeometry GetGeometryType()         const { return m_geometry_type; }
-        const std::string& GetGeometryName()      const { return m_geometry_name; }
-        Mesh* GetMesh()                           const { return m_mesh; }
-        const Math::BoundingBox& GetBoundingBox() const { return m_bounding_box; }
+        uint32_t GetIndexOffset()                 const { return m_geometry->index_offset; }
+        uint32_t GetIndexCount()                  const { return m_geometry->index_count; }
+        uint32_t GetVertexOffset()                const { return m_geometry->vertex_offset; }
+        uint32_t GetVertexCount()                 const { return m_geometry->vertex_count; }
+        DefaultGeometry GetGeometryType()         const { return m_geometry->type; }
+        const std::string& GetGeometryName()      const { return m_geometry->name; }
+        Mesh* GetMesh()                           const { return m_geometry->mesh; }
+        const Math::BoundingBox& GetBoundingBox() const { return m_geometry->bounding_box; }
+        const auto& GetGeometryShared()           const { return m_geometry; }
         const Math::BoundingBox& GetAabb();
         void Clear();
 
@@ -104,18 +122,11 @@ namespace Spartan
         auto GetCastShadows() const                  { return m_cast_shadows; }
 
     private:
-        uint32_t m_geometry_index_offset  = 0;
-        uint32_t m_geometry_index_count   = 0;
-        uint32_t m_geometry_vertex_offset = 0;
-        uint32_t m_geometry_vertex_count  = 0;
-        DefaultGeometry m_geometry_type   = DefaultGeometry::Undefined;
-        Math::Matrix m_last_transform     = Math::Matrix::Identity;
-        bool m_cast_shadows               = true;
-        bool m_material_default           = false;
-        Mesh* m_mesh                      = nullptr;
-        Material* m_material              = nullptr;
-        Math::BoundingBox m_bounding_box;
+        Math::Matrix m_last_transform = Math::Matrix::Identity;
+        bool m_cast_shadows           = true;
+        bool m_material_default       = false;
+        Material* m_material          = nullptr;
+        std::shared_ptr<const RenderableGeometry> m_geometry;
         Math::BoundingBox m_aabb;
-        std::string m_geometry_name;
     };
 }
@@ -59,7 +59,7 @@ namespace Spartan
 
     void SoftBody::OnRemove()
     {
-
+        Body_Release();
     }
 
     void SoftBody::OnStart()
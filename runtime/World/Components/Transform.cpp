@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Transform.h"
 #include "../World.h"
 #include "../Entity.h"
+#include "../TransformHierarchy.h"
 #include "../../IO/FileStream.h"
 //==============================
 
@@ -50,19 +51,27 @@ namespace Spartan
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_scale_local,    Vector3);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_matrix,         Matrix);
         SP_REGISTER_ATTRIBUTE_VALUE_VALUE(m_matrix_local,   Matrix);
+
+        TransformHierarchy::MarkStructureDirty();
+    }
+
+    Transform::~Transform()
+    {
+        TransformHierarchy::MarkStructureDirty();
     }
 
     void Transform::OnInitialize()
     {
-        m_is_dirty = true;
+        MakeDirty();
     }
 
-    void Transform::OnTick()
+    void Transform::OnHierarchyResolved(const Matrix& matrix_local, const Matrix& matrix, const bool frame_end)
     {
-        if (!m_is_dirty)
-            return;
+        m_matrix_local = matrix_local;
+        m_matrix       = matrix;
 
-        UpdateTransform();
+        if (!m_is_dirty || !frame_end)
+            return;
 
         m_is_dirty                    = false;
         m_position_changed_this_frame = false;
@@ -117,11 +126,14 @@ namespace Spartan
             m_matrix = m_matrix_local;
         }
 
-        // Update children
-        for (Transform* child : m_children)
-        {
-            child->UpdateTransform();
-        }
+        // The children are resolved by the TransformHierarchy, in one go, at the end of the world tick
+        MakeDirty();
+    }
+
+    void Transform::MakeDirty()
+    {
+        m_is_dirty = true;
+        TransformHierarchy::MarkDirty();
     }
 
     void Transform::SetPosition(const Vector3& position)
@@ -313,8 +325,10 @@ namespace Spartan
         }
 
         // Assign the new parent.
-        m_parent   = new_parent;
-        m_is_dirty = true;
+        m_parent = new_parent;
+        MakeDirty();
+
+        TransformHierarchy::MarkStructureDirty();
     }
 
     void Transform::AddChild(Transform* child)
@@ -355,11 +369,13 @@ namespace Spartan
         // Mark as dirty if the parent is about to really change.
         if ((m_parent && !new_parent) || (!m_parent && new_parent))
         {
-            m_is_dirty = true;
+            MakeDirty();
         }
 
         // Assign the new parent.
         m_parent = new_parent;
+
+        TransformHierarchy::MarkStructureDirty();
     }
 
     void Transform::AddChild_Internal(Transform* child)
@@ -376,6 +392,7 @@ namespace Spartan
         if (!(find(m_children.begin(), m_children.end(), child) != m_children.end()))
         {
             m_children.emplace_back(child);
+            TransformHierarchy::MarkStructureDirty();
         }
     }
 
@@ -391,36 +408,26 @@ namespace Spartan
 
         // Remove the child
         m_children.erase(remove_if(m_children.begin(), m_children.end(), [child](Transform* vec_transform) { return vec_transform->GetObjectId() == child->GetObjectId(); }), m_children.end());
+
+        TransformHierarchy::MarkStructureDirty();
     }
 
-    // Searches the entire hierarchy, finds any children and saves them in m_children.
-    // This is a recursive function, the children will also find their own children and so on...
+    // Rebuilds m_children with a single pass over the world's entities, the children keep
+    // their own lists (if the whole hierarchy needs rebuilding, World does that in one pass)
     void Transform::AcquireChildren()
     {
         m_children.clear();
-        m_children.shrink_to_fit();
+        TransformHierarchy::MarkStructureDirty();
 
-        auto entities = World::GetAllEntities();
-        for (const auto& entity : entities)
+        for (const shared_ptr<Entity>& entity : World::GetAllEntities())
         {
             if (!entity)
                 continue;
 
-            // get the possible child
-            auto possible_child = entity->GetTransform();
-
-            // if it doesn't have a parent, forget about it.
-            if (!possible_child->HasParent())
-                continue;
-
-            // if it's parent matches this transform
-            if (possible_child->GetParent()->GetObjectId() == GetObjectId())
+            Transform* possible_child = entity->GetTransform();
+            if (possible_child->GetParent() == this)
             {
-                // welcome home son
                 m_children.emplace_back(possible_child);
-
-                // make the child do the same thing all over, essentially resolving the entire hierarchy.
-                possible_child->AcquireChildren();
             }
         }
     }
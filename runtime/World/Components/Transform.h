@@ -38,11 +38,10 @@ namespace Spartan
     {
     public:
         Transform(Entity* entity, uint64_t id = 0);
-        ~Transform() = default;
+        ~Transform();
 
         //= ICOMPONENT ===============================
         void OnInitialize() override;
-        void OnTick() override;
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -105,9 +104,14 @@ namespace Spartan
         Transform* GetRoot()                         { return HasParent() ? GetParent()->GetRoot() : this; }
         Transform* GetParent()                 const { return m_parent; }
         std::vector<Transform*>& GetChildren()       { return m_children; }
-        void MakeDirty()                             { m_is_dirty = true; }
+        void MakeDirty();
+        bool IsDirty()                         const { return m_is_dirty; }
         //==================================================================================================
 
+        // Called by the TransformHierarchy once it has resolved the matrices of this transform, the transform
+        // stops being dirty (and its changed-this-frame flags are updated) only at the end of the frame
+        void OnHierarchyResolved(const Math::Matrix& matrix_local, const Math::Matrix& matrix, const bool frame_end);
+
         const Math::Matrix& GetMatrix()                    const { return m_matrix; }
         const Math::Matrix& GetLocalMatrix()               const { return m_matrix_local; }
         const Math::Matrix& GetMatrixPrevious()            const { return m_matrix_previous; }
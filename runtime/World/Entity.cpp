@@ -57,11 +57,35 @@ namespace Spartan
 
     Entity::~Entity()
     {
-        m_components.fill(nullptr);
+        ComponentStore::RemoveAll(this);
+        for (shared_ptr<IComponent>& component : m_components)
+        {
+            ComponentStore::Release(component);
+        }
         m_renderable = nullptr;
         m_transform  = nullptr;
     }
 
+    void Entity::SetName(const string& name)
+    {
+        if (name == m_name)
+            return;
+
+        const string name_previous = m_name;
+        m_name = name;
+        World::_EntityNameChanged(this, name_previous);
+    }
+
+    void Entity::SetObjectId(const uint64_t id)
+    {
+        if (id == m_object_id)
+            return;
+
+        const uint64_t id_previous = m_object_id;
+        Object::SetObjectId(id);
+        World::_EntityIdChanged(this, id_previous);
+    }
+
     void Entity::Clone()
     {
         vector<Entity*> clones;
@@ -135,20 +159,6 @@ namespace Spartan
     void Entity::OnPreTick()
     {
 
-    }
-
-	void Entity::Tick()
-    {
-        if (!m_is_active)
-            return;
-
-        for (shared_ptr<IComponent> component : m_components)
-        {
-            if (component)
-            {
-                component->OnTick();
-            }
-        }
     }
 
     void Entity::Serialize(FileStream* stream)
@@ -215,8 +225,8 @@ namespace Spartan
         {
             stream->Read(&m_is_active);
             stream->Read(&m_hierarchy_visibility);
-            stream->Read(&m_object_id);
-            stream->Read(&m_name);
+            SetObjectId(stream->ReadAs<uint64_t>());
+            SetName(stream->ReadAs<string>());
         }
 
         // COMPONENTS
@@ -227,7 +237,7 @@ namespace Spartan
                 uint32_t component_type = static_cast<uint32_t>(ComponentType::Undefined);
                 stream->Read(&component_type);
 
-                if (component_type == static_cast<uint32_t>(ComponentType::Undefined))
+                if (component_type != static_cast<uint32_t>(ComponentType::Undefined))
                 {
                     // Id
                     uint64_t component_id = 0;
@@ -271,20 +281,15 @@ namespace Spartan
                 children.emplace_back(child);
             }
 
-            // Children
+            // Children, they attach themselves to this transform as they deserialize
             for (const auto& child : children)
             {
                 child.lock()->Deserialize(stream, GetTransform());
             }
-
-            if (m_transform)
-            {
-                m_transform->AcquireChildren();
-            }
         }
 
         // Make the scene resolve
-        SP_FIRE_EVENT(EventType::WorldResolve);
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
     }
 
     bool Entity::IsActiveRecursively()
@@ -337,13 +342,14 @@ namespace Spartan
                 if (id == component->GetObjectId())
                 {
                     component->OnRemove();
-                    component = nullptr;
+                    ComponentStore::Remove(component.get());
+                    ComponentStore::Release(component);
                     break;
                 }
             }
         }
 
         // Make the scene resolve
-        SP_FIRE_EVENT(EventType::WorldResolve);
+        SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
     }
 }
@@ -24,7 +24,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <vector>
 #include "../Core/Event.h"
+#include "../Core/Handle.h"
+#include "../Core/PoolAllocator.h"
 #include "Components/IComponent.h"
+#include "ComponentStore.h"
 //================================
 
 namespace Spartan
@@ -49,8 +52,9 @@ namespace Spartan
         // Runs every frame, before any subsystem or entity ticks.
         void OnPreTick();
 
-        // Runs every frame.
-        void Tick();
+        // Name and id, these keep the world's lookup tables in sync, even when called through an Object
+        void SetName(const std::string& name) override;
+        void SetObjectId(uint64_t id) override;
 
         void Serialize(FileStream* stream);
         void Deserialize(FileStream* stream, Transform* parent);
@@ -76,8 +80,8 @@ namespace Spartan
                 return component;
             }
 
-            // Create a new component
-            std::shared_ptr<T> component = std::make_shared<T>(this, id);
+            // Create a new component, every component type has a pool
+            std::shared_ptr<T> component = std::allocate_shared<T>(PoolAllocator<T>(), this, id);
 
             // Save new component
             m_components[static_cast<uint32_t>(type)] = std::static_pointer_cast<IComponent>(component);
@@ -88,10 +92,11 @@ namespace Spartan
 
             // Initialize component
             component->SetType(type);
+            ComponentStore::Add(component.get());
             component->OnInitialize();
 
             // Make the scene resolve
-            SP_FIRE_EVENT(EventType::WorldResolve);
+            SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
 
             return component.get();
         }
@@ -112,9 +117,13 @@ namespace Spartan
         void RemoveComponent()
         {
             const ComponentType component_type = IComponent::TypeToEnum<T>();
-            m_components[static_cast<uint32_t>(component_type)] = nullptr;
+            if (IComponent* component = m_components[static_cast<uint32_t>(component_type)].get())
+            {
+                ComponentStore::Remove(component);
+            }
+            ComponentStore::Release(m_components[static_cast<uint32_t>(component_type)]);
 
-            SP_FIRE_EVENT(EventType::WorldResolve);
+            SP_FIRE_EVENT_DATA(EventType::WorldResolve, this);
         }
 
         void RemoveComponentById(uint64_t id);
@@ -125,11 +134,19 @@ namespace Spartan
         Renderable* GetRenderable() const      { return m_renderable; }
         std::shared_ptr<Entity> GetPtrShared() { return shared_from_this(); }
 
+        // Compact reference, assigned by the world while the entity is part of it
+        Handle<Entity> GetHandle() const            { return m_handle; }
+        void SetHandle(const Handle<Entity> handle) { m_handle = handle; }
+
     private:
+        friend class ComponentStore;
+
         std::atomic<bool> m_is_active = true;
         bool m_hierarchy_visibility   = true;
         Transform* m_transform        = nullptr;
         Renderable* m_renderable      = nullptr;
         std::array<std::shared_ptr<IComponent>, 14> m_components;
+        Handle<Entity> m_handle;
+        uint32_t m_store_slot = 0xFFFFFFFF; // index in the sparse arrays of the component store
     };
 }
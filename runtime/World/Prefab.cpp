@@ -0,0 +1,222 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "pch.h"
+#include "Prefab.h"
+#include "World.h"
+#include "Entity.h"
+#include "ComponentStore.h"
+#include "Components/Transform.h"
+#include "../IO/FileStream.h"
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    Prefab::Prefab() : IResource(ResourceType::Prefab)
+    {
+
+    }
+
+    bool Prefab::SaveToFile(const string& file_path)
+    {
+        SetResourceFilePath(file_path);
+
+        FileStream file(GetResourceFilePathNative(), FileStream_Write);
+        if (!file.IsOpen())
+            return false;
+
+        file.Write(static_cast<uint64_t>(m_data.size()));
+        file.WriteBytes(m_data.data(), m_data.size());
+
+        return true;
+    }
+
+    bool Prefab::LoadFromFile(const string& file_path)
+    {
+        FileStream file(file_path, FileStream_Read);
+        if (!file.IsOpen())
+            return false;
+
+        m_data.resize(file.ReadAs<uint64_t>());
+        file.ReadBytes(m_data.data(), m_data.size());
+
+        SetResourceFilePath(file_path);
+        Decode();
+
+        return !m_template.empty();
+    }
+
+    void Prefab::Capture(Entity* root)
+    {
+        SP_ASSERT_MSG(root != nullptr, "Entity is null");
+
+        FileStream stream(FileStream_Write);
+        stream.Write(root->GetObjectId());
+        root->Serialize(&stream);
+        m_data = stream.GetBuffer();
+
+        Decode();
+        SetDirty(true);
+    }
+
+    shared_ptr<Entity> Prefab::Instantiate(const Matrix& transform /*= Matrix::Identity*/)
+    {
+        vector<shared_ptr<Entity>> instances;
+        Instantiate(vector<Matrix>{ transform }, &instances);
+
+        return instances.empty() ? nullptr : instances.front();
+    }
+
+    void Prefab::Instantiate(const vector<Matrix>& transforms, vector<shared_ptr<Entity>>* instances /*= nullptr*/)
+    {
+        if (m_template.empty() || transforms.empty())
+            return;
+
+        const Stopwatch timer;
+        const uint32_t entity_count = static_cast<uint32_t>(m_template.size());
+
+        // Build everything outside of the world, so that it joins (and gets announced) in one go
+        vector<shared_ptr<Entity>> entities;
+        entities.reserve(transforms.size() * entity_count);
+        {
+            World::_SetCreationTarget(&entities);
+            ComponentStore::SetDeferred(true);
+
+            for (const Matrix& transform : transforms)
+            {
+                Instantiate(transform, entities);
+            }
+
+            ComponentStore::SetDeferred(false);
+            World::_SetCreationTarget(nullptr);
+        }
+
+        World::_AddEntities(entities);
+
+        if (instances)
+        {
+            instances->reserve(instances->size() + transforms.size());
+            for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i += entity_count)
+            {
+                instances->emplace_back(entities[i]);
+            }
+        }
+
+        SP_LOG_INFO("Instantiated \"%s\" %d times (%d entities) in %.2f ms", GetResourceName().c_str(), static_cast<uint32_t>(transforms.size()), static_cast<uint32_t>(entities.size()), timer.GetElapsedTimeMs());
+    }
+
+    void Prefab::Decode()
+    {
+        m_template.clear();
+        m_template_parents.clear();
+
+        if (m_data.empty())
+            return;
+
+        // The template is built like a streamed cell, outside of the world, and it never joins it
+        World::_SetCreationTarget(&m_template);
+        ComponentStore::SetDeferred(true);
+        {
+            FileStream stream(FileStream_Read, string(m_data));
+
+            shared_ptr<Entity> root = World::CreateEntity();
+            root->SetObjectId(stream.ReadAs<uint64_t>());
+            root->Deserialize(&stream, nullptr);
+        }
+        ComponentStore::SetDeferred(false);
+        World::_SetCreationTarget(nullptr);
+
+        // The template only provides attributes, but its components registered with their subsystems as they were
+        // added and deserialized (e.g. a rigid body joined the physics world), so they are removed from them again
+        for (const shared_ptr<Entity>& entity : m_template)
+        {
+            for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+            {
+                if (component)
+                {
+                    component->OnRemove();
+                }
+            }
+        }
+
+        // Entities are created before their children, so a parent always has a lower index
+        unordered_map<Transform*, int32_t> indices;
+        m_template_parents.reserve(m_template.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_template.size()); i++)
+        {
+            Transform* transform = m_template[i]->GetTransform();
+            indices[transform]   = static_cast<int32_t>(i);
+
+            auto it = indices.find(transform->GetParent());
+            m_template_parents.emplace_back(it != indices.end() ? it->second : -1);
+        }
+    }
+
+    void Prefab::Instantiate(const Matrix& transform, vector<shared_ptr<Entity>>& entities)
+    {
+        // The caller has set entities as the creation target, so each created entity is appended to it
+        const uint32_t first = static_cast<uint32_t>(entities.size());
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_template.size()); i++)
+        {
+            Entity* source            = m_template[i].get();
+            shared_ptr<Entity> entity = World::CreateEntity();
+
+            entity->SetName(source->GetName());
+            entity->SetActive(source->IsActive());
+            entity->SetHierarchyVisibility(source->IsVisibleInHierarchy());
+
+            // Copying the attributes shares whatever is immutable, e.g. a renderable's geometry
+            for (const shared_ptr<IComponent>& component : source->GetAllComponents())
+            {
+                if (component)
+                {
+                    entity->AddComponent(component->GetType())->SetAttributes(component->GetAttributes());
+                }
+            }
+
+            if (m_template_parents[i] != -1)
+            {
+                entity->GetTransform()->SetParent(entities[first + m_template_parents[i]]->GetTransform());
+            }
+        }
+
+        // Place the root
+        if (transform != Matrix::Identity)
+        {
+            Vector3 scale;
+            Quaternion rotation;
+            Vector3 position;
+            (m_template[0]->GetTransform()->GetLocalMatrix() * transform).Decompose(scale, rotation, position);
+
+            Transform* root = entities[first]->GetTransform();
+            root->SetPositionLocal(position);
+            root->SetRotationLocal(rotation);
+            root->SetScaleLocal(scale);
+        }
+    }
+}
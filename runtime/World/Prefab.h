@@ -0,0 +1,67 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include "../Resource/IResource.h"
+#include "../Math/Matrix.h"
+//=================================
+
+namespace Spartan
+{
+    class Entity;
+
+    // An entity hierarchy which can be instantiated any number of times. The prefab decodes its hierarchy once, into
+    // template entities which never join the world, and instances are built from them. Whatever is immutable (geometry,
+    // materials) is shared with the template, so an instance only holds its own transform and whatever it changes later.
+    // Template components are detached from their subsystems (OnRemove()), so e.g. a template rigid body isn't simulated.
+    class SP_CLASS Prefab : public IResource
+    {
+    public:
+        Prefab();
+        ~Prefab() = default;
+
+        // IResource
+        bool SaveToFile(const std::string& file_path) override;
+        bool LoadFromFile(const std::string& file_path) override;
+
+        // Captures an entity and its descendants, as they are at the time of the call
+        void Capture(Entity* root);
+
+        // Creates an instance in the world, the transform is applied to the root
+        std::shared_ptr<Entity> Instantiate(const Math::Matrix& transform = Math::Matrix::Identity);
+
+        // Creates an instance per transform, they all join the world at once
+        void Instantiate(const std::vector<Math::Matrix>& transforms, std::vector<std::shared_ptr<Entity>>* instances = nullptr);
+
+        uint32_t GetEntityCount() const { return static_cast<uint32_t>(m_template.size()); }
+
+    private:
+        void Decode();
+        void Instantiate(const Math::Matrix& transform, std::vector<std::shared_ptr<Entity>>& instance);
+
+        std::string m_data;                              // The hierarchy, encoded the way it's saved
+        std::vector<std::shared_ptr<Entity>> m_template; // The hierarchy, decoded, parents come before their children
+        std::vector<int32_t> m_template_parents;         // The index of the parent of each template entity, -1 for the root
+    };
+}
@@ -0,0 +1,200 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "pch.h"
+#include "SystemScheduler.h"
+#include "../Core/ThreadPool.h"
+#include "../Profiling/Profiler.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        struct System
+        {
+            string name;
+            uint32_t reads   = SystemResource_None;
+            uint32_t writes  = SystemResource_None;
+            function<void()> execute;
+            bool main_thread = false;
+            float duration   = 0.0f; // ms, last frame
+        };
+
+        static vector<System> m_systems;
+        static vector<vector<uint32_t>> m_waves; // system indices
+        static vector<string> m_wave_names;      // time block names, they have to outlive the frame
+        static bool m_waves_dirty = true;
+
+        static bool conflict(const System& a, const System& b)
+        {
+            return (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+        }
+
+        static void build_waves()
+        {
+            m_waves.clear();
+            m_wave_names.clear();
+
+            vector<uint32_t> system_wave(m_systems.size(), 0);
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_systems.size()); i++)
+            {
+                // Go after every earlier system this one conflicts with
+                uint32_t wave = 0;
+                for (uint32_t j = 0; j < i; j++)
+                {
+                    if (conflict(m_systems[i], m_systems[j]))
+                    {
+                        wave = max(wave, system_wave[j] + 1);
+                    }
+                }
+
+                system_wave[i] = wave;
+                if (wave >= m_waves.size())
+                {
+                    m_waves.resize(wave + 1);
+                }
+                m_waves[wave].emplace_back(i);
+            }
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_waves.size()); i++)
+            {
+                m_wave_names.emplace_back("systems_wave_" + to_string(i));
+            }
+
+            m_waves_dirty = false;
+        }
+
+        static void run(System& system)
+        {
+            const Stopwatch stopwatch;
+            system.execute();
+            system.duration = stopwatch.GetElapsedTimeMs();
+        }
+    }
+
+    void SystemScheduler::AddSystem(const char* name, const uint32_t reads, const uint32_t writes, function<void()>&& execute, const bool main_thread /*= false*/)
+    {
+        System& system     = m_systems.emplace_back();
+        system.name        = name;
+        system.reads       = reads;
+        system.writes      = writes;
+        system.execute     = move(execute);
+        system.main_thread = main_thread;
+
+        m_waves_dirty = true;
+    }
+
+    void SystemScheduler::ClearSystems()
+    {
+        m_systems.clear();
+        m_waves_dirty = true;
+    }
+
+    void SystemScheduler::Tick()
+    {
+        if (m_waves_dirty)
+        {
+            build_waves();
+        }
+
+        for (uint32_t wave_index = 0; wave_index < static_cast<uint32_t>(m_waves.size()); wave_index++)
+        {
+            const vector<uint32_t>& wave = m_waves[wave_index];
+
+            SP_PROFILE_SECTION_START(m_wave_names[wave_index].c_str());
+
+            // Hand the systems which can run anywhere to the thread pool (a lone system is not worth the hand-off)
+            const bool parallel      = wave.size() > 1 && ThreadPool::GetIdleThreadCount() > 0;
+            atomic<uint32_t> pending = 0;
+            if (parallel)
+            {
+                for (const uint32_t index : wave)
+                {
+                    if (m_systems[index].main_thread)
+                        continue;
+
+                    ThreadPool::AddTask([index]()
+                    {
+                        run(m_systems[index]);
+                    }, pending);
+                }
+            }
+
+            // Run the rest here
+            for (const uint32_t index : wave)
+            {
+                if (!parallel || m_systems[index].main_thread)
+                {
+                    run(m_systems[index]);
+                }
+            }
+
+            ThreadPool::Wait(pending);
+
+            SP_PROFILE_SECTION_END();
+        }
+    }
+
+    string SystemScheduler::GetSchedule()
+    {
+        if (m_waves_dirty)
+        {
+            build_waves();
+        }
+
+        static const array<const char*, 8> resource_names = { "transform", "camera", "light", "reflection_probe", "input", "physics", "audio", "rhi" };
+        auto resources_to_string = [](const uint32_t resources)
+        {
+            string str;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(resource_names.size()); i++)
+            {
+                if (resources & (1 << i))
+                {
+                    str += str.empty() ? resource_names[i] : string(", ") + resource_names[i];
+                }
+            }
+
+            return str.empty() ? string("-") : str;
+        };
+
+        stringstream ss;
+        ss << fixed << setprecision(3);
+        for (uint32_t wave_index = 0; wave_index < static_cast<uint32_t>(m_waves.size()); wave_index++)
+        {
+            ss << "Wave " << wave_index << "\n";
+            for (const uint32_t index : m_waves[wave_index])
+            {
+                const System& system = m_systems[index];
+                ss << "    " << system.name << ": " << system.duration << " ms" << (system.main_thread ? " (main thread)" : "") << "\n";
+                ss << "        reads:  " << resources_to_string(system.reads)  << "\n";
+                ss << "        writes: " << resources_to_string(system.writes) << "\n";
+            }
+        }
+
+        return ss.str();
+    }
+}
@@ -0,0 +1,59 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+#include <functional>
+#include <string>
+//======================
+
+namespace Spartan
+{
+    // What a system touches, two systems conflict if either of them writes something the other one reads or writes
+    enum SystemResource : uint32_t
+    {
+        SystemResource_None            = 0,
+        SystemResource_Transform       = 1 << 0,
+        SystemResource_Camera          = 1 << 1,
+        SystemResource_Light           = 1 << 2,
+        SystemResource_ReflectionProbe = 1 << 3,
+        SystemResource_Input           = 1 << 4,
+        SystemResource_Physics         = 1 << 5,
+        SystemResource_Audio           = 1 << 6,
+        SystemResource_Rhi             = 1 << 7  // resource creation
+    };
+
+    // Runs systems which declare what they read and write. Every frame, systems are executed in waves,
+    // a system goes into the first wave after all the systems it conflicts with (and which were added before it).
+    // Systems within a wave run concurrently on the thread pool.
+    class SP_CLASS SystemScheduler
+    {
+    public:
+        static void AddSystem(const char* name, const uint32_t reads, const uint32_t writes, std::function<void()>&& execute, const bool main_thread = false);
+        static void ClearSystems();
+        static void Tick();
+
+        // Human readable schedule, along with the last frame's timings
+        static std::string GetSchedule();
+    };
+}
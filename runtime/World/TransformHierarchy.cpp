@@ -0,0 +1,217 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "pch.h"
+#include "TransformHierarchy.h"
+#include "Entity.h"
+#include "Components/Transform.h"
+#include "../Core/ThreadPool.h"
+#include "../Math/Simd.h"
+#include "../Profiling/Profiler.h"
+//===============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    namespace
+    {
+        // Structure of arrays, sorted by depth, every transform is at a higher index than its parent
+        static vector<Transform*> m_transforms;
+        static vector<int32_t> m_parents;       // index of the parent, -1 for roots
+        static vector<Matrix> m_matrices_local;
+        static vector<Matrix> m_matrices;       // world
+        static vector<uint8_t> m_dirty;
+        static vector<uint32_t> m_level_offsets; // level n spans [m_level_offsets[n], m_level_offsets[n + 1])
+        static atomic<bool> m_structure_dirty = true;
+        static atomic<bool> m_dirty_any       = true;
+        static size_t m_entity_count          = 0;
+
+        // Levels smaller than this are not worth the cost of waking up the thread pool
+        static const uint32_t parallel_threshold = 1024;
+
+        static void rebuild(const vector<shared_ptr<Entity>>& entities)
+        {
+            m_transforms.clear();
+            m_parents.clear();
+            m_level_offsets.clear();
+
+            // Level 0 - roots
+            for (const shared_ptr<Entity>& entity : entities)
+            {
+                if (Transform* transform = entity ? entity->GetTransform() : nullptr)
+                {
+                    if (!transform->HasParent())
+                    {
+                        m_transforms.emplace_back(transform);
+                        m_parents.emplace_back(-1);
+                    }
+                }
+            }
+
+            // Every subsequent level - the children of the previous level
+            uint32_t level_start = 0;
+            while (level_start < static_cast<uint32_t>(m_transforms.size()))
+            {
+                const uint32_t level_end = static_cast<uint32_t>(m_transforms.size());
+                m_level_offsets.emplace_back(level_start);
+
+                for (uint32_t i = level_start; i < level_end; i++)
+                {
+                    for (Transform* child : m_transforms[i]->GetChildren())
+                    {
+                        m_transforms.emplace_back(child);
+                        m_parents.emplace_back(static_cast<int32_t>(i));
+                    }
+                }
+
+                level_start = level_end;
+            }
+            m_level_offsets.emplace_back(static_cast<uint32_t>(m_transforms.size()));
+
+            // Everything gets resolved after a structural change
+            m_matrices_local.resize(m_transforms.size());
+            m_matrices.resize(m_transforms.size());
+            m_dirty.assign(m_transforms.size(), 1);
+            m_entity_count = entities.size();
+        }
+
+        static void resolve_range(const uint32_t start, const uint32_t end, const bool frame_end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                if (!m_dirty[i])
+                    continue;
+
+                Transform* transform = m_transforms[i];
+                m_matrices_local[i]  = Matrix(transform->GetPositionLocal(), transform->GetRotationLocal(), transform->GetScaleLocal());
+
+                const int32_t parent = m_parents[i];
+                if (parent != -1)
+                {
+                    m_matrices[i] = Simd::MatrixMultiply(m_matrices_local[i], m_matrices[parent]);
+                }
+                else
+                {
+                    m_matrices[i] = m_matrices_local[i];
+                }
+
+                transform->OnHierarchyResolved(m_matrices_local[i], m_matrices[i], frame_end);
+            }
+        }
+
+        static void resolve(const vector<shared_ptr<Entity>>& entities, const bool frame_end)
+        {
+            const bool structure_changed = m_structure_dirty.exchange(false) || m_entity_count != entities.size();
+            if (!structure_changed && !m_dirty_any)
+                return;
+
+            // Mid-frame, the transforms stay dirty until the end of the frame, so the flag has to stay up as well
+            if (frame_end)
+            {
+                m_dirty_any = false;
+            }
+
+            if (structure_changed)
+            {
+                rebuild(entities);
+            }
+
+            // Propagate dirty flags, parents precede their children so a single pass is enough
+            const uint32_t transform_count = static_cast<uint32_t>(m_transforms.size());
+            for (uint32_t i = 0; i < transform_count; i++)
+            {
+                const int32_t parent = m_parents[i];
+                m_dirty[i]           = m_dirty[i] | static_cast<uint8_t>(m_transforms[i]->IsDirty()) | (parent != -1 ? m_dirty[parent] : 0);
+            }
+
+            // Resolve level by level, transforms within a level only depend on the previous one
+            for (uint32_t level = 0; level + 1 < static_cast<uint32_t>(m_level_offsets.size()); level++)
+            {
+                const uint32_t start = m_level_offsets[level];
+                const uint32_t count = m_level_offsets[level + 1] - start;
+
+                if (count >= parallel_threshold && ThreadPool::GetIdleThreadCount() > 0)
+                {
+                    ThreadPool::ParallelLoop([start, frame_end](uint32_t work_index_start, uint32_t work_index_end)
+                    {
+                        resolve_range(start + work_index_start, start + work_index_end, frame_end);
+                    }, count);
+                }
+                else
+                {
+                    resolve_range(start, start + count, frame_end);
+                }
+            }
+
+            fill(m_dirty.begin(), m_dirty.end(), static_cast<uint8_t>(0));
+        }
+    }
+
+    void TransformHierarchy::Tick(const vector<shared_ptr<Entity>>& entities)
+    {
+        SP_PROFILE_FUNCTION();
+        resolve(entities, true);
+    }
+
+    void TransformHierarchy::Resolve(const vector<shared_ptr<Entity>>& entities)
+    {
+        SP_PROFILE_FUNCTION();
+        resolve(entities, false);
+    }
+
+    void TransformHierarchy::Clear()
+    {
+        m_transforms.clear();
+        m_parents.clear();
+        m_matrices_local.clear();
+        m_matrices.clear();
+        m_dirty.clear();
+        m_level_offsets.clear();
+        m_entity_count    = 0;
+        m_structure_dirty = true;
+        m_dirty_any       = true;
+    }
+
+    void TransformHierarchy::MarkStructureDirty()
+    {
+        m_structure_dirty = true;
+    }
+
+    void TransformHierarchy::MarkDirty()
+    {
+        m_dirty_any = true;
+    }
+
+    uint32_t TransformHierarchy::GetTransformCount()
+    {
+        return static_cast<uint32_t>(m_transforms.size());
+    }
+
+    uint32_t TransformHierarchy::GetLevelCount()
+    {
+        return m_level_offsets.empty() ? 0 : static_cast<uint32_t>(m_level_offsets.size()) - 1;
+    }
+}
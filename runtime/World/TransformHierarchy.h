@@ -0,0 +1,58 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+#include <vector>
+#include <memory>
+//======================
+
+namespace Spartan
+{
+    class Entity;
+
+    // Resolves world matrices for the entire world, instead of every transform recursively updating its children.
+    // Transforms are packed into flat arrays (structure of arrays), sorted by their depth in the hierarchy, so a parent
+    // always precedes its children. Dirty flags are then propagated in a single pass and every level is resolved in parallel.
+    class SP_CLASS TransformHierarchy
+    {
+    public:
+        // Resolves the dirty transforms and ends their frame, called once the world is done moving things
+        static void Tick(const std::vector<std::shared_ptr<Entity>>& entities);
+
+        // Resolves the dirty transforms mid-frame, so that whatever runs next sees the world matrices of the descendants
+        // of anything that moved so far (their changed-this-frame flags are kept until Tick)
+        static void Resolve(const std::vector<std::shared_ptr<Entity>>& entities);
+
+        static void Clear();
+
+        // Has to be called whenever a transform is created, destroyed or re-parented
+        static void MarkStructureDirty();
+
+        // Has to be called whenever a transform changes, resolving is skipped entirely while nothing did
+        static void MarkDirty();
+
+        static uint32_t GetTransformCount();
+        static uint32_t GetLevelCount();
+    };
+}
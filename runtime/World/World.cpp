@@ -23,6 +23,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "pch.h"
 #include "World.h"
 #include "Entity.h"
+#include "TransformHierarchy.h"
+#include "ComponentStore.h"
+#include "SystemScheduler.h"
+#include "WorldStreaming.h"
 #include "Components/Transform.h"
 #include "Components/Camera.h"
 #include "Components/Light.h"
@@ -33,9 +37,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/RigidBody.h"
 #include "Components/Collider.h"
 #include "Components/Terrain.h"
+#include "../Core/ThreadPool.h"
+#include "../Core/EventBus.h"
 #include "../Resource/ResourceCache.h"
 #include "../IO/FileStream.h"
 #include "../Profiling/Profiler.h"
+#include "../Profiling/MemoryTracker.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../Rendering/Mesh.h"
 //====================================
@@ -51,6 +58,12 @@ namespace Spartan
     {
         static vector<shared_ptr<Entity>> m_queue_deletion;
         static vector<shared_ptr<Entity>> m_entities;
+        static unordered_map<uint64_t, shared_ptr<Entity>> m_entities_by_id;
+        static unordered_multimap<string, shared_ptr<Entity>> m_entities_by_name;
+        static mutex m_entity_index_mutex; // guards the lookup tables, entities can be created from multiple threads while loading
+        static thread_local vector<shared_ptr<Entity>>* m_creation_target = nullptr;
+        static HandlePool<Entity> m_entity_handles;
+
         static string m_name;
         static string m_file_path;
         static bool m_resolve                                   = false;
@@ -58,6 +71,111 @@ namespace Spartan
         static shared_ptr<Mesh> m_default_model_sponza          = nullptr;
         static shared_ptr<Mesh> m_default_model_sponza_curtains = nullptr;
         static shared_ptr<Mesh> m_default_model_car             = nullptr;
+        static array<vector<IComponent*>, static_cast<uint32_t>(ComponentType::Undefined)> m_tick_components;
+
+        // Entities which changed since the renderer last heard from the world, so it can patch instead of rebuild
+        static vector<Entity*> m_entities_changed;
+        static vector<shared_ptr<Entity>> m_entities_removed;
+        static mutex m_entities_changed_mutex;
+
+        static void on_resolve(const Variant& data)
+        {
+            // A change to a single entity is passed along as is, anything else resolves the whole world
+            if (holds_alternative<Entity*>(data.GetVariantRaw()))
+            {
+                // Entities which are built in the background are announced as a whole when they join the world
+                if (m_creation_target)
+                    return;
+
+                lock_guard lock(m_entities_changed_mutex);
+                m_entities_changed.emplace_back(data.Get<Entity*>());
+            }
+            else
+            {
+                m_resolve = true;
+            }
+        }
+
+        static void index_remove(Entity* entity)
+        {
+            m_entity_handles.Remove(entity->GetHandle());
+            entity->SetHandle(Handle<Entity>());
+
+            lock_guard lock(m_entity_index_mutex);
+
+            auto it_id = m_entities_by_id.find(entity->GetObjectId());
+            if (it_id != m_entities_by_id.end() && it_id->second.get() == entity)
+            {
+                m_entities_by_id.erase(it_id);
+            }
+
+            auto range = m_entities_by_name.equal_range(entity->GetName());
+            for (auto it = range.first; it != range.second; it++)
+            {
+                if (it->second.get() == entity)
+                {
+                    m_entities_by_name.erase(it);
+                    break;
+                }
+            }
+        }
+
+        // Rebuilds the children of every transform with a single pass over the entities
+        static void resolve_hierarchy()
+        {
+            for (shared_ptr<Entity>& entity : m_entities)
+            {
+                entity->GetTransform()->GetChildren().clear();
+            }
+
+            for (shared_ptr<Entity>& entity : m_entities)
+            {
+                Transform* transform = entity->GetTransform();
+                if (Transform* parent = transform->GetParent())
+                {
+                    parent->GetChildren().emplace_back(transform);
+                }
+            }
+
+            TransformHierarchy::MarkStructureDirty();
+        }
+
+        // Runs function(i) for every index, spreading the work across the thread pool (a few large roots are worth it too)
+        static void parallel_for(const uint32_t count, const function<void(uint32_t)>& function)
+        {
+            if (count > 1 && ThreadPool::GetIdleThreadCount() > 0)
+            {
+                ThreadPool::ParallelLoop([&function](uint32_t work_index_start, uint32_t work_index_end)
+                {
+                    for (uint32_t i = work_index_start; i < work_index_end; i++)
+                    {
+                        function(i);
+                    }
+                }, count);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    function(i);
+                }
+            }
+        }
+
+        static void add_component_system(const char* name, const ComponentType type, const uint32_t reads, const uint32_t writes, const bool main_thread = false)
+        {
+            SystemScheduler::AddSystem(name, reads, writes, [type]()
+            {
+                for (IComponent* component : m_tick_components[static_cast<uint32_t>(type)])
+                {
+                    // Removed since the snapshot was taken (it stays alive until the tick is over)
+                    if (ComponentStore::IsTracked(component) && component->GetEntity()->IsActive())
+                    {
+                        component->OnTick();
+                    }
+                }
+            }, main_thread);
+        }
     }
 
     // Sync primitives
@@ -65,14 +183,35 @@ namespace Spartan
 
     void World::Initialize()
     {
-        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolve, SP_EVENT_HANDLER_EXPRESSION_STATIC
-        (
-            m_resolve = true;
-        ));
+        SP_SUBSCRIBE_TO_EVENT(EventType::WorldResolve, SP_EVENT_HANDLER_VARIANT_STATIC(on_resolve));
+
+        // Component systems, the order in which they are added is the order in which conflicting ones will run
+        add_component_system("camera",           ComponentType::Camera,          SystemResource_Input | SystemResource_Transform, SystemResource_Camera | SystemResource_Transform, true);
+
+        // The camera moves things, resolve their descendants before anything else reads them (runs with the entities locked)
+        SystemScheduler::AddSystem("transform_hierarchy", SystemResource_Transform, SystemResource_Transform, []() { TransformHierarchy::Resolve(m_entities); }, true);
+
+        add_component_system("light",            ComponentType::Light,           SystemResource_Camera,                           SystemResource_Light | SystemResource_Transform | SystemResource_Rhi);
+        add_component_system("reflection_probe", ComponentType::ReflectionProbe, SystemResource_Transform,                        SystemResource_ReflectionProbe);
+        add_component_system("environment",      ComponentType::Environment,     SystemResource_None,                             SystemResource_Rhi);
+        add_component_system("rigid_body",       ComponentType::RigidBody,       SystemResource_Transform,                        SystemResource_Physics);
+        add_component_system("soft_body",        ComponentType::SoftBody,        SystemResource_Transform,                        SystemResource_Physics);
+        add_component_system("constraint",       ComponentType::Constraint,      SystemResource_None,                             SystemResource_Physics);
+        add_component_system("audio_listener",   ComponentType::AudioListener,   SystemResource_Transform,                        SystemResource_Audio);
+        add_component_system("audio_source",     ComponentType::AudioSource,     SystemResource_None,                             SystemResource_Audio);
     }
 
     void World::Shutdown()
     {
+        WorldStreaming::Close();
+        SystemScheduler::ClearSystems();
+        TransformHierarchy::Clear();
+        ComponentStore::Clear();
+        m_entity_handles.Clear();
+        m_entities_by_id.clear();
+        m_entities_by_name.clear();
+        m_entities_changed.clear();
+        m_entities_removed.clear();
         m_entities.clear();
     }
 
@@ -86,8 +225,12 @@ namespace Spartan
 
     void World::Tick()
     {
+        SP_MEMORY_TAG(World);
         SP_PROFILE_FUNCTION();
 
+        // Streamed cells which finished loading join the world here, far away ones leave it
+        WorldStreaming::Tick();
+
         // Tick entities
         {
             // Detect game toggling
@@ -115,11 +258,29 @@ namespace Spartan
                 }
             }
 
-            // Tick
-            for (shared_ptr<Entity>& entity : m_entities)
+            // Snapshot the dense arrays of the component store, the lock is not held while the systems run
+            // since they execute on other threads and some of them query the store (e.g. camera picking)
             {
-                entity->Tick();
+                lock_guard<recursive_mutex> lock_components(ComponentStore::GetMutex());
+
+                // Keep the dense arrays in address order, so the systems walk the component pools front to back
+                ComponentStore::Sort();
+
+                for (uint32_t type = 0; type < static_cast<uint32_t>(ComponentType::Undefined); type++)
+                {
+                    m_tick_components[type] = ComponentStore::Get(static_cast<ComponentType>(type));
+                }
+
+                ComponentStore::SetTicking(true);
             }
+
+            // Physics and streaming have moved things by now, resolve the descendants of whatever moved so that the systems
+            // see this frame's world matrices instead of last frame's
+            TransformHierarchy::Resolve(m_entities);
+
+            // Tick, systems which don't touch the same data run concurrently (transforms are resolved by the TransformHierarchy)
+            SystemScheduler::Tick();
+            ComponentStore::SetTicking(false);
         }
 
         // Remove entities
@@ -135,11 +296,55 @@ namespace Spartan
             m_queue_deletion.clear();
         }
 
+        // Resolve world matrices, after everything had the chance to move and before the renderer reads them
+        {
+            lock_guard<mutex> lock(m_entity_access_mutex);
+            TransformHierarchy::Tick(m_entities);
+        }
+
         // Notify Renderer
-        if (m_resolve)
         {
-            SP_FIRE_EVENT_DATA(EventType::WorldResolved, m_entities);
-            m_resolve = false;
+            vector<shared_ptr<Entity>> entities_changed;
+            vector<shared_ptr<Entity>> entities_removed;
+            {
+                lock_guard lock(m_entities_changed_mutex);
+
+                // Anything that changed is part of a full resolve
+                if (!m_resolve)
+                {
+                    sort(m_entities_changed.begin(), m_entities_changed.end());
+                    m_entities_changed.erase(unique(m_entities_changed.begin(), m_entities_changed.end()), m_entities_changed.end());
+
+                    entities_changed.reserve(m_entities_changed.size());
+                    for (Entity* entity : m_entities_changed)
+                    {
+                        entities_changed.emplace_back(entity->GetPtrShared());
+                    }
+
+                    entities_removed = move(m_entities_removed);
+                }
+
+                m_entities_changed.clear();
+                m_entities_removed.clear();
+            }
+
+            if (m_resolve)
+            {
+                Profiler::AddTraceEvent("World", "Resolve (" + to_string(m_entities.size()) + " entities)");
+                EventChannel<WorldResolvedEvent>::Fire({ m_entities });
+                SP_FIRE_EVENT(EventType::WorldResolved);
+                m_resolve = false;
+            }
+
+            if (!entities_removed.empty())
+            {
+                EventChannel<WorldEntitiesRemovedEvent>::Fire({ entities_removed });
+            }
+
+            if (!entities_changed.empty())
+            {
+                EventChannel<WorldEntitiesChangedEvent>::Fire({ entities_changed });
+            }
         }
     }
 
@@ -158,8 +363,7 @@ namespace Spartan
             file_path += EXTENSION_WORLD;
         }
 
-        m_name      = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
-        m_file_path = file_path;
+        _SetFilePath(file_path);
 
         // Notify subsystems that need to save data
         SP_FIRE_EVENT(EventType::WorldSaveStart);
@@ -189,11 +393,30 @@ namespace Spartan
             file->Write(root->GetObjectId());
         }
 
-        // Save root entities
-        for (shared_ptr<Entity>& root : root_actors)
+        // Encode every root entity (and its descendants) into a block of its own, in parallel
+        vector<string> blocks(root_entity_count);
+        parallel_for(root_entity_count, [&root_actors, &blocks](const uint32_t i)
         {
-            root->Serialize(file.get());
+            FileStream block(FileStream_Write);
+            root_actors[i]->Serialize(&block);
+            blocks[i] = block.GetBuffer();
+
             ProgressTracker::GetProgress(ProgressType::World).JobDone();
+        });
+
+        // Save the offset table, offsets are relative to the first block
+        uint64_t offset = 0;
+        for (const string& block : blocks)
+        {
+            file->Write(offset);
+            file->Write(static_cast<uint64_t>(block.size()));
+            offset += block.size();
+        }
+
+        // Stitch the blocks together
+        for (const string& block : blocks)
+        {
+            file->WriteBytes(block.data(), block.size());
         }
 
         // Report time
@@ -224,8 +447,7 @@ namespace Spartan
         // Clear current entities
         Clear();
 
-        m_name      = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
-        m_file_path = file_path;
+        _SetFilePath(file_path);
 
         // Notify subsystems that need to load data
         SP_FIRE_EVENT(EventType::WorldLoadStart);
@@ -238,21 +460,45 @@ namespace Spartan
         const Stopwatch timer;
 
         // Load root entity IDs
+        vector<shared_ptr<Entity>> root_entities(root_entity_count);
         for (uint32_t i = 0; i < root_entity_count; i++)
         {
-            shared_ptr<Entity> entity = CreateEntity();
-            entity->SetObjectId(file->ReadAs<uint64_t>());
+            root_entities[i] = CreateEntity();
+            root_entities[i]->SetObjectId(file->ReadAs<uint64_t>());
         }
 
-        // Serialize root entities
+        // Load the offset table
+        vector<uint64_t> block_offsets(root_entity_count);
+        vector<uint64_t> block_sizes(root_entity_count);
         for (uint32_t i = 0; i < root_entity_count; i++)
         {
-            m_entities[i]->Deserialize(file.get(), nullptr);
-            ProgressTracker::GetProgress(ProgressType::World).JobDone();
+            block_offsets[i] = file->ReadAs<uint64_t>();
+            block_sizes[i]   = file->ReadAs<uint64_t>();
+        }
+
+        // Read the blocks, in one go since they are laid out back to back
+        vector<string> blocks(root_entity_count);
+        for (uint32_t i = 0; i < root_entity_count; i++)
+        {
+            SP_ASSERT_MSG(i == 0 || block_offsets[i] == block_offsets[i - 1] + block_sizes[i - 1], "Corrupted offset table");
+
+            blocks[i].resize(block_sizes[i]);
+            file->ReadBytes(blocks[i].data(), block_sizes[i]);
         }
 
+        // Decode the blocks in parallel
+        parallel_for(root_entity_count, [&root_entities, &blocks](const uint32_t i)
+        {
+            FileStream block(FileStream_Read, move(blocks[i]));
+            root_entities[i]->Deserialize(&block, nullptr);
+
+            ProgressTracker::GetProgress(ProgressType::World).JobDone();
+        });
+
+        resolve_hierarchy();
+
         // Report time
-        SP_LOG_INFO("World \"%s\" has been loaded. Duration %.2f ms", m_file_path.c_str(), timer.GetElapsedTimeMs());
+        SP_LOG_INFO("World \"%s\" has been loaded, %zu entities. Duration %.2f ms", m_file_path.c_str(), m_entities.size(), timer.GetElapsedTimeMs());
 
         SP_FIRE_EVENT(EventType::WorldLoadEnd);
 
@@ -266,8 +512,29 @@ namespace Spartan
 
     shared_ptr<Entity> World::CreateEntity()
     {
-        lock_guard lock(m_entity_access_mutex);
-        return m_entities.emplace_back(make_shared<Entity>());
+        shared_ptr<Entity> entity = allocate_shared<Entity>(PoolAllocator<Entity>());
+
+        // Built in the background, it joins the world later
+        if (m_creation_target)
+        {
+            m_creation_target->emplace_back(entity);
+            return entity;
+        }
+
+        {
+            lock_guard lock(m_entity_access_mutex);
+            m_entities.emplace_back(entity);
+        }
+
+        {
+            lock_guard lock(m_entity_index_mutex);
+            m_entities_by_id[entity->GetObjectId()] = entity;
+            m_entities_by_name.emplace(entity->GetName(), entity);
+        }
+
+        entity->SetHandle(m_entity_handles.Add(entity.get()));
+
+        return entity;
     }
 
     bool World::EntityExists(Entity* entity)
@@ -280,7 +547,6 @@ namespace Spartan
     {
         SP_ASSERT_MSG(entity != nullptr, "Entity is null");
         m_queue_deletion.push_back(entity->GetPtrShared());
-        m_resolve = true;
     }
 
     vector<shared_ptr<Entity>> World::GetRootEntities()
@@ -299,11 +565,11 @@ namespace Spartan
 
     const shared_ptr<Entity>& World::GetEntityByName(const string& name)
     {
-        for (shared_ptr<Entity>& entity : m_entities)
-        {
-            if (entity->GetName() == name)
-                return entity;
-        }
+        lock_guard lock(m_entity_index_mutex);
+
+        auto it = m_entities_by_name.find(name);
+        if (it != m_entities_by_name.end())
+            return it->second;
 
         static shared_ptr<Entity> empty;
         return empty;
@@ -311,20 +577,104 @@ namespace Spartan
 
     const shared_ptr<Entity>& World::GetEntityById(const uint64_t id)
     {
-        for (const auto& entity : m_entities)
-        {
-            if (entity->GetObjectId() == id)
-                return entity;
-        }
+        lock_guard lock(m_entity_index_mutex);
+
+        auto it = m_entities_by_id.find(id);
+        if (it != m_entities_by_id.end())
+            return it->second;
 
         static shared_ptr<Entity> empty;
         return empty;
     }
 
+    Entity* World::GetEntityByHandle(const Handle<Entity> handle)
+    {
+        return m_entity_handles.Get(handle);
+    }
+
     const vector<shared_ptr<Entity>>& World::GetAllEntities()
     {
         return m_entities;
     }
+
+    void World::_SetCreationTarget(vector<shared_ptr<Entity>>* target)
+    {
+        m_creation_target = target;
+    }
+
+    void World::_AddEntities(const vector<shared_ptr<Entity>>& entities)
+    {
+        {
+            lock_guard lock(m_entity_access_mutex);
+            m_entities.insert(m_entities.end(), entities.begin(), entities.end());
+        }
+
+        {
+            lock_guard lock(m_entity_index_mutex);
+            for (const shared_ptr<Entity>& entity : entities)
+            {
+                m_entities_by_id[entity->GetObjectId()] = entity;
+                m_entities_by_name.emplace(entity->GetName(), entity);
+            }
+        }
+
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            entity->SetHandle(m_entity_handles.Add(entity.get()));
+        }
+
+        // Start ticking
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            for (const shared_ptr<IComponent>& component : entity->GetAllComponents())
+            {
+                if (component)
+                {
+                    ComponentStore::Add(component.get());
+                }
+            }
+        }
+
+        TransformHierarchy::MarkStructureDirty();
+
+        // Announce them, only these get registered with the renderer
+        lock_guard lock(m_entities_changed_mutex);
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            m_entities_changed.emplace_back(entity.get());
+        }
+    }
+
+    void World::_EntityIdChanged(Entity* entity, const uint64_t id_previous)
+    {
+        lock_guard lock(m_entity_index_mutex);
+
+        // Entities which are not part of the world (yet) are not indexed
+        auto it = m_entities_by_id.find(id_previous);
+        if (it == m_entities_by_id.end() || it->second.get() != entity)
+            return;
+
+        shared_ptr<Entity> entity_shared = move(it->second);
+        m_entities_by_id.erase(it);
+        m_entities_by_id[entity->GetObjectId()] = move(entity_shared);
+    }
+
+    void World::_EntityNameChanged(Entity* entity, const string& name_previous)
+    {
+        lock_guard lock(m_entity_index_mutex);
+
+        auto range = m_entities_by_name.equal_range(name_previous);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second.get() == entity)
+            {
+                shared_ptr<Entity> entity_shared = move(it->second);
+                m_entities_by_name.erase(it);
+                m_entities_by_name.emplace(entity->GetName(), move(entity_shared));
+                break;
+            }
+        }
+    }
       
     void World::Clear()
     {
@@ -332,6 +682,17 @@ namespace Spartan
         SP_FIRE_EVENT(EventType::WorldClear);
 
         // Clear
+        WorldStreaming::Close();
+        TransformHierarchy::Clear();
+        ComponentStore::Clear();
+        m_entity_handles.Clear();
+        m_entities_by_id.clear();
+        m_entities_by_name.clear();
+        {
+            lock_guard lock(m_entities_changed_mutex);
+            m_entities_changed.clear();
+            m_entities_removed.clear();
+        }
         m_entities.clear();
         m_name.clear();
         m_file_path.clear();
@@ -353,15 +714,45 @@ namespace Spartan
         for (Transform* transform : entities_to_remove)
         {
             ids_to_remove.insert(transform->GetEntity()->GetObjectId());
+
+            // Stop ticking, something else might still be holding on to the entity
+            ComponentStore::RemoveAll(transform->GetEntity());
+            index_remove(transform->GetEntity());
         }
 
         // Remove entities using a single loop
+        vector<shared_ptr<Entity>> entities_removed;
         m_entities.erase(remove_if(m_entities.begin(), m_entities.end(),
             [&](const shared_ptr<Entity>& entity)
             {
-                return ids_to_remove.count(entity->GetObjectId()) > 0;
+                if (ids_to_remove.count(entity->GetObjectId()) == 0)
+                    return false;
+
+                entities_removed.emplace_back(entity);
+                return true;
             }),
             m_entities.end());
+        TransformHierarchy::MarkStructureDirty();
+
+        // Let the renderer know, it holds on to the entities until it has dropped them
+        {
+            lock_guard lock(m_entities_changed_mutex);
+
+            // One pass over the changes, instead of one per removed entity
+            vector<Entity*> removed;
+            removed.reserve(entities_removed.size());
+            for (const shared_ptr<Entity>& entity : entities_removed)
+            {
+                removed.emplace_back(entity.get());
+            }
+            sort(removed.begin(), removed.end());
+
+            m_entities_changed.erase(remove_if(m_entities_changed.begin(), m_entities_changed.end(),
+                [&removed](Entity* entity) { return binary_search(removed.begin(), removed.end(), entity); }),
+                m_entities_changed.end());
+
+            m_entities_removed.insert(m_entities_removed.end(), entities_removed.begin(), entities_removed.end());
+        }
 
         // If there was a parent, update it
         if (Transform* parent = entity_to_remove->GetTransform()->GetParent())
@@ -664,4 +1055,10 @@ namespace Spartan
     {
         return m_file_path;
     }
+
+    void World::_SetFilePath(const string& file_path)
+    {
+        m_name      = FileSystem::GetFileNameWithoutExtensionFromFilePath(file_path);
+        m_file_path = file_path;
+    }
 }
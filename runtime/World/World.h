@@ -24,14 +24,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===================
 #include "Definitions.h"
+#include "Entity.h"
 #include "../Math/Vector3.h"
+#include <span>
 //==============================
 
 namespace Spartan
 {
-    //= FWD DECLARATIONS =
-    class Entity;
-    //====================
+    // Fired through EventChannel (see EventBus.h), the spans point to entities which
+    // the world owns, so they are only valid for the duration of the handler call.
+    struct WorldResolvedEvent        { std::span<const std::shared_ptr<Entity>> entities; }; // Every entity in the world
+    struct WorldEntitiesChangedEvent { std::span<const std::shared_ptr<Entity>> entities; }; // Added or changed since the last resolve
+    struct WorldEntitiesRemovedEvent { std::span<const std::shared_ptr<Entity>> entities; }; // Removed since the last resolve
 
     class SP_CLASS World
     {
@@ -42,6 +46,7 @@ namespace Spartan
         static void Tick();
         
         static void New();
+        static void Clear();
         static bool SaveToFile(const std::string& filePath);
         static bool LoadFromFile(const std::string& file_path);
         static void Resolve();
@@ -58,6 +63,7 @@ namespace Spartan
 
         static const std::string GetName();
         static const std::string& GetFilePath();
+        static void _SetFilePath(const std::string& file_path); // the name is derived from it, used by world streaming
 
         //= Entities ==================================================================
         static std::shared_ptr<Entity> CreateEntity();
@@ -66,11 +72,27 @@ namespace Spartan
         static std::vector<std::shared_ptr<Entity>> GetRootEntities();
         static const std::shared_ptr<Entity>& GetEntityByName(const std::string& name);
         static const std::shared_ptr<Entity>& GetEntityById(uint64_t id);
+        static Entity* GetEntityByHandle(Handle<Entity> handle);
         static const std::vector<std::shared_ptr<Entity>>& GetAllEntities();
+
+        // Keep the id and name lookup tables in sync, called by the entity
+        static void _EntityIdChanged(Entity* entity, uint64_t id_previous);
+        static void _EntityNameChanged(Entity* entity, const std::string& name_previous);
+
+        // Entities created on the calling thread go into the given list instead of the world (until null is set),
+        // they can be added later, all at once, with _AddEntities(). Used to stream parts of the world in the background.
+        static void _SetCreationTarget(std::vector<std::shared_ptr<Entity>>* target);
+        static void _AddEntities(const std::vector<std::shared_ptr<Entity>>& entities);
         //=============================================================================
 
+        // Calls function(T0*, T1*, ...) for every entity that has all of the given components, see ComponentStore::Each()
+        template <class... Ts, class Function>
+        static void Each(Function&& function)
+        {
+            ComponentStore::Each<Ts...>(std::forward<Function>(function));
+        }
+
     private:
-        static void Clear();
         static void _EntityRemove(std::shared_ptr<Entity> entity_to_remove);
     };
 }
@@ -0,0 +1,379 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "pch.h"
+#include "WorldStreaming.h"
+#include "World.h"
+#include "Entity.h"
+#include "ComponentStore.h"
+#include "Components/Transform.h"
+#include "Components/Camera.h"
+#include "Components/Light.h"
+#include "Components/Environment.h"
+#include "../Core/ThreadPool.h"
+#include "../IO/FileStream.h"
+#include "../Rendering/Renderer.h"
+//====================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    namespace
+    {
+        enum class CellState : uint32_t
+        {
+            Unloaded,
+            Loading,
+            Decoded, // built in the background, waiting for the sync point
+            Loaded
+        };
+
+        struct Cell
+        {
+            int32_t x               = 0;
+            int32_t z               = 0;
+            bool always_loaded      = false;
+            uint64_t offset         = 0; // relative to the first block
+            uint64_t size           = 0;
+            atomic<CellState> state = CellState::Unloaded;
+            uint32_t root_count     = 0;
+            vector<shared_ptr<Entity>> entities_decoded; // roots first
+            vector<Handle<Entity>> roots;
+        };
+
+        static vector<unique_ptr<Cell>> m_cells;
+        static string m_file_path;
+        static uint64_t m_data_offset   = 0;
+        static float m_cell_size        = 64.0f;
+        static float m_load_distance    = 128.0f;
+        static const float unload_ratio = 1.25f;
+        static atomic<uint32_t> m_loads_in_flight = 0;
+
+        static bool is_always_loaded(Entity* entity)
+        {
+            return entity->GetComponent<Camera>() || entity->GetComponent<Light>() || entity->GetComponent<Environment>();
+        }
+
+        // Distance on the xz plane, from a position to the closest point of a cell
+        static float distance_to_cell(const Vector3& position, const Cell& cell)
+        {
+            const float min_x = cell.x * m_cell_size;
+            const float min_z = cell.z * m_cell_size;
+            const float dx    = max(max(min_x - position.x, 0.0f), position.x - (min_x + m_cell_size));
+            const float dz    = max(max(min_z - position.z, 0.0f), position.z - (min_z + m_cell_size));
+
+            return sqrtf(dx * dx + dz * dz);
+        }
+
+        // Writes root entities (and their descendants) the same way the world file does
+        static string encode_cell(const vector<Entity*>& roots)
+        {
+            FileStream block(FileStream_Write);
+
+            block.Write(static_cast<uint32_t>(roots.size()));
+            for (Entity* root : roots)
+            {
+                block.Write(root->GetObjectId());
+            }
+
+            for (Entity* root : roots)
+            {
+                root->Serialize(&block);
+            }
+
+            return block.GetBuffer();
+        }
+
+        // Runs on the thread pool, the entities are built outside of the world
+        static void load_cell(Cell* cell)
+        {
+            string buffer;
+            {
+                FileStream file(m_file_path, FileStream_Read);
+                if (file.IsOpen())
+                {
+                    buffer.resize(cell->size);
+                    file.Seek(m_data_offset + cell->offset);
+                    file.ReadBytes(buffer.data(), cell->size);
+                }
+            }
+
+            if (!buffer.empty())
+            {
+                World::_SetCreationTarget(&cell->entities_decoded);
+                ComponentStore::SetDeferred(true);
+
+                FileStream block(FileStream_Read, move(buffer));
+                const uint32_t root_count = block.ReadAs<uint32_t>();
+
+                vector<shared_ptr<Entity>> roots(root_count);
+                for (uint32_t i = 0; i < root_count; i++)
+                {
+                    roots[i] = World::CreateEntity();
+                    roots[i]->SetObjectId(block.ReadAs<uint64_t>());
+                }
+
+                for (shared_ptr<Entity>& root : roots)
+                {
+                    root->Deserialize(&block, nullptr);
+                }
+
+                ComponentStore::SetDeferred(false);
+                World::_SetCreationTarget(nullptr);
+
+                cell->root_count = root_count;
+            }
+            else
+            {
+                SP_LOG_ERROR("Failed to read cell (%d, %d) from \"%s\"", cell->x, cell->z, m_file_path.c_str());
+            }
+
+            cell->state = CellState::Decoded;
+            m_loads_in_flight--;
+        }
+
+        static void unload_cell(Cell* cell)
+        {
+            // Roots which were already removed by someone else resolve to null
+            for (const Handle<Entity> root : cell->roots)
+            {
+                if (Entity* entity = World::GetEntityByHandle(root))
+                {
+                    World::RemoveEntity(entity);
+                }
+            }
+
+            cell->roots.clear();
+            cell->state = CellState::Unloaded;
+        }
+    }
+
+    bool WorldStreaming::SaveToFile(const string& file_path, const float cell_size)
+    {
+        SP_ASSERT_MSG(cell_size > 0.0f, "The cell size must be positive");
+
+        World::_SetFilePath(file_path);
+
+        // Notify subsystems that need to save data (the resource cache saves the resources the cells reference)
+        SP_FIRE_EVENT(EventType::WorldSaveStart);
+
+        // Group the root entities by cell, the first cell is the one which is always loaded
+        map<pair<int32_t, int32_t>, vector<Entity*>> cells;
+        vector<Entity*> always_loaded;
+        for (const shared_ptr<Entity>& root : World::GetRootEntities())
+        {
+            if (is_always_loaded(root.get()))
+            {
+                always_loaded.emplace_back(root.get());
+                continue;
+            }
+
+            const Vector3 position = root->GetTransform()->GetPosition();
+            const int32_t x        = static_cast<int32_t>(floorf(position.x / cell_size));
+            const int32_t z        = static_cast<int32_t>(floorf(position.z / cell_size));
+            cells[make_pair(x, z)].emplace_back(root.get());
+        }
+
+        const Stopwatch timer;
+
+        // Encode the cells
+        vector<string> blocks;
+        blocks.emplace_back(encode_cell(always_loaded));
+        for (auto& [coordinates, roots] : cells)
+        {
+            blocks.emplace_back(encode_cell(roots));
+        }
+
+        FileStream file(file_path, FileStream_Write);
+        if (!file.IsOpen())
+        {
+            SP_LOG_ERROR("Failed to open \"%s\"", file_path.c_str());
+            return false;
+        }
+
+        // Save the cell table
+        file.Write(cell_size);
+        file.Write(static_cast<uint32_t>(blocks.size()));
+        uint64_t offset = 0;
+        uint32_t index  = 0;
+        auto write_cell = [&file, &blocks, &offset, &index](const int32_t x, const int32_t z, const bool always_loaded)
+        {
+            file.Write(x);
+            file.Write(z);
+            file.Write(always_loaded);
+            file.Write(offset);
+            file.Write(static_cast<uint64_t>(blocks[index].size()));
+            offset += blocks[index].size();
+            index++;
+        };
+
+        write_cell(0, 0, true);
+        for (auto& [coordinates, roots] : cells)
+        {
+            write_cell(coordinates.first, coordinates.second, false);
+        }
+
+        // Save the cells
+        for (const string& block : blocks)
+        {
+            file.WriteBytes(block.data(), block.size());
+        }
+
+        SP_LOG_INFO("Saved %zu cells to \"%s\". Duration %.2f ms", cells.size(), file_path.c_str(), timer.GetElapsedTimeMs());
+
+        // Notify subsystems waiting for us to finish
+        SP_FIRE_EVENT(EventType::WorldSavedEnd);
+
+        return true;
+    }
+
+    bool WorldStreaming::Open(const string& file_path)
+    {
+        Close();
+
+        FileStream file(file_path, FileStream_Read);
+        if (!file.IsOpen())
+        {
+            SP_LOG_ERROR("Failed to open \"%s\"", file_path.c_str());
+            return false;
+        }
+
+        World::_SetFilePath(file_path);
+
+        // Notify subsystems that need to load data (the resource cache loads the resources the cells reference)
+        SP_FIRE_EVENT(EventType::WorldLoadStart);
+
+        m_file_path = file_path;
+        m_cell_size = file.ReadAs<float>();
+
+        const uint32_t cell_count = file.ReadAs<uint32_t>();
+        for (uint32_t i = 0; i < cell_count; i++)
+        {
+            unique_ptr<Cell>& cell = m_cells.emplace_back(make_unique<Cell>());
+            cell->x             = file.ReadAs<int32_t>();
+            cell->z             = file.ReadAs<int32_t>();
+            cell->always_loaded = file.ReadAs<bool>();
+            cell->offset        = file.ReadAs<uint64_t>();
+            cell->size          = file.ReadAs<uint64_t>();
+        }
+        m_data_offset = file.GetPosition();
+
+        // Notify subsystems waiting for us to finish
+        SP_FIRE_EVENT(EventType::WorldLoadEnd);
+
+        return true;
+    }
+
+    void WorldStreaming::Close()
+    {
+        while (m_loads_in_flight != 0)
+        {
+            this_thread::yield();
+        }
+
+        m_cells.clear();
+        m_file_path.clear();
+    }
+
+    void WorldStreaming::Tick()
+    {
+        if (m_cells.empty())
+            return;
+
+        shared_ptr<Camera> camera = Renderer::GetCamera();
+        const Vector3 position    = camera ? camera->GetTransform()->GetPosition() : Vector3::Zero;
+
+        for (unique_ptr<Cell>& cell : m_cells)
+        {
+            const float distance = cell->always_loaded ? 0.0f : distance_to_cell(position, *cell);
+
+            switch (cell->state.load())
+            {
+                case CellState::Unloaded:
+                {
+                    if (distance <= m_load_distance)
+                    {
+                        cell->state = CellState::Loading;
+                        m_loads_in_flight++;
+                        ThreadPool::AddTask([cell = cell.get()]() { load_cell(cell); });
+                    }
+                    break;
+                }
+
+                // The entities join the world in one go, nothing about them has been visible until now
+                case CellState::Decoded:
+                {
+                    World::_AddEntities(cell->entities_decoded);
+                    for (uint32_t i = 0; i < cell->root_count; i++)
+                    {
+                        cell->roots.emplace_back(cell->entities_decoded[i]->GetHandle());
+                    }
+                    cell->entities_decoded.clear();
+                    cell->state = CellState::Loaded;
+                    break;
+                }
+
+                case CellState::Loaded:
+                {
+                    if (distance > m_load_distance * unload_ratio)
+                    {
+                        unload_cell(cell.get());
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    void WorldStreaming::SetLoadDistance(const float distance)
+    {
+        m_load_distance = distance;
+    }
+
+    float WorldStreaming::GetLoadDistance()
+    {
+        return m_load_distance;
+    }
+
+    uint32_t WorldStreaming::GetCellCount()
+    {
+        return static_cast<uint32_t>(m_cells.size());
+    }
+
+    uint32_t WorldStreaming::GetCellCountLoaded()
+    {
+        uint32_t count = 0;
+        for (const unique_ptr<Cell>& cell : m_cells)
+        {
+            count += cell->state == CellState::Loaded ? 1 : 0;
+        }
+
+        return count;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+Copyright(c) 2016-2023 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include "Definitions.h"
+#include <string>
+//======================
+
+namespace Spartan
+{
+    // Splits the world into square cells on the xz plane, each cell is stored as a separately loadable block.
+    // Cells within the load distance of the camera are decoded in the background and join the world at the
+    // start of the next World::Tick(), cells beyond the unload distance are removed. Root entities which have
+    // a camera, a light or an environment don't belong to a location, they are stored in a cell which is always loaded.
+    class SP_CLASS WorldStreaming
+    {
+    public:
+        // Writes the current world as a streamable file, the resources it references are saved next to it (like World::SaveToFile())
+        static bool SaveToFile(const std::string& file_path, float cell_size = 64.0f);
+
+        // Starts streaming from a streamable file, this is additive, the current world is not cleared.
+        // The saved resources are loaded before any cell is decoded, so the cells can find them in the resource cache.
+        static bool Open(const std::string& file_path);
+
+        // Waits for any cells which are still loading and stops streaming (the entities of loaded cells stay)
+        static void Close();
+
+        // Sync point, called by the world before it ticks
+        static void Tick();
+
+        // Cells start loading within this distance and unload a bit further than that (so they don't thrash)
+        static void SetLoadDistance(float distance);
+        static float GetLoadDistance();
+
+        // Stats
+        static uint32_t GetCellCount();
+        static uint32_t GetCellCountLoaded();
+    };
+}